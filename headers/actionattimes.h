@@ -53,7 +53,24 @@ public:
    * \return 1 if action takes place, 0 otherwise
    */
   int atCurrentTime(const TimeClass* const TimeInfo) const;
+  /**
+   * \brief This is the function used to check whether an action takes place on a given timestep
+   * \param time is the timestep in the model
+   * \return 1 if action takes place, 0 otherwise
+   */
+  int atTime(int time) const;
+  /**
+   * \brief This is the function used to find the index of the current timestep in the years and steps passed to addActions
+   * \param TimeInfo is the TimeClass for the current model
+   * \return index of the current timestep, -1 if the action doesnt take place on the current timestep
+   */
+  int getTimeIndex(const TimeClass* const TimeInfo) const;
 protected:
+  /**
+   * \brief This is the function used to compile the lists of actions into a table indexed by the timestep
+   * \param TimeInfo is the TimeClass for the current model
+   */
+  void compileSchedule(const TimeClass* const TimeInfo);
   /**
    * \brief This is the flag if the action takes place on every timestep
    */
@@ -70,6 +87,14 @@ protected:
    * \brief This is the IntVector of the steps on which the action takes place
    */
   IntVector Steps;
+  /**
+   * \brief This is the IntVector, indexed by timestep, of flags denoting whether the action takes place on that timestep
+   */
+  IntVector activeTime;
+  /**
+   * \brief This is the IntVector, indexed by timestep, of the index of that timestep in the years and steps passed to addActions
+   */
+  IntVector timeIndex;
 };
 
 #endif
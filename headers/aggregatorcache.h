@@ -0,0 +1,110 @@
+#ifndef aggregatorcache_h
+#define aggregatorcache_h
+
+#include "fleetpreyaggregator.h"
+#include "stockaggregator.h"
+#include "intvector.h"
+
+/**
+ * \class AggregatorCache
+ * \brief This is the class used to share the aggregators used by the likelihood components and the printers
+ *
+ * This class is used to keep track of the FleetPreyAggregator and StockAggregator objects that have been created, so that when several likelihood components or printers need exactly the same aggregation (the same fleets and stocks, in the same order, with the same areas, age groups, length groups and overconsumption flag) only one aggregator is created and shared between them.  The cache also keeps track of the sections of each timestep when the model is not changing, so that each shared aggregator only aggregates the model information once in each section, and the other likelihood components and printers then use the same aggregated information.
+ * \note The aggregated information is shared, so it must not be changed by any of the likelihood components or printers that use it
+ */
+class AggregatorCache {
+public:
+  /**
+   * \brief This is the default AggregatorCache constructor
+   */
+  AggregatorCache();
+  /**
+   * \brief This is the default AggregatorCache destructor
+   * \note This will delete any aggregators that are still stored in the cache
+   */
+  ~AggregatorCache();
+  /**
+   * \brief This function will return a FleetPreyAggregator for the given parameters, creating a new aggregator if there isnt a suitable one in the cache
+   * \param Fleets is the FleetPtrVector of the fleets that will be aggregated
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param Lgrpdiv is the LengthGroupDivision of the stocks
+   * \param Areas is the IntMatrix of areas that the catch can take place on
+   * \param Ages is the IntMatrix of ages of the stocks
+   * \param overcons is the flag to determine whether to calculate overconsumption of the stocks
+   * \return pointer to the FleetPreyAggregator
+   */
+  FleetPreyAggregator* getFleetPreyAggregator(const FleetPtrVector& Fleets, const StockPtrVector& Stocks,
+    LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas, const IntMatrix& Ages, int overcons);
+  /**
+   * \brief This function will return a StockAggregator for the given parameters, creating a new aggregator if there isnt a suitable one in the cache
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param Lgrpdiv is the LengthGroupDivision that the stocks will be aggregated to
+   * \param Areas is the IntMatrix of areas that the stocks to be aggregated live on
+   * \param Ages is the IntMatrix of ages of the stocks to be aggregated
+   * \return pointer to the StockAggregator
+   */
+  StockAggregator* getStockAggregator(const StockPtrVector& Stocks,
+    const LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas, const IntMatrix& Ages);
+  /**
+   * \brief This function will release a FleetPreyAggregator returned from the cache
+   * \param aggregator is the FleetPreyAggregator that is no longer needed
+   * \note The aggregator will be deleted once it is no longer used by any likelihood component or printer
+   */
+  void deleteAggregator(FleetPreyAggregator* aggregator);
+  /**
+   * \brief This function will release a StockAggregator returned from the cache
+   * \param aggregator is the StockAggregator that is no longer needed
+   * \note The aggregator will be deleted once it is no longer used by any likelihood component or printer
+   */
+  void deleteAggregator(StockAggregator* aggregator);
+  /**
+   * \brief This function will start a new section of the timestep, when the model will not change
+   */
+  void startSection() { lastsection++; section = lastsection; };
+  /**
+   * \brief This function will end the current section of the timestep, since the model is about to change
+   */
+  void endSection() { section = 0; };
+  /**
+   * \brief This function will return the identifier of the current section of the timestep
+   * \return identifier of the current section, or 0 if the model could be changing
+   */
+  long int getSection() const { return section; };
+  /**
+   * \brief This function will return the number of aggregators that are being shared
+   * \return number of shared aggregators
+   */
+  int numShared() const;
+private:
+  /**
+   * \brief This is the array of FleetPreyAggregator objects that are stored in the cache
+   */
+  FleetPreyAggregator** fleetaggs;
+  /**
+   * \brief This is the IntVector of the number of users of each FleetPreyAggregator
+   */
+  IntVector fleetusers;
+  /**
+   * \brief This is the array of StockAggregator objects that are stored in the cache
+   */
+  StockAggregator** stockaggs;
+  /**
+   * \brief This is the IntVector of the number of users of each StockAggregator
+   */
+  IntVector stockusers;
+  /**
+   * \brief This is the identifier of the current section of the timestep
+   */
+  long int section;
+  /**
+   * \brief This is the identifier of the last section of the timestep that was started
+   */
+  long int lastsection;
+};
+
+/**
+ * \brief This is the AggregatorCache used by all the likelihood components and printers
+ */
+extern AggregatorCache aggcache;
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef binaryoutput_h
+#define binaryoutput_h
+
+#include "charptrvector.h"
+#include "doublematrix.h"
+#include "intvector.h"
+#include "gadget.h"
+
+enum ColumnType { INTCOLUMN = 1, DOUBLECOLUMN, LABELCOLUMN };
+
+/* The binary output files start with the same comment lines as the text */
+/* files, followed by this string and then the binary column information */
+const char binaryMagic[] = "GADGETBIN";
+const int binaryVersion = 2;
+const int binaryByteOrder = 0x01020304;
+const int binaryBlockSize = 8192;
+
+/**
+ * \class BinaryOutput
+ * \brief This is the class used to write the output from a printer class in a binary columnar format
+ *
+ * The binary output file contains the same comment header as the text output file, followed by a description of the columns (the name, the type, the width and precision that would have been used for the text output and the text written after each value) and then a sequence of blocks.  Each block contains the number of rows in the block (at most binaryBlockSize), followed by the values for each column in turn, with integer and label columns written as int values and the other columns written as double values.  Label columns are written as an index into a list of labels that is stored in the column description.  The output is buffered and only written to file when a block is full, or when the output is flushed (which happens when the BinaryOutput is deleted).  The file can be converted back to the text format using the bintotext program.
+ */
+class BinaryOutput {
+public:
+  /**
+   * \brief This is the BinaryOutput constructor
+   * \param out is the ofstream that the binary output will be written to
+   * \param size is the maximum number of rows in each block (default value binaryBlockSize)
+   */
+  BinaryOutput(ofstream& out, int size = binaryBlockSize);
+  /**
+   * \brief This is the default BinaryOutput destructor
+   * \note This will write any rows that are still stored in the buffer to file
+   */
+  ~BinaryOutput();
+  /**
+   * \brief This function will add a new column to the output file
+   * \param name is the name of the column
+   * \param ctype is the ColumnType of the column
+   * \param width is the width used when converting the column to text
+   * \param prec is the precision used when converting the column to text
+   * \param labels is the CharPtrVector of labels for a label column (default value 0)
+   * \note The columns must all be added before any values are stored
+   */
+  void addColumn(const char* name, ColumnType ctype, int width, int prec, const CharPtrVector* labels = 0);
+  /**
+   * \brief This function will set the text written after the values in the last column that was added
+   * \param text is the text to be written after each value
+   * \note If this is not set then the values are followed by a space, or a newline for the last column
+   */
+  void setSeparator(const char* text);
+  /**
+   * \brief This function will store an integer value in the next column of the current row
+   * \param value is the value to be stored
+   * \note For a label column, value is the index of the label
+   */
+  void storeInt(int value) { this->storeValue((double)value); };
+  /**
+   * \brief This function will store a double value in the next column of the current row
+   * \param value is the value to be stored
+   */
+  void storeDouble(double value) { this->storeValue(value); };
+  /**
+   * \brief This function will write the rows that are stored in the buffer to file
+   */
+  void Flush();
+  /**
+   * \brief This function will return the number of columns in the output file
+   * \return number of columns
+   */
+  int numColumns() const { return names.Size(); };
+private:
+  /**
+   * \brief This function will store a value in the next column of the current row
+   * \param value is the value to be stored
+   */
+  void storeValue(double value);
+  /**
+   * \brief This function will write the description of the columns to file
+   */
+  void writeHeader();
+  /**
+   * \brief This function will write an integer to file
+   * \param value is the value to be written
+   */
+  void writeInt(int value) { outfile.write((const char*)&value, sizeof(int)); };
+  /**
+   * \brief This function will write a string, preceded by its length, to file
+   * \param text is the string to be written
+   */
+  void writeString(const char* text);
+  /**
+   * \brief This is the ofstream that the binary output is written to
+   */
+  ofstream& outfile;
+  /**
+   * \brief This is the CharPtrVector of the names of the columns
+   */
+  CharPtrVector names;
+  /**
+   * \brief This is the IntVector of the types of the columns
+   */
+  IntVector types;
+  /**
+   * \brief This is the IntVector of the widths used when converting the columns to text
+   */
+  IntVector widths;
+  /**
+   * \brief This is the IntVector of the precisions used when converting the columns to text
+   */
+  IntVector precisions;
+  /**
+   * \brief This is the CharPtrVector of the text written after the values in each column (0 for the default separator)
+   */
+  CharPtrVector separators;
+  /**
+   * \brief This is the vector of the labels for the label columns (0 for the other columns)
+   */
+  vector<const CharPtrVector*> labels;
+  /**
+   * \brief This is the DoubleMatrix used to store the values for each column before they are written to file
+   */
+  DoubleMatrix buffer;
+  /**
+   * \brief This is the IntVector used to convert the integer columns before they are written to file
+   */
+  IntVector intbuffer;
+  /**
+   * \brief This is the maximum number of rows in each block
+   */
+  int blocksize;
+  /**
+   * \brief This is the number of complete rows stored in the buffer
+   */
+  int numrows;
+  /**
+   * \brief This is the column that the next value will be stored in
+   */
+  int column;
+  /**
+   * \brief This is the flag used to denote whether the column description has been written to file
+   */
+  int headerwritten;
+};
+
+#endif
@@ -60,6 +60,11 @@ public:
    * \note This function is not used for this likelihood component
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   */
+  virtual int isCumulative() const { return 1; };
 protected:
   /**
    * \brief This is the IntVector of the index of the parameters
@@ -38,6 +38,19 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This will check whether the likelihood component will be calculated on a given timestep
+   * \param time is the timestep in the model
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the likelihood component is calculated on the timestep, 0 otherwise
+   */
+  virtual int isLikelihoodStep(int time, const TimeClass* const TimeInfo) const { return AAT.atTime(time); };
+  /**
+   * \brief This will check whether the timesteps with data for the likelihood component can be resampled for a bootstrap replicate
+   * \return 1 if the likelihood score is a sum of independent terms for each timestep, 0 otherwise
+   * \note The likelihood score cannot be resampled when the data is aggregated over the whole year
+   */
+  virtual int canResample() const { return (!yearly); };
   /**
    * \brief This function will reset the CatchDistribution likelihood information
    * \param keeper is the Keeper for the current model
@@ -48,12 +61,27 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   * \note The multinomial, gamma, mvn and mvlogistic functions can give negative scores
+   */
+  virtual int isCumulative() const {
+    return ((functionnumber == 2) || (functionnumber == 4) || (functionnumber == 7) || (functionnumber == 8)); };
   /**
    * \brief This will select the fleets and stocks required to calculate the CatchDistribution likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  /**
+   * \brief This function will move the observation data for the CatchDistribution likelihood score into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    store.storeMatrices(obsDistribution);
+    store.storeMatrices(obsDataTerm);
+  };
   /**
    * \brief This function will print information from each CatchDistribution calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -81,6 +109,13 @@ private:
    * \return likelihood score
    */
   double calcLikMultinomial();
+  /**
+   * \brief This function will calculate the part of the multinomial likelihood score that only depends on the data read from the input file
+   * \param numarea is the number of areas that the data was read for
+   * \param numage is the number of age groups that the data was read for
+   * \param numlen is the number of length groups that the data was read for
+   */
+  void calcDataTerms(int numarea, int numage, int numlen);
   /**
    * \brief This function will calculate the likelihood score for the current timestep based on a Pearson function
    * \param TimeInfo is the TimeClass for the current model
@@ -131,10 +166,10 @@ private:
    */
   DoubleMatrixPtrMatrix obsDistribution;
   /**
-   * \brief This is the DoubleMatrixPtrMatrix used to store age-length distribution information calculated in the model
-   * \note The indices for this object are [time][area][age][length]
+   * \brief This is the DoubleMatrixPtrVector used to store age-length distribution information calculated in the model on the current timestep
+   * \note The indices for this object are [area][age][length]
    */
-  DoubleMatrixPtrMatrix modelDistribution;
+  DoubleMatrixPtrVector modelDistribution;
   /**
    * \brief This is the DoubleMatrix used to store the calculated likelihood information
    * \note The indices for this object are [time][area]
@@ -253,6 +288,11 @@ private:
    * \note This is set to zero, and not used, if the multinomial function is not used
    */
   Multinomial MN;
+  /**
+   * \brief This is the DoubleMatrixPtrVector used to store the part of the multinomial likelihood score that only depends on the data read from the input file
+   * \note The indices for this object are [time][area][length], with only one length entry when there is only one age group
+   */
+  DoubleMatrixPtrVector obsDataTerm;
   /**
    * \brief This is the AgeBandMatrixPtrVector used to temporarily store the information returned from the aggregatation function
    * \note The indices for this object are [area][age][length]
@@ -36,6 +36,18 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This will check whether the likelihood component will be calculated on a given timestep
+   * \param time is the timestep in the model
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the likelihood component is calculated on the timestep, 0 otherwise
+   */
+  virtual int isLikelihoodStep(int time, const TimeClass* const TimeInfo) const { return AAT.atTime(time); };
+  /**
+   * \brief This will check whether the timesteps with data for the likelihood component can be resampled for a bootstrap replicate
+   * \return 1 if the likelihood score is a sum of independent terms for each timestep, 0 otherwise
+   */
+  virtual int canResample() const { return 1; };
   /**
    * \brief This function will reset the CatchStatistics likelihood information
    * \param keeper is the Keeper for the current model
@@ -46,12 +58,25 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   */
+  virtual int isCumulative() const { return 1; };
   /**
    * \brief This will select the fleets and stocks required to calculate the CatchStatistics likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  /**
+   * \brief This function will move the observation data for the CatchStatistics likelihood score into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    store.storeMatrices(obsMean);
+    store.storeMatrices(obsStdDev);
+  };
   /**
    * \brief This function will print information from each CatchStatistics calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
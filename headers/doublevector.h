@@ -13,7 +13,7 @@ public:
   /**
    * \brief This is the default DoubleVector constructor
    */
-  DoubleVector() { size = 0; v = 0; };
+  DoubleVector() { size = 0; v = 0; shared = 0; };
   /**
    * \brief This is the DoubleVector constructor for a specified size
    * \param sz is the size of the vector to be created
@@ -72,6 +72,7 @@ public:
   void Reset();
   /**
    * \brief This function will set all of the entries of the vector to zero
+   * \note If the entries are stored in an ObservationStore then they are first copied back to memory owned by the vector
    */
   void setToZero();
   /**
@@ -83,9 +84,26 @@ public:
   /**
    * \brief This operator will set the vector equal to an existing DoubleVector
    * \param d is the DoubleVector to copy
+   * \note If the entries are stored in an ObservationStore then new memory owned by the vector is used for the copy
    */
   DoubleVector& operator = (const DoubleVector& d);
+  /**
+   * \brief This function will move the entries of the vector to memory that is owned by an ObservationStore
+   * \param storage is the memory that the entries of the vector will be copied to
+   * \note The vector will not free this memory, and if the vector is resized, set to zero or assigned to then the entries will be copied back to memory owned by the vector
+   */
+  void moveToStore(double* storage);
+  /**
+   * \brief This function will check if the entries of the vector are stored in an ObservationStore
+   * \return 1 if the entries are stored in an ObservationStore, 0 otherwise
+   */
+  int isShared() const { return shared; };
 protected:
+  /**
+   * \brief This function will copy the entries of the vector from an ObservationStore back to memory owned by the vector
+   * \note The memory in the ObservationStore may be read-only, so this must be called before the entries are changed
+   */
+  void moveFromStore();
   /**
    * \brief This is the vector of double values
    */
@@ -94,6 +112,10 @@ protected:
    * \brief This is the size of the vector
    */
   int size;
+  /**
+   * \brief This is the flag used to denote whether the entries of the vector are stored in an ObservationStore
+   */
+  int shared;
 };
 
 #endif
@@ -19,6 +19,10 @@
 #include "maininfo.h"
 #include "printinfo.h"
 #include "optinfo.h"
+#include "workerpool.h"
+#include "observationstore.h"
+#include "evaluationcache.h"
+#include "intmatrix.h"
 #include "gadget.h"
 
 /**
@@ -87,7 +91,7 @@ public:
    * \brief This function will write the current model status to file
    * \param filename is the name of the file to write the model information to
    */
-  void writeStatus(const char* filename) const;
+  void writeStatus(const char* filename);
   /**
    * \brief This function will write header information about the model parameters to file
    * \param filename is the name of the file to write the model information to
@@ -102,7 +106,16 @@ public:
    * \param filename is the name of the file to write the model information to
    * \param prec is the precision to use in the output file
    */
-  void writeParams(const char* const filename, int prec) const;
+  void writeParams(const char* const filename, int prec);
+  /**
+   * \brief This function will calculate the Hessian matrix of the likelihood score at the optimum, and write it to file along with the inverse Hessian matrix and the square root of its diagonal
+   * \param filename is the name of the file to write the Hessian matrix to
+   * \param step is the step size used for the finite differences, as a proportion of the value of each parameter
+   * \param prec is the precision to use in the output file
+   * \note The Hessian matrix is calculated using central differences, and all the points are calculated together so that they can be calculated in parallel
+   * \note The points used for the Hessian matrix are not counted as function evaluations, and are not written to the optimisation output files
+   */
+  void writeHessian(const char* const filename, double step, int prec);
   /**
    * \brief This function will display information about the best values of the parameters found so far during an optimisation run
    */
@@ -115,6 +128,23 @@ public:
    * \brief This is the function that will optimise the likelihood score
    */
   void Optimise();
+  /**
+   * \brief This function will start the processes used to calculate the likelihood score in parallel during an optimising run
+   * \param main is the MainInfo specifying the command line options for the model run
+   * \note This function must be called after the model has been initialised, since the processes will run a copy of the current model
+   */
+  void startWorkers(const MainInfo& main);
+  /**
+   * \brief This function will resample the timesteps with data for each likelihood component, for a bootstrap replicate of the model
+   * \param seed is the seed for the random number generator used to resample the timesteps
+   * \note The likelihood score for each timestep is scaled by the number of times that timestep has been selected, so the observation data is not changed
+   */
+  void resampleLikelihood(int seed);
+  /**
+   * \brief This function will return the number of processes that are used to calculate the likelihood score
+   * \return number of processes
+   */
+  int numWorkers() const { return (workers == 0 ? 1 : workers->numWorkers()); };
   /**
    * \brief This function will initialise the Ecosystem parameters
    */
@@ -124,6 +154,32 @@ public:
    * \param Stochastic is the StochasticData containing the new values of the parameters
    */
   void Update(const StochasticData* const Stochastic) const { keeper->Update(Stochastic); };
+  /**
+   * \brief This function will set the values of the parameters that the optimisation will start from
+   * \param val is the DoubleVector containing the (unscaled) values for all the parameters
+   */
+  void setStartValues(const DoubleVector& val) const { keeper->setStartValues(val); };
+  /**
+   * \brief This function will fix the value of a parameter, so that it is not optimised
+   * \param pos is the index of the parameter
+   * \param value is the value that the parameter is fixed at
+   */
+  void fixVariable(int pos, double value) const { keeper->fixVariable(pos, value); };
+  /**
+   * \brief This function will return the names of the parameters
+   * \param sw is the ParameterVector that will contain the names of the parameters
+   */
+  void getSwitches(ParameterVector& sw) const { keeper->getSwitches(sw); };
+  /**
+   * \brief This function will return the current values of the parameters
+   * \param val is the DoubleVector that will contain the (unscaled) values for all the parameters
+   */
+  void getCurrentValues(DoubleVector& val) const { keeper->getCurrentValues(val); };
+  /**
+   * \brief This function will return the best values of the parameters found during an optimising run
+   * \param val is the DoubleVector that will contain the (unscaled) values for all the parameters
+   */
+  void getBestValues(DoubleVector& val) const { keeper->getBestValues(val); };
   /**
    * \brief This function will reset the Ecosystem information
    */
@@ -207,6 +263,41 @@ public:
    * \note This function gets updated values for the model parameters from the optimisation algorithm and performs a model run based on these new values, calculating a new likelihood score that is then returned to the optimisation algorithm
    */
   double SimulateAndUpdate(const DoubleVector& x);
+  /**
+   * \brief This function will update the model parameters, run the model and calculate a likelihood score, stopping the simulation early if the likelihood score is worse than a given bound
+   * \param x is the DoubleVector containing the updated values for the parameters
+   * \param bound is the likelihood score that the new point needs to improve on
+   * \return likelihood score
+   * \note If the simulation has been stopped early then the likelihood score returned is a lower bound for the actual likelihood score, which is greater than bound.  This should only be used by optimisation algorithms that will always reject a point that is worse than bound
+   */
+  double SimulateAndUpdate(const DoubleVector& x, double bound);
+  /**
+   * \brief This function will calculate a likelihood score for a batch of points, using the parallel processes if they have been started
+   * \param x is the DoubleMatrix containing the updated values for the parameters, with each row containing one point
+   * \param f is the DoubleVector that will contain the likelihood score for each point
+   * \note If the parallel processes have not been started then the points are calculated in turn using SimulateAndUpdate
+   */
+  void SimulateAndUpdate(const DoubleMatrix& x, DoubleVector& f);
+  /**
+   * \brief This function will update the model parameters, run the model and return the likelihood scores
+   * \param val is the DoubleVector containing the (unscaled) values for all the parameters
+   * \param likes is the DoubleVector that will contain the unweighted likelihood score for each likelihood component
+   * \return likelihood score
+   * \note This function is used by the processes that calculate the likelihood score in parallel
+   */
+  double SimulateValues(const DoubleVector& val, DoubleVector& likes);
+  /**
+   * \brief This function will return the unweighted likelihood scores from the current simulation
+   * \param likes is the DoubleVector that will contain the unweighted likelihood score for each likelihood component
+   */
+  void getUnweightedLikelihoods(DoubleVector& likes) const;
+  /**
+   * \brief This function will return the likelihood scores for the best point found during an optimising run
+   * \param likes is the DoubleVector that will contain the unweighted likelihood score for each likelihood component
+   * \return the overall likelihood score
+   * \note This will simulate the model again if the likelihood scores for the current point are incomplete
+   */
+  double getOptLikelihoods(DoubleVector& likes);
   /**
    * \brief This function will return the likelihood score from the current simulation
    * \return likelihood score
@@ -262,6 +353,29 @@ public:
    */
   volatile int interrupted;
 protected:
+  /**
+   * \brief This function will check to see if the user has interrupted the current model run, and display the interrupt menu if so
+   */
+  void checkInterrupted();
+  /**
+   * \brief This function will compile the lists of likelihood components and printers that are used on each timestep of the model
+   */
+  void compileSchedule();
+  /**
+   * \brief This function will simulate the model again if the likelihood score for the current values of the parameters was found in the EvaluationCache, or if the simulation was stopped early, so that the model information is available
+   */
+  void restoreModel();
+  /**
+   * \brief This function will check whether the likelihood score can only increase as the model is simulated, so the simulation can be stopped early
+   * \return 1 if every likelihood component is cumulative and has a non-negative weight, 0 otherwise
+   * \note This is checked for each simulation, since the weights can be changed after the model has been initialised
+   */
+  int canStopEarly() const;
+  /**
+   * \brief This function will set the current values of the parameters from the scaled values used by the optimisation algorithm
+   * \param x is the DoubleVector containing the scaled values for the parameters that are being optimised
+   */
+  void setCurrentValues(const DoubleVector& x);
   /**
    * \brief This is the value of the likelihood score for the current simulation
    */
@@ -337,6 +451,62 @@ protected:
    * \note This vector is only used to temporarily store values during an optimising run
    */
   IntVector optflag;
+  /**
+   * \brief This is the WorkerPool used to calculate the likelihood score in parallel during an optimising run
+   * \note This is 0 unless more than one process has been requested for the optimising run
+   */
+  WorkerPool* workers;
+  /**
+   * \brief This is the ObservationStore used to hold the observation data for the likelihood components
+   * \note This is created when the model is initialised, and is read-only once all the likelihood components have been initialised
+   */
+  ObservationStore* obsstore;
+  /**
+   * \brief This is the IntMatrix, indexed by timestep, of the likelihood components that are used on that timestep
+   */
+  IntMatrix likeSchedule;
+  /**
+   * \brief This is the flag used to denote whether the likelihood scores are calculated from resampled timesteps
+   */
+  int resample;
+  /**
+   * \brief This is the DoubleMatrix, indexed by likelihood component and timestep, of the number of times each timestep has been selected in the resampled data
+   */
+  DoubleMatrix resampleweights;
+  /**
+   * \brief This is the IntMatrix, indexed by timestep, of the printer classes that print at the start of that timestep
+   */
+  IntMatrix startPrintSchedule;
+  /**
+   * \brief This is the IntMatrix, indexed by timestep, of the printer classes that print at the end of that timestep
+   */
+  IntMatrix endPrintSchedule;
+  /**
+   * \brief This is the EvaluationCache used to store the likelihood scores for the points recently calculated during an optimising run
+   */
+  EvaluationCache* evalcache;
+  /**
+   * \brief This is the DoubleVector used to store the unweighted likelihood scores for the points stored in the EvaluationCache
+   */
+  DoubleVector cachelikes;
+  /**
+   * \brief This is the flag used to denote whether the model needs to be simulated again before the model information is used
+   * \note This is 1 when the likelihood score for the current values of the parameters was found in the EvaluationCache or calculated by the parallel processes, so the model hasnt been simulated for these values, and 2 when the simulation was stopped early, so the likelihood scores are incomplete
+   */
+  int restoremodel;
+  /**
+   * \brief This is the flag used to denote whether the simulation should be stopped once the likelihood score is worse than likebound
+   * \note This is only set when canStopEarly returns 1
+   */
+  int checkbound;
+  /**
+   * \brief This is the likelihood score that is used to stop the simulation early
+   */
+  double likebound;
+  /**
+   * \brief This is the number of simulations that have been stopped early
+   */
+  int numstopped;
 };
 
 #endif
@@ -0,0 +1,99 @@
+#ifndef evaluationcache_h
+#define evaluationcache_h
+
+#include "doublematrix.h"
+#include "doublevector.h"
+#include "intvector.h"
+#include "gadget.h"
+
+/* The number of points that are stored in the cache of recent function evaluations */
+const int evalCacheSize = 64;
+
+/**
+ * \class EvaluationCache
+ * \brief This is the class used to store the likelihood scores for the points that have been recently calculated during an optimising run
+ *
+ * This class is used to store the values of the parameters and the resulting likelihood scores (both the overall likelihood score and the unweighted score for each likelihood component) for the most recent points that have been calculated by the optimisation algorithms.  The optimisation algorithms will often calculate the likelihood score for a point that has already been calculated (for example, when the best point is recalculated at the end of an optimisation algorithm, or when the starting point for one optimisation algorithm is the best point from the previous optimisation algorithm), and this class is used so that these points dont need to be simulated again.  Once the cache is full, the point that has been used least recently is replaced.
+ * \note The points are only treated as being the same if the values of all the parameters are exactly the same
+ */
+class EvaluationCache {
+public:
+  /**
+   * \brief This is the EvaluationCache constructor
+   * \param size is the number of points that can be stored in the cache
+   * \param numvar is the number of parameters for the model
+   * \param numlike is the number of likelihood components for the model
+   */
+  EvaluationCache(int size, int numvar, int numlike);
+  /**
+   * \brief This is the default EvaluationCache destructor
+   */
+  ~EvaluationCache() {};
+  /**
+   * \brief This function will search the cache for a point
+   * \param point is the DoubleVector of the values of the parameters
+   * \param score is the overall likelihood score for the point, if it has been found
+   * \param likes is the DoubleVector of the unweighted likelihood scores for the point, if it has been found
+   * \return 1 if the point has been found in the cache, 0 otherwise
+   */
+  int findPoint(const DoubleVector& point, double& score, DoubleVector& likes);
+  /**
+   * \brief This function will store a point in the cache, replacing the least recently used point if the cache is full
+   * \param point is the DoubleVector of the values of the parameters
+   * \param score is the overall likelihood score for the point
+   * \param likes is the DoubleVector of the unweighted likelihood scores for the point
+   */
+  void storePoint(const DoubleVector& point, double score, const DoubleVector& likes);
+  /**
+   * \brief This will return the number of points that have been found in the cache
+   * \return hits
+   */
+  int numHits() const { return hits; };
+  /**
+   * \brief This will return the number of points that have not been found in the cache
+   * \return misses
+   */
+  int numMisses() const { return misses; };
+private:
+  /**
+   * \brief This function will calculate the hash value used to speed up the search for a point
+   * \param point is the DoubleVector of the values of the parameters
+   * \return hash value
+   */
+  int calcHash(const DoubleVector& point) const;
+  /**
+   * \brief This is the DoubleMatrix of the values of the parameters for the points stored in the cache
+   */
+  DoubleMatrix points;
+  /**
+   * \brief This is the DoubleMatrix of the unweighted likelihood scores for the points stored in the cache
+   */
+  DoubleMatrix likelihoods;
+  /**
+   * \brief This is the DoubleVector of the overall likelihood scores for the points stored in the cache
+   */
+  DoubleVector scores;
+  /**
+   * \brief This is the IntVector of the hash values for the points stored in the cache
+   */
+  IntVector hashes;
+  /**
+   * \brief This is the IntVector of the time that each point in the cache was last used
+   * \note This is 0 for an entry in the cache that hasnt been used
+   */
+  IntVector lastused;
+  /**
+   * \brief This is the counter used to record when each point in the cache was used
+   */
+  int counter;
+  /**
+   * \brief This is the number of points that have been found in the cache
+   */
+  int hits;
+  /**
+   * \brief This is the number of points that have not been found in the cache
+   */
+  int misses;
+};
+
+#endif
@@ -56,6 +56,19 @@ public:
    * \return total, the AgeBandMatrixPtrVector of aggregated catch information
    */
   const AgeBandMatrixPtrVector& getSum() const { return total; };
+  /**
+   * \brief This function will check if the aggregator would aggregate the same catch information as a new aggregator created with the given parameters
+   * \param Fleets is the FleetPtrVector of the fleets that will be aggregated
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param Lgrpdiv is the LengthGroupDivision of the stocks
+   * \param Areas is the IntMatrix of areas that the catch can take place on
+   * \param Ages is the IntMatrix of ages of the stocks
+   * \param overcons is the flag to determine whether to calculate overconsumption of the stocks
+   * \return 1 if the aggregated catch information would be the same, 0 otherwise
+   */
+  int isSameAggregation(const FleetPtrVector& Fleets, const StockPtrVector& Stocks,
+    const LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas,
+    const IntMatrix& Ages, int overcons) const;
 private:
   /**
    * \brief This is the PredatorPtrVector of the fleets that will be aggregated
@@ -102,6 +115,10 @@ private:
    * \brief This is the AgeBandMatrix used to temporarily store information when aggregating the catch
    */
   const AgeBandMatrix* alptr;
+  /**
+   * \brief This is the identifier of the section of the timestep when the catch information was last aggregated
+   */
+  long int section;
 };
 
 #endif
@@ -18,6 +18,7 @@ This document is the developers manual for Gadget, and describes the classes, fu
 /* A list of the standard header files that are needed for Gadget */
 /* Older compilers need these to be declared in the old format    */
 #include <cassert>
+#include <cerrno>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
@@ -31,6 +32,9 @@ This document is the developers manual for Gadget, and describes the classes, fu
 #include <vector>
 #include <signal.h>
 #include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
 #include <sys/utsname.h>
 #include <sys/param.h>
 
@@ -76,6 +80,10 @@ const int printwidth = 10;
 const int largewidth = 12;
 const int fullwidth = 18;
 
+/* Also defined are the limits used when writing the -print output to file */
+const int printflushtime = 30;                /* seconds between flushes */
+const int printblocksize = 1024;              /* rows in each binary block */
+
 /* Update the following line each time upgrades are implemented */
 #define GADGETVERSION "2.2.00-BETA"
 
@@ -205,6 +205,14 @@ protected:
    * \note This stores the value of gamma(x+alpha)/gamma(x)
    */
   DoubleVector part4;
+  /**
+   * \brief This is the DoubleVector of the mean lengths raised to the power used in the weight increase for growth functions 8, 10 and 11
+   */
+  DoubleVector powLength;
+  /**
+   * \brief This is the power that was used to calculate powLength
+   */
+  double powPower;
 };
 
 #endif
@@ -3,7 +3,7 @@
 
 #include "areatime.h"
 #include "conversionindex.h"
-#include "formulamatrixptrvector.h"
+#include "sparseformulamatrixptrvector.h"
 #include "commentstream.h"
 #include "popinfovector.h"
 #include "livesonareas.h"
@@ -140,13 +140,13 @@ public:
     const DoubleVector& MaxCon, const LengthGroupDivision* const LgrpDiv);
 protected:
   /**
-   * \brief This is the FormulaMatrixPtrVector of increase in length for each length group
+   * \brief This is the SparseFormulaMatrixPtrVector of increase in length for each length group
    */
-  FormulaMatrixPtrVector lgrowth;
+  SparseFormulaMatrixPtrVector lgrowth;
   /**
-   * \brief This is the FormulaMatrixPtrVector of increase in weight for each length group
+   * \brief This is the SparseFormulaMatrixPtrVector of increase in weight for each length group
    */
-  FormulaMatrixPtrVector wgrowth;
+  SparseFormulaMatrixPtrVector wgrowth;
 };
 
 /**
@@ -418,9 +418,9 @@ protected:
    */
   ModelVariableVector growthPar;
   /**
-   * \brief This is the FormulaMatrixPtrVector of increase in weight for each length group
+   * \brief This is the SparseFormulaMatrixPtrVector of increase in weight for each length group
    */
-  FormulaMatrixPtrVector wgrowth;
+  SparseFormulaMatrixPtrVector wgrowth;
 };
 
 /**
@@ -470,9 +470,9 @@ protected:
    */
   ModelVariableVector growthPar;
   /**
-   * \brief This is the FormulaMatrixPtrVector of increase in weight for each length group
+   * \brief This is the SparseFormulaMatrixPtrVector of increase in weight for each length group
    */
-  FormulaMatrixPtrVector wgrowth;
+  SparseFormulaMatrixPtrVector wgrowth;
 };
 
 /**
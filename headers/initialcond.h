@@ -2,6 +2,7 @@
 #define initialcond_h
 
 #include "formulamatrixptrvector.h"
+#include "sparseformulamatrixptrvector.h"
 #include "areatime.h"
 #include "conversionindex.h"
 #include "commentstream.h"
@@ -98,9 +99,9 @@ protected:
    */
   AgeBandMatrixPtrVector initialPop;
   /**
-   * \brief This is the FormulaMatrixPtrVector that contains the number (from the input file) of the initial population
+   * \brief This is the SparseFormulaMatrixPtrVector that contains the number (from the input file) of the initial population
    */
-  FormulaMatrixPtrVector initialNumber;
+  SparseFormulaMatrixPtrVector initialNumber;
   /**
    * \brief This is the FormulaMatrix of the area factor used to calculate the initial population
    */
@@ -81,6 +81,12 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   void Print(ofstream& outfile) const;
+  /**
+   * \brief This function will check if the IntMatrix contains the same values as an existing IntMatrix
+   * \param initial is the IntMatrix to compare to
+   * \return 1 if the values are the same, 0 otherwise
+   */
+  int isSame(const IntMatrix& initial) const;
   /**
    * \brief This operator will set the vector equal to an existing IntMatrix
    * \param initial is the IntMatrix to copy
@@ -7,6 +7,7 @@
 #include "stochasticdata.h"
 #include "addresskeepermatrix.h"
 #include "strstack.h"
+#include "binaryoutput.h"
 
 /**
  * \class Keeper
@@ -113,6 +114,11 @@ public:
    * \param val is the DoubleVector that will contain a copy of the current values
    */
   void getCurrentValues(DoubleVector& val) const;
+  /**
+   * \brief This function will return a copy of the best value of the variables found by the optimisation process
+   * \param val is the DoubleVector that will contain a copy of the best values
+   */
+  void getBestValues(DoubleVector& val) const;
   /**
    * \brief This function will return a copy of the lower bounds of the variables to be optimised
    * \param lbs is the DoubleVector that will contain a copy of the lower bounds
@@ -159,11 +165,27 @@ public:
    * \param Stoch is the StochasticData containing the new values of the variables
    */
   void Update(const StochasticData* const Stoch);
+  /**
+   * \brief This function will set the values of the variables that the optimisation process will start from
+   * \param val is the DoubleVector containing the new values of the variables
+   */
+  void setStartValues(const DoubleVector& val);
+  /**
+   * \brief This function will fix the value of one Keeper variable, so that it is not optimised
+   * \param pos is the identifier of the variable to fix
+   * \param value is the value that the variable is fixed at
+   */
+  void fixVariable(int pos, double value);
   /**
    * \brief This function will open the output file and write header information
    * \param filename is the name of the file to write the model information to
+   * \param binary is the flag to denote whether the model information should be written in a binary format
    */
-  void openPrintFile(const char* const filename);
+  void openPrintFile(const char* const filename, int binary);
+  /**
+   * \brief This function will write any buffered information about the model parameters to the output file
+   */
+  void flushPrintFile();
   /**
    * \brief This function will write header information about the model parameters to file
    * \param likevec is the LikelihoodPtrVector containing the likelihood components for the current model
@@ -173,8 +195,19 @@ public:
    * \brief This function will write current information about the model parameters to file
    * \param likevec is the LikelihoodPtrVector containing the likelihood components for the current model
    * \param prec is the precision to use in the output file
+   * \note The output is buffered, and is only written to file when the buffer is full or when printflushtime seconds have passed since the output was last written
    */
   void writeValues(const LikelihoodPtrVector& likevec, int prec);
+  /**
+   * \brief This function will write information about the model parameters, from a model run that was not performed by this process, to file
+   * \param likevec is the LikelihoodPtrVector containing the likelihood components for the current model
+   * \param val is the DoubleVector containing the values of the parameters for the model run
+   * \param likes is the DoubleVector containing the unweighted likelihood scores for each likelihood component
+   * \param score is the overall likelihood score for the model run
+   * \param prec is the precision to use in the output file
+   */
+  void writeValues(const LikelihoodPtrVector& likevec, const DoubleVector& val,
+    const DoubleVector& likes, double score, int prec);
   /**
    * \brief This function will write final information about the model parameters to file in a column format (which can then be used as the starting point for a subsequent model run)
    * \param optvec is the OptInfoPtrVector containing the optimisation algorithms used for the current model
@@ -203,6 +236,51 @@ public:
    */
   double getBestLikelihoodScore() const { return bestlikelihood; };
 protected:
+  /**
+   * \brief This function will write current information about the model parameters to file in a binary format
+   * \param likevec is the LikelihoodPtrVector containing the likelihood components for the current model
+   * \param val is the DoubleVector containing the values of the parameters
+   * \param likes is the DoubleVector containing the unweighted likelihood scores for each likelihood component
+   * \param score is the overall likelihood score
+   * \param prec is the precision to use when converting the output file to text
+   */
+  void writeBinaryValues(const LikelihoodPtrVector& likevec, const DoubleVector& val,
+    const DoubleVector& likes, double score, int prec);
+  /**
+   * \brief This function will find the position of a switch name in the list of switches
+   * \param attr is the name of the Parameter to find
+   * \return the position of the switch, or -1 if the switch name has not been found
+   */
+  int findSwitch(const Parameter& attr) const;
+  /**
+   * \brief This function will find the entry in the index of addresses for the memory address of a variable
+   * \param var is the memory address of the variable to find
+   * \return the entry in the index of addresses, or -1 if the variable has not been found
+   */
+  int findAddress(const double* var) const;
+  /**
+   * \brief This function will add the memory address of a variable to the index of addresses
+   * \param sw is the position of the switch used by the variable
+   * \param slot is the position of the variable in the list of addresses for that switch
+   */
+  void addAddress(int sw, int slot);
+  /**
+   * \brief This function will rebuild the index of switch names and the index of addresses
+   * \note This needs to be called when a switch has been deleted, since the positions of the following switches will have changed
+   */
+  void rebuildIndex();
+  /**
+   * \brief This function will calculate the hash value used to find a switch name in the index of switch names
+   * \param name is the switch name
+   * \return hash value
+   */
+  int hashSwitch(const char* name) const;
+  /**
+   * \brief This function will calculate the hash value used to find a memory address in the index of addresses
+   * \param var is the memory address
+   * \return hash value
+   */
+  int hashAddress(const double* var) const;
   /**
    * \brief This is the AddressKeeperMatrix used to store information about the value and name of the parameters
    */
@@ -236,6 +314,24 @@ protected:
    * \brief This is the ParameterVector used to store information about the names of the parameters
    */
   ParameterVector switches;
+  /**
+   * \brief This is the IntVector used as an index of the switch names, giving the position of each switch in the list of switches
+   * \note This is an open addressing hash table, with entries set to -1 if they are empty
+   */
+  IntVector switchindex;
+  /**
+   * \brief This is the IntVector used as an index of the memory addresses of the variables, giving the position of the switch used by each variable
+   * \note This is an open addressing hash table, with entries set to -1 if they are empty and -2 if they have been deleted
+   */
+  IntVector addrswitch;
+  /**
+   * \brief This is the IntVector used as an index of the memory addresses of the variables, giving the position of each variable in the list of addresses for its switch
+   */
+  IntVector addrslot;
+  /**
+   * \brief This is the number of entries in the index of addresses that are not empty (including any deleted entries)
+   */
+  int addrused;
   /**
    * \brief This is the DoubleVector used to store information about the lower bounds of the parameters
    */
@@ -264,6 +360,14 @@ protected:
    * \brief This ofstream is the file that all the parameter information gets sent to
    */
   ofstream outfile;
+  /**
+   * \brief This is the BinaryOutput used to write the parameter information in a binary format (0 if the output is written as text)
+   */
+  BinaryOutput* binout;
+  /**
+   * \brief This is the time that the parameter information was last written to the output file
+   */
+  time_t lastflush;
 };
 
 #endif
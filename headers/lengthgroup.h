@@ -36,6 +36,11 @@ public:
    * \return the mean length of the length group
    */
   double meanLength(int i) const;
+  /**
+   * \brief This function will return the mean lengths of all the length groups
+   * \return DoubleVector of the mean lengths
+   */
+  const DoubleVector& meanLengths() const { return meanlength; };
   /**
    * \brief This function will return the minimum length of a specified length group
    * \param i is the identifier of the length group
@@ -93,6 +98,12 @@ public:
    * \param outfile is the ofstream that the information gets sent to
    */
   void Print(ofstream& outfile) const;
+  /**
+   * \brief This function will check if the LengthGroupDivision has the same length groups as a second LengthGroupDivision
+   * \param lgrpdiv is the LengthGroupDivision to compare to
+   * \return 1 if the length groups are the same, 0 otherwise
+   */
+  int isSame(const LengthGroupDivision* const lgrpdiv) const;
 protected:
   /**
    * \brief This is the flag to denote whether an error has occured or not
@@ -5,6 +5,7 @@
 #include "fleetptrvector.h"
 #include "printinfo.h"
 #include "hasname.h"
+#include "observationstore.h"
 #include "gadget.h"
 
 class TimeClass;
@@ -89,12 +90,49 @@ public:
    * \return weight
    */
   double getWeight() const { return weight; };
+  /**
+   * \brief This will set the weight applied to the likelihood component
+   * \param w is the new weight
+   */
+  void setWeight(double w) { weight = w; };
+  /**
+   * \brief This will scale the contribution to the likelihood score from the current timestep
+   * \param previous is the unweighted likelihood score before the current timestep was calculated
+   * \param count is the number of times the current timestep has been selected in the resampled data
+   */
+  void resampleLikelihood(double previous, double count) { likelihood = previous + count * (likelihood - previous); };
   /**
    * \brief This will select the fleets and stocks required to calculate the likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {};
+  /**
+   * \brief This function will move the observation data specified in the input files into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   * \note This should only be called once the likelihood component has been initialised, since the observation data will be read-only once the store has been frozen
+   */
+  virtual void storeObservations(ObservationStore& store) {};
+  /**
+   * \brief This will check whether the likelihood component will be calculated on a given timestep
+   * \param time is the timestep in the model
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the likelihood component is calculated on the timestep, 0 otherwise
+   * \note The default is to calculate the likelihood component on every timestep
+   */
+  virtual int isLikelihoodStep(int time, const TimeClass* const TimeInfo) const { return 1; };
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   * \note The default is to assume that the likelihood score can decrease, so the simulation cannot be stopped early based on the likelihood score
+   */
+  virtual int isCumulative() const { return 0; };
+  /**
+   * \brief This will check whether the timesteps with data for the likelihood component can be resampled for a bootstrap replicate
+   * \return 1 if the likelihood score is a sum of independent terms for each timestep with data, 0 otherwise
+   * \note The default is to assume that the likelihood component cannot be resampled
+   */
+  virtual int canResample() const { return 0; };
 protected:
   /**
    * \brief This stores the calculated score for the likelihood component
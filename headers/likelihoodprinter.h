@@ -30,6 +30,15 @@ public:
    * \param printtime is the flag to denote when the printing is taking place
    */
   virtual void Print(const TimeClass* const TimeInfo, int printtime);
+  /**
+   * \brief This will check whether the printer class will print the requested information on a given timestep
+   * \param time is the timestep in the model
+   * \param printtime is the flag to denote when the printing is taking place
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the printer class will print the information, 0 otherwise
+   */
+  virtual int isPrintStep(int time, int printtime, const TimeClass* const TimeInfo) const {
+    return (printtime == printtimeid); };
 protected:
   /**
    * \brief This is the CharPtrVector of the names of the likelihood components to print
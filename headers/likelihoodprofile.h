@@ -0,0 +1,130 @@
+#ifndef likelihoodprofile_h
+#define likelihoodprofile_h
+
+#include "parametervector.h"
+#include "intvector.h"
+#include "doublevector.h"
+#include "doublematrix.h"
+#include "likelihoodptrvector.h"
+#include "commentstream.h"
+#include "gadget.h"
+
+/**
+ * \class LikelihoodProfile
+ * \brief This is the class used to calculate the likelihood profile over a grid of values for one or two switches
+ *
+ * This class is used to calculate the likelihood profile for one or two switches, when Gadget is started with the -likprofile switch.  The switches are fixed at each value on a grid, and the other parameters are optimised using the optimisation algorithms specified in the optimisation file.  The grid point closest to the initial values of the switches is optimised first, starting from the initial values of the parameters, and each of the other grid points is optimised starting from the optimum found for the neighbouring grid point that is one step closer to the first grid point.  Each grid point is optimised by a separate process created using fork() once the model has been initialised, so the grid points whose neighbouring grid point has already been optimised can be optimised in parallel.  The grid point that each optimisation starts from does not depend on the number of processes, so the results can be repeated.  The likelihood scores for all the grid points are written to a single file.
+ */
+class LikelihoodProfile {
+public:
+  /**
+   * \brief This is the LikelihoodProfile constructor
+   * \param infile is the CommentStream to read the switches and the grid of values from
+   */
+  LikelihoodProfile(CommentStream& infile);
+  /**
+   * \brief This is the default LikelihoodProfile destructor
+   */
+  ~LikelihoodProfile();
+  /**
+   * \brief This function will optimise the model for each point on the grid, using several processes if required
+   * \param numworkers is the number of grid points that can be optimised at the same time
+   */
+  void Optimise(int numworkers);
+  /**
+   * \brief This function will write the likelihood scores for each point on the grid to file
+   * \param filename is the name of the file to write the likelihood scores to
+   * \param likevec is the LikelihoodPtrVector of the likelihood components for the current model
+   * \param prec is the precision to use when writing the values of the switches to file
+   */
+  void writeProfile(const char* const filename, const LikelihoodPtrVector& likevec, int prec);
+private:
+  /**
+   * \brief This function will return the value of a switch for a point on the grid
+   * \param sw is the index of the switch
+   * \param point is the index of the point on the grid
+   * \return value
+   */
+  double getGridValue(int sw, int point) const;
+  /**
+   * \brief This function will return the index of a switch for a point on the grid
+   * \param sw is the index of the switch
+   * \param point is the index of the point on the grid
+   * \return index of the value for the switch
+   */
+  int getGridIndex(int sw, int point) const;
+  /**
+   * \brief This function will return the distance between a point on the grid and the grid point that is optimised first
+   * \param point is the index of the point on the grid
+   * \return number of steps on the grid between the two points
+   */
+  int getDistance(int point) const;
+  /**
+   * \brief This function will find the neighbouring grid point that the optimisation for a grid point will start from
+   * \param point is the index of the point on the grid
+   * \return index of the neighbouring grid point that is one step closer to the grid point that is optimised first, or -1 for the grid point that is optimised first
+   */
+  int findNeighbour(int point) const;
+  /**
+   * \brief This function will optimise the model for one point on the grid
+   * \param point is the index of the point on the grid
+   * \param start is the index of the grid point that the optimisation will start from, or -1 to start from the initial values of the parameters
+   * \param outfile is the file descriptor that the results are sent to
+   * \note This function is only called by the process created for the grid point, and will not return
+   */
+  void runPoint(int point, int start, int outfile);
+  /**
+   * \brief This is the ParameterVector of the switches that the likelihood profile is calculated for
+   */
+  ParameterVector switches;
+  /**
+   * \brief This is the IntVector of the index of each switch in the list of parameters for the current model
+   */
+  IntVector switchpos;
+  /**
+   * \brief This is the DoubleVector of the lowest value on the grid for each switch
+   */
+  DoubleVector lower;
+  /**
+   * \brief This is the DoubleVector of the highest value on the grid for each switch
+   */
+  DoubleVector upper;
+  /**
+   * \brief This is the IntVector of the number of values on the grid for each switch
+   */
+  IntVector numvalues;
+  /**
+   * \brief This is the number of points on the grid
+   */
+  int numpoints;
+  /**
+   * \brief This is the index of the grid point that is optimised first
+   */
+  int startpoint;
+  /**
+   * \brief This is the number of likelihood components for the current model
+   */
+  int numlike;
+  /**
+   * \brief This is the number of parameters for the current model
+   */
+  int numvar;
+  /**
+   * \brief This is the IntVector of the status of each grid point (0 if it is waiting to be optimised, 1 if it is being optimised, 2 if it has been optimised and 3 if the optimisation failed)
+   */
+  IntVector status;
+  /**
+   * \brief This is the IntVector of the index of the grid point that each optimisation started from, or -1 if it started from the initial values of the parameters
+   */
+  IntVector startfrom;
+  /**
+   * \brief This is the DoubleMatrix of the results for each grid point, with each row containing the number of function evaluations, the overall likelihood score and the unweighted likelihood score for each likelihood component
+   */
+  DoubleMatrix results;
+  /**
+   * \brief This is the DoubleMatrix of the optimised values of the parameters for each grid point
+   */
+  DoubleMatrix optvalues;
+};
+
+#endif
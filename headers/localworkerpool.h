@@ -0,0 +1,87 @@
+#ifndef localworkerpool_h
+#define localworkerpool_h
+
+#include "workerpool.h"
+#include "intvector.h"
+#include "gadget.h"
+
+/**
+ * \class LocalWorkerPool
+ * \brief This is the class used to calculate the likelihood score for several points in parallel using worker processes on the local machine
+ *
+ * This class is used for a parallel optimising run when Gadget has not been compiled with the network communication.  The worker processes are created using fork() once the model has been initialised, so each worker has its own copy of the model and the global objects used by the simulation, which are not safe to share between threads.  The points are sent to the workers, and the results are returned to the main process, through pipes.  Each worker is given one point at a time, and is sent the next point in the batch as soon as it has returned the result for the previous point.
+ */
+class LocalWorkerPool : public WorkerPool {
+public:
+  /**
+   * \brief This is the LocalWorkerPool constructor
+   * \param workers is the number of worker processes
+   * \param nvar is the number of parameters sent to the worker processes for each point
+   * \param nlike is the number of likelihood components returned from the worker processes for each point
+   */
+  LocalWorkerPool(int workers, int nvar, int nlike);
+  /**
+   * \brief This is the default LocalWorkerPool destructor
+   * \note This will stop the worker processes
+   */
+  virtual ~LocalWorkerPool();
+  /**
+   * \brief This function will calculate the likelihood score for a batch of points using the worker processes
+   * \param points is the DoubleMatrix of the points, with each row containing the unscaled values for all the parameters
+   * \param results is the DoubleMatrix that will contain the results, with each row containing the overall likelihood score followed by the unweighted likelihood score for each likelihood component
+   */
+  virtual void evaluatePoints(const DoubleMatrix& points, DoubleMatrix& results);
+  /**
+   * \brief This function will write data to a pipe
+   * \param fd is the file descriptor to write to
+   * \param data is the data to be written
+   * \param num is the number of values to be written
+   * \return 1 if the data has been written, 0 otherwise
+   */
+  static int writeData(int fd, const double* data, int num);
+  /**
+   * \brief This function will read data from a pipe
+   * \param fd is the file descriptor to read from
+   * \param data is the array that will contain the data
+   * \param num is the number of values to be read
+   * \return 1 if the data has been read, 0 otherwise
+   */
+  static int readData(int fd, double* data, int num);
+private:
+  /**
+   * \brief This function will run the model for each point received by a worker process
+   * \param infile is the file descriptor that the points are received from
+   * \param outfile is the file descriptor that the results are sent to
+   * \note This function is only called by the worker processes, and will not return
+   */
+  void runWorker(int infile, int outfile);
+  /**
+   * \brief This function will send a point to a worker process
+   * \param worker is the index of the worker process
+   * \param id is the index of the point in the batch
+   * \param point is the DoubleVector containing the values for the parameters
+   */
+  void sendPoint(int worker, int id, const DoubleVector& point);
+  /**
+   * \brief This is the IntVector of the process ids of the worker processes
+   */
+  IntVector pids;
+  /**
+   * \brief This is the IntVector of the file descriptors used to send points to the worker processes
+   */
+  IntVector sendfd;
+  /**
+   * \brief This is the IntVector of the file descriptors used to receive results from the worker processes
+   */
+  IntVector receivefd;
+  /**
+   * \brief This is the DoubleVector used to store the data sent to the worker processes
+   */
+  DoubleVector senddata;
+  /**
+   * \brief This is the DoubleVector used to store the data received from the worker processes
+   */
+  DoubleVector receivedata;
+};
+
+#endif
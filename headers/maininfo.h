@@ -50,6 +50,26 @@ public:
    * \param filename is the name of the file
    */
   void setPrintFinalFile(char* filename);
+  /**
+   * \brief This function will store the filename that the Hessian matrix at the optimum will be written to
+   * \param filename is the name of the file
+   */
+  void setHessianFile(char* filename);
+  /**
+   * \brief This function will store the filename that the replicate model runs will be read from
+   * \param filename is the name of the file
+   */
+  void setReplicateFile(char* filename);
+  /**
+   * \brief This function will store the filename that the grid for the likelihood profile will be read from
+   * \param filename is the name of the file
+   */
+  void setLikelihoodProfileFile(char* filename);
+  /**
+   * \brief This function will store the filename that the profile of the model simulation will be written to
+   * \param filename is the name of the file
+   */
+  void setProfileFile(char* filename);
   /**
    * \brief This function will store the filename that the initial values for the model parameters will be read from
    * \param filename is the name of the file
@@ -60,6 +80,11 @@ public:
    * \param filename is the name of the file
    */
   void setMainGadgetFile(char* filename);
+  /**
+   * \brief This function will store the name of the Gadget executable that is running the model
+   * \param filename is the name of the executable
+   */
+  void setProgramName(const char* filename);
   /**
    * \brief This function will store the filename that the optimisation information will be read from
    * \param filename is the name of the file
@@ -80,6 +105,11 @@ public:
    * \return flag
    */
   int runNetwork() const { return runnetwork; };
+  /**
+   * \brief This function will return the flag used to determine whether the scores from each likelihood component should be sent to the master in a network run
+   * \return flag
+   */
+  int runNetworkLikelihoods() const { return netlikelihoods; };
   /**
    * \brief This function will return the flag used to determine whether the current simulation should print the model output
    * \return flag
@@ -130,6 +160,61 @@ public:
    * \return filename
    */
   char* getPrintFinalFile() const { return strPrintFinalFile; };
+  /**
+   * \brief This function will return the flag used to determine whether the Hessian matrix at the optimum should be calculated and written to file
+   * \return flag
+   */
+  int printHessian() const { return printHessianInfo; };
+  /**
+   * \brief This function will return the filename that the Hessian matrix at the optimum will be written to
+   * \return filename
+   */
+  char* getHessianFile() const { return strHessianFile; };
+  /**
+   * \brief This function will return the step size used to calculate the Hessian matrix, as a proportion of the value of each parameter
+   * \return hessianstep
+   */
+  double getHessianStep() const { return hessianstep; };
+  /**
+   * \brief This function will return the flag used to determine whether the replicate model runs should be performed
+   * \return flag
+   */
+  int runReplicates() const { return runreplicates; };
+  /**
+   * \brief This function will return the filename that the replicate model runs will be read from
+   * \return filename
+   */
+  char* getReplicateFile() const { return strReplicateFile; };
+  /**
+   * \brief This function will return the flag used to determine whether the likelihood profile should be calculated
+   * \return flag
+   */
+  int runLikelihoodProfile() const { return runlikprofile; };
+  /**
+   * \brief This function will return the filename that the grid for the likelihood profile will be read from
+   * \return filename
+   */
+  char* getLikelihoodProfileFile() const { return strLikProfileFile; };
+  /**
+   * \brief This function will return the flag used to determine whether the model simulation should be profiled
+   * \return flag
+   */
+  int runProfile() const { return runprofile; };
+  /**
+   * \brief This function will return the filename that the profile of the model simulation will be written to
+   * \return filename
+   */
+  char* getProfileFile() const { return strProfileFile; };
+  /**
+   * \brief This function will return the flag used to determine whether the profile should include the times for each simulation
+   * \return flag
+   */
+  int getProfileEvals() const { return profileevals; };
+  /**
+   * \brief This function will return the flag used to determine whether the profile should include the hardware performance counters for each phase
+   * \return flag
+   */
+  int getProfileCounters() const { return profilecounters; };
   /**
    * \brief This function will return the filename that the main model information will be read from
    * \return filename
@@ -145,6 +230,16 @@ public:
    * \return maxratio
    */
   double getMaxRatio() const { return maxratio; };
+  /**
+   * \brief This function will return the number of processes to be used to calculate the likelihood score during an optimising run
+   * \return number of processes
+   */
+  int getNumWorkers() const { return numworkers; };
+  /**
+   * \brief This function will return the name of the Gadget executable that is running the model
+   * \return filename
+   */
+  char* getProgramName() const { return strProgramName; };
 private:
   /**
    * \brief This function will read input from a file instead of the command line
@@ -167,10 +262,30 @@ private:
    * \brief This is the name of the file that the final model information will be written to
    */
   char* strPrintFinalFile;
+  /**
+   * \brief This is the name of the file that the Hessian matrix at the optimum will be written to
+   */
+  char* strHessianFile;
+  /**
+   * \brief This is the name of the file that the replicate model runs will be read from
+   */
+  char* strReplicateFile;
+  /**
+   * \brief This is the name of the file that the grid for the likelihood profile will be read from
+   */
+  char* strLikProfileFile;
+  /**
+   * \brief This is the name of the file that the profile of the model simulation will be written to
+   */
+  char* strProfileFile;
   /**
    * \brief This is the name of the file that the main model information will be read from
    */
   char* strMainGadgetFile;
+  /**
+   * \brief This is the name of the Gadget executable that is running the model
+   */
+  char* strProgramName;
   /**
    * \brief This is the PrintInfo used to store information about the format the model parameters should be written to file
    */
@@ -195,6 +310,10 @@ private:
    * \brief This is the flag used to denote whether the current simulation has been started using paramin (PVM) or not
    */
   int runnetwork;
+  /**
+   * \brief This is the flag used to denote whether the scores from each likelihood component should be sent to the master in a network run
+   */
+  int netlikelihoods;
   /**
    * \brief This is the flag used to denote whether the current simulation should print model output or not
    */
@@ -211,6 +330,30 @@ private:
    * \brief This is the flag used to denote whether the final model information should be printed or not
    */
   int printFinalInfo;
+  /**
+   * \brief This is the flag used to denote whether the Hessian matrix at the optimum should be calculated or not
+   */
+  int printHessianInfo;
+  /**
+   * \brief This is the flag used to denote whether the replicate model runs should be performed or not
+   */
+  int runreplicates;
+  /**
+   * \brief This is the flag used to denote whether the likelihood profile should be calculated or not
+   */
+  int runlikprofile;
+  /**
+   * \brief This is the flag used to denote whether the model simulation should be profiled or not
+   */
+  int runprofile;
+  /**
+   * \brief This is the flag used to denote whether the profile should include the times for each simulation or not
+   */
+  int profileevals;
+  /**
+   * \brief This is the flag used to denote whether the profile should include the hardware performance counters or not
+   */
+  int profilecounters;
   /**
    * \brief This is the value used to decide on the level of warnings displayed during the model run
    */
@@ -219,6 +362,14 @@ private:
    * \brief This is the maximum ratio of a stock that can be consumed on any given timestep
    */
   double maxratio;
+  /**
+   * \brief This is the number of processes to be used to calculate the likelihood score during an optimising run
+   */
+  int numworkers;
+  /**
+   * \brief This is the step size used to calculate the Hessian matrix, as a proportion of the value of each parameter
+   */
+  double hessianstep;
 };
 
 #endif
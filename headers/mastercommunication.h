@@ -0,0 +1,81 @@
+#ifndef mastercommunication_h
+#define mastercommunication_h
+
+#include "mpi.h"
+#include "workerpool.h"
+#include "pvmconstants.h"
+#include "maininfo.h"
+#include "keeper.h"
+#include "gadget.h"
+
+/* The number of points that can be queued for each slave at any time */
+const int masterQueueLength = 2;
+
+/**
+ * \class MasterCommunication
+ * \brief This is the class used to calculate the likelihood score for several points in parallel using Gadget slave processes started with MPI
+ *
+ * This class is used for a parallel optimising run when Gadget has been compiled with the network communication.  The slave processes are started using MPI_Comm_spawn, running Gadget in network mode (using the -n switch) on the same model, and this class then takes the place of paramin as the master for these slaves, using the same tags from PVMConstants.  Each slave is sent the number of parameters, the names of the parameters and the bounds for the parameters, and then each point is sent using the packed communication, with several points queued for each slave so that the next point is transferred while the current point is calculated.
+ */
+class MasterCommunication : public WorkerPool {
+public:
+  /**
+   * \brief This is the MasterCommunication constructor
+   * \param workers is the number of slave processes
+   * \param nlike is the number of likelihood components returned from the slave processes for each point
+   * \param main is the MainInfo specifying the command line options for the model run
+   * \param keeper is the Keeper for the current model
+   */
+  MasterCommunication(int workers, int nlike, const MainInfo& main, const Keeper* const keeper);
+  /**
+   * \brief This is the default MasterCommunication destructor
+   * \note This will stop the slave processes
+   */
+  virtual ~MasterCommunication();
+  /**
+   * \brief This function will calculate the likelihood score for a batch of points using the slave processes
+   * \param points is the DoubleMatrix of the points, with each row containing the unscaled values for all the parameters
+   * \param results is the DoubleMatrix that will contain the results, with each row containing the overall likelihood score followed by the unweighted likelihood score for each likelihood component
+   */
+  virtual void evaluatePoints(const DoubleMatrix& points, DoubleMatrix& results);
+private:
+  /**
+   * \brief This function will send a point to a slave process
+   * \param slave is the index of the slave process
+   * \param id is the index of the point in the batch
+   * \param point is the DoubleVector containing the values for the parameters
+   */
+  void sendPoint(int slave, int id, const DoubleVector& point);
+  /**
+   * \brief This function will receive the result for a point from any of the slave processes
+   * \param status is the MPI_Status that will contain the slave process that the result was received from
+   * \note The packed result and the scores from each likelihood component are sent as two messages, and are stored in receivedata
+   */
+  void receiveResult(MPI_Status& status);
+  /**
+   * \brief This is the PVMConstants used to specify the tags for the network communication
+   */
+  PVMConstants* pvmConst;
+  /**
+   * \brief This is the intercommunicator used to communicate with the slave processes
+   */
+  MPI_Comm slavecomm;
+  /**
+   * \brief This is the identifier of the current batch of points, which is sent to the slaves as the tag for each point
+   */
+  int batch;
+  /**
+   * \brief This is the DoubleVector used to store the data sent to the slave processes
+   */
+  DoubleVector senddata;
+  /**
+   * \brief This is the DoubleVector used to store the data received from the slave processes
+   */
+  DoubleVector receivedata;
+  /**
+   * \brief This is the DoubleVector used to store the scores from each likelihood component received from the slave processes
+   */
+  DoubleVector receivelikes;
+};
+
+#endif
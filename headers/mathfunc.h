@@ -113,6 +113,18 @@ inline double randomNumber() {
   return (k / 32767.0);
 }
 
+/**
+ * \brief This function will generate a random number from the standard normal distribution
+ * \return random number
+ * \note This function uses the Box-Muller transform of two uniformly-distributed random numbers
+ */
+inline double randomNormal() {
+  double u = randomNumber();
+  while (u < verysmall)  //JMB randomNumber can return 0.0
+    u = randomNumber();
+  return sqrt(-2.0 * log(u)) * cos(2.0 * pivalue * randomNumber());
+}
+
 /**
  * \brief This function will calculate the calculate the effective annual mortality caused by a given predation on a specified population during a timestep
  * \param pred is the number that is removed from the population by the predation
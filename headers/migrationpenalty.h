@@ -28,6 +28,14 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This will check whether the likelihood component will be calculated on a given timestep
+   * \param time is the timestep in the model
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the likelihood component is calculated on the timestep, 0 otherwise
+   */
+  virtual int isLikelihoodStep(int time, const TimeClass* const TimeInfo) const {
+    return (time == TimeInfo->numTotalSteps()); };
   /**
    * \brief This will select the fleets and stocks required to calculate the MigrationPenalty likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
@@ -50,6 +58,11 @@ public:
    * \note This function is not used for this likelihood component
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   */
+  virtual int isCumulative() const { return 1; };
 private:
   /**
    * \brief This is the name of the stock that will be checked for incorrect migration
@@ -33,6 +33,21 @@ public:
    * \return likelihood
    */
   double calcLogLikelihood(const DoubleVector& data, const DoubleVector& dist);
+  /**
+   * \brief This is the function that calculates a log likelihood score by comparing 2 vectors based on a multinomial distribution, using a precalculated value for the part of the score that only depends on the input data
+   * \param data is the DoubleVector containing the input data
+   * \param dist is the DoubleVector containing the modelled data
+   * \param dataterm is the value returned by calcDataTerm for the input data
+   * \return likelihood
+   */
+  double calcLogLikelihood(const DoubleVector& data, const DoubleVector& dist, double dataterm);
+  /**
+   * \brief This function will calculate the part of the multinomial log likelihood score that only depends on the input data
+   * \param data is the DoubleVector containing the input data
+   * \return the sum of the log factorials of the data, minus the log factorial of the total of the data
+   * \note Since the input data will not change during a model run, this only needs to be calculated once, when the data has been read from the input file
+   */
+  double calcDataTerm(const DoubleVector& data) const;
   /**
    * \brief This will return the log likelihood score
    * \return loglikelihood
@@ -0,0 +1,103 @@
+#ifndef observationstore_h
+#define observationstore_h
+
+#include "doublematrix.h"
+#include "doublematrixptrvector.h"
+#include "doublematrixptrmatrix.h"
+#include "charptrvector.h"
+#include "gadget.h"
+
+/* The minimum number of double values allocated for each block of the store */
+const int obsStoreBlockSize = 131072;
+
+/**
+ * \class ObservationStore
+ * \brief This is the class used to store the observation data from the likelihood components in memory that is shared between the processes running the model
+ *
+ * This class is used to hold the data read from the input files for the likelihood components, which will not change once the model has been initialised.  The entries of the DoubleMatrix objects that contain the data are moved into large blocks of memory allocated using mmap, and once all the data has been stored these blocks are made read-only.  Since these blocks are never written to after the model has been initialised, the worker processes created for a parallel run will share a single copy of the observation data with the main process, rather than each worker getting a separate copy as soon as any other data on the same page of memory is changed.
+ * \note The store is reference counted, so that it can be shared by several Ecosystem objects, and the memory is only freed when the last reference to the store has been removed
+ */
+class ObservationStore {
+public:
+  /**
+   * \brief This is the default ObservationStore constructor
+   */
+  ObservationStore();
+  /**
+   * \brief This is the default ObservationStore destructor
+   * \note This will free the memory used to store the observation data, so this should only be called when there are no more references to the store
+   */
+  ~ObservationStore();
+  /**
+   * \brief This function will move the entries of a DoubleMatrix into the store
+   * \param matrix is the DoubleMatrix containing the observation data
+   */
+  void storeMatrix(DoubleMatrix& matrix);
+  /**
+   * \brief This function will move the entries of each DoubleMatrix in a DoubleMatrixPtrVector into the store
+   * \param matrices is the DoubleMatrixPtrVector containing the observation data
+   */
+  void storeMatrices(DoubleMatrixPtrVector& matrices);
+  /**
+   * \brief This function will move the entries of each DoubleMatrix in a DoubleMatrixPtrMatrix into the store
+   * \param matrices is the DoubleMatrixPtrMatrix containing the observation data
+   */
+  void storeMatrices(DoubleMatrixPtrMatrix& matrices);
+  /**
+   * \brief This function will make the memory used to store the observation data read-only
+   * \note No more data can be added to the store once this function has been called
+   */
+  void Freeze();
+  /**
+   * \brief This function will check if the store has been made read-only
+   * \return 1 if the store is read-only, 0 otherwise
+   */
+  int isFrozen() const { return frozen; };
+  /**
+   * \brief This function will add a reference to the store
+   */
+  void addReference() { references++; };
+  /**
+   * \brief This function will remove a reference to the store
+   * \return the number of references remaining
+   */
+  int removeReference() { references--; return references; };
+  /**
+   * \brief This function will return the number of double values held in the store
+   * \return number of values
+   */
+  long int getSize() const { return totalsize; };
+private:
+  /**
+   * \brief This function will allocate memory from the store
+   * \param num is the number of double values required
+   * \return pointer to the memory allocated
+   */
+  double* allocate(int num);
+  /**
+   * \brief This is the CharPtrVector of the blocks of memory allocated using mmap
+   */
+  CharPtrVector blocks;
+  /**
+   * \brief This is the IntVector of the number of double values in each block of memory
+   */
+  IntVector blocksize;
+  /**
+   * \brief This is the number of double values that have been used in the current block of memory
+   */
+  int used;
+  /**
+   * \brief This is the total number of double values held in the store
+   */
+  long int totalsize;
+  /**
+   * \brief This is the number of references to the store
+   */
+  int references;
+  /**
+   * \brief This is the flag used to denote whether the store has been made read-only
+   */
+  int frozen;
+};
+
+#endif
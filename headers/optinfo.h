@@ -6,7 +6,7 @@
 #include "doublevector.h"
 #include "intvector.h"
 
-enum OptType { OPTHOOKE = 1, OPTSIMANN, OPTBFGS };
+enum OptType { OPTHOOKE = 1, OPTSIMANN, OPTBFGS, OPTLBFGS, OPTCMAES, OPTBOBYQA };
 
 /**
  * \class OptInfo
@@ -109,6 +109,16 @@ private:
    * \return the best function value found from the search
    */
   double bestNearby(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
+  /**
+   * \brief This function will calculate the best point that can be found close to the current point, when the likelihood score is calculated in parallel
+   * \param delta is the DoubleVector of the steps to take when looking for the best point
+   * \param point is the DoubleVector that will contain the parameters corresponding to the best function value found from the search
+   * \param prevbest is the current best point value
+   * \param param is the IntVector containing the order that the parameters should be searched in
+   * \return the best function value found from the search
+   * \note This function moves each parameter on its own from the current point, so the points can be calculated at the same time, and then combines the moves that improved the likelihood score
+   */
+  double parallelNearby(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
   /**
    * \brief This is the maximum number of iterations for the Hooke & Jeeves optimisation
    */
@@ -223,6 +233,8 @@ private:
  * BFGS is a quasi-Newton global optimisation method that uses information about the gradient of the function at the current point to calculate the best direction to look in to find a better point.  Using this information, the BFGS algorithm can iteratively calculate a better approximation to the inverse Hessian matrix, which will lead to a better approximation of the minimum value.  From an initial starting point, the gradient of the function is calculated and then the algorithm uses this information to calculate the best direction to perform a linesearch for a point that is ''sufficiently better''.  The linesearch that is used in Gadget to look for a better point in this direction is the ''Armijo'' linesearch.  The algorithm will then adjust the current estimate of the inverse Hessian matrix, and restart from this new point.  If a better point cannot be found, then the inverse Hessian matrix is reset and the algorithm restarts from the last accepted point.
  *
  * The BFGS algorithm used in Gadget is derived from that presented by Dimitri P Bertsekas, ''Nonlinear Programming'' (2nd edition, pp22-61) published by Athena Scientific.
+ *
+ * \note The gradient is calculated using forward differences, which needs one extra simulation for each parameter.  Gadget does not calculate exact derivatives of the likelihood score, since the parameters are passed to the simulation as plain numbers and the likelihood score is not differentiable at the thresholds used in the simulation.  The extra simulations are independent, so they are calculated at the same time when Gadget is started with the -parallel switch.
  */
 class OptInfoBFGS : public OptInfo  {
 public:
@@ -298,4 +310,230 @@ private:
   double gradeps;
 };
 
+/**
+ * \class OptInfoLBFGS
+ * \brief This is the class used for the limited memory BFGS optimisation with bounds
+ *
+ * L-BFGS-B is a limited memory version of the BFGS algorithm that keeps the parameters within the bounds specified in the input file.  Rather than storing an approximation to the inverse Hessian matrix, the algorithm stores the changes in the parameters and in the gradient from the last few iterations, and uses these to calculate the search direction.  This means that the memory and time needed for each iteration is proportional to the number of parameters, rather than the square of the number of parameters.  The gradient is calculated in the same way as for the BFGS algorithm, and the ''Armijo'' linesearch is performed along the search direction, projected back onto the bounds.  Parameters that are at a bound, where the gradient would move them outside the bounds, are held fixed when calculating the search direction.
+ *
+ * The L-BFGS-B algorithm used in Gadget is derived from that presented by Richard H Byrd, Peihuang Lu, Jorge Nocedal and Ciyou Zhu, ''A Limited Memory Algorithm for Bound Constrained Optimization'', SIAM Journal on Scientific Computing 16(5), pp1190-1208, using a projected search direction instead of the generalized Cauchy point.
+ */
+class OptInfoLBFGS : public OptInfo  {
+public:
+  /**
+   * \brief This is the default OptInfoLBFGS constructor
+   */
+  OptInfoLBFGS();
+  /**
+   * \brief This is the default OptInfoLBFGS destructor
+   */
+  ~OptInfoLBFGS() {};
+  /**
+   * \brief This is the function used to read in the L-BFGS-B parameters
+   * \param infile is the CommentStream to read the optimisation parameters from
+   * \param text is a text string used to compare parameter names
+   */
+  virtual void read(CommentStream& infile, char* text);
+  /**
+   * \brief This function will print information from the optimisation algorithm
+   * \param outfile is the ofstream that the optimisation information gets sent to
+   * \param prec is the precision to use in the output file
+   */
+  virtual void Print(ofstream& outfile, int prec);
+  /**
+   * \brief This is the function that will calculate the likelihood score using the L-BFGS-B optimiser
+   */
+  virtual void OptimiseLikelihood();
+private:
+  /**
+   * \brief This function will numerically calculate the gradient of the function at the current point
+   * \param point is the DoubleVector that contains the parameters corresponding to the current function value
+   * \param pointvalue is the current function value
+   * \param newgrad is the DoubleVector that will contain the gradient vector for the current point
+   * \param upperb is the DoubleVector that contains the upper bounds for the parameters
+   * \note A backward difference is used for any parameter that would be moved outside the upper bound
+   */
+  void gradient(DoubleVector& point, double pointvalue, DoubleVector& newgrad, const DoubleVector& upperb);
+  /**
+   * \brief This function will calculate the search direction from the gradient and the stored changes from the previous iterations
+   * \param grad is the DoubleVector that contains the gradient vector for the current point
+   * \param isfree is the IntVector of the flags denoting whether each parameter is free to move
+   * \param search is the DoubleVector that will contain the search direction
+   * \param s is the DoubleMatrix that contains the stored changes in the parameters
+   * \param y is the DoubleMatrix that contains the stored changes in the gradient
+   * \param rho is the DoubleVector that contains the inverse of the product of the stored changes
+   * \param numstored is the number of changes that have been stored
+   * \param last is the index of the most recent change that has been stored
+   */
+  void calcSearch(const DoubleVector& grad, const IntVector& isfree, DoubleVector& search,
+    const DoubleMatrix& s, const DoubleMatrix& y, const DoubleVector& rho, int numstored, int last);
+  /**
+   * \brief This is the maximum number of function evaluations for the L-BFGS-B optimiation
+   */
+  int lbfgsiter;
+  /**
+   * \brief This is the halt criteria for the L-BFGS-B algorithm
+   */
+  double lbfgseps;
+  /**
+   * \brief This is the number of previous iterations stored to calculate the search direction
+   */
+  int lbfgsmem;
+  /**
+   * \brief This is the adjustment factor in the Armijo linesearch
+   */
+  double beta;
+  /**
+   * \brief This is the halt criteria for the Armijo linesearch
+   */
+  double sigma;
+  /**
+   * \brief This is the initial step size for the Armijo linesearch
+   */
+  double step;
+  /**
+   * \brief This is the accuracy term used when calculating the gradient
+   */
+  double gradacc;
+  /**
+   * \brief This is the factor used to adjust the gradient accuracy term
+   */
+  double gradstep;
+  /**
+   * \brief This is the halt criteria for the gradient accuracy term
+   */
+  double gradeps;
+};
+
+/**
+ * \class OptInfoCMAES
+ * \brief This is the class used for the CMA-ES optimisation
+ *
+ * CMA-ES (Covariance Matrix Adaptation Evolution Strategy) is a global optimisation method that generates a population of trial points for each generation from a multivariate normal distribution.  The trial points are ranked by their likelihood score, and the best half of the trial points are used to move the mean of the distribution and to adapt the covariance matrix and step size of the distribution, so that the distribution will learn the shape of the likelihood surface.  Since all the trial points in a generation are independent, they can be calculated at the same time.  When the distribution has converged, the algorithm is restarted from a random point with a larger population (the ''IPOP'' restart strategy), which makes a more global search of the likelihood surface.  The parameters are mapped onto the unit interval using the bounds specified in the input file, and trial points outside the bounds are reflected back into the bounds.
+ *
+ * The CMA-ES algorithm used in Gadget is derived from that presented by Nikolaus Hansen, ''The CMA Evolution Strategy: A Tutorial'' (2016), and the restart strategy is derived from that presented by Anne Auger and Nikolaus Hansen, ''A Restart CMA Evolution Strategy With Increasing Population Size'' in the proceedings of the 2005 IEEE Congress on Evolutionary Computation (pp. 1769-1776).
+ */
+class OptInfoCMAES : public OptInfo  {
+public:
+  /**
+   * \brief This is the default OptInfoCMAES constructor
+   */
+  OptInfoCMAES();
+  /**
+   * \brief This is the default OptInfoCMAES destructor
+   */
+  ~OptInfoCMAES() {};
+  /**
+   * \brief This is the function used to read in the CMA-ES parameters
+   * \param infile is the CommentStream to read the optimisation parameters from
+   * \param text is a text string used to compare parameter names
+   */
+  virtual void read(CommentStream& infile, char* text);
+  /**
+   * \brief This function will print information from the optimisation algorithm
+   * \param outfile is the ofstream that the optimisation information gets sent to
+   * \param prec is the precision to use in the output file
+   */
+  virtual void Print(ofstream& outfile, int prec);
+  /**
+   * \brief This is the function that will calculate the likelihood score using the CMA-ES optimiser
+   */
+  virtual void OptimiseLikelihood();
+private:
+  /**
+   * \brief This function will calculate the eigenvectors and eigenvalues of the covariance matrix
+   * \param C is the DoubleMatrix containing the covariance matrix
+   * \param B is the DoubleMatrix that will contain the eigenvectors of the covariance matrix
+   * \param D is the DoubleVector that will contain the square root of the eigenvalues of the covariance matrix
+   */
+  void calcEigen(const DoubleMatrix& C, DoubleMatrix& B, DoubleVector& D);
+  /**
+   * \brief This is the maximum number of function evaluations for the CMA-ES optimiation
+   */
+  int cmaesiter;
+  /**
+   * \brief This is the halt criteria for the CMA-ES algorithm
+   */
+  double cmaeseps;
+  /**
+   * \brief This is the initial step size, as a proportion of the distance between the bounds
+   */
+  double sigma;
+  /**
+   * \brief This is the number of trial points in each generation for the first run (default 0, calculated from the number of parameters)
+   */
+  int lambda;
+  /**
+   * \brief This is the maximum number of times that the algorithm will be restarted with a larger population
+   */
+  int restarts;
+};
+
+/**
+ * \class OptInfoBOBYQA
+ * \brief This is the class used for the BOBYQA optimisation
+ *
+ * BOBYQA (Bound Optimisation BY Quadratic Approximation) is a trust region optimisation method that doesnt use the gradient of the function.  A quadratic model of the likelihood surface is calculated from the likelihood scores at 2n+1 interpolation points (for n parameters), and each iteration minimises this model within a trust region around the best point, while keeping the parameters within the bounds.  The likelihood score at the new point then replaces one of the interpolation points, so each iteration only needs one function evaluation.  The quadratic model is updated so that the change to the second derivative matrix is as small as possible, and the radius of the trust region is reduced when the model can no longer find a better point.  This means that the BOBYQA algorithm will usually need far fewer function evaluations than the Hooke & Jeeves algorithm for a smooth likelihood surface.
+ *
+ * The BOBYQA algorithm used in Gadget is derived from that presented by M J D Powell, ''The BOBYQA algorithm for bound constrained optimization without derivatives'', Cambridge NA Report NA2009/06 (2009).  This version calculates the quadratic model directly from the interpolation points for each iteration, rather than updating the inverse of the interpolation matrix.
+ */
+class OptInfoBOBYQA : public OptInfo  {
+public:
+  /**
+   * \brief This is the default OptInfoBOBYQA constructor
+   */
+  OptInfoBOBYQA();
+  /**
+   * \brief This is the default OptInfoBOBYQA destructor
+   */
+  ~OptInfoBOBYQA() {};
+  /**
+   * \brief This is the function used to read in the BOBYQA parameters
+   * \param infile is the CommentStream to read the optimisation parameters from
+   * \param text is a text string used to compare parameter names
+   */
+  virtual void read(CommentStream& infile, char* text);
+  /**
+   * \brief This function will print information from the optimisation algorithm
+   * \param outfile is the ofstream that the optimisation information gets sent to
+   * \param prec is the precision to use in the output file
+   */
+  virtual void Print(ofstream& outfile, int prec);
+  /**
+   * \brief This is the function that will calculate the likelihood score using the BOBYQA optimiser
+   */
+  virtual void OptimiseLikelihood();
+private:
+  /**
+   * \brief This function will calculate the inverse of a matrix, using Gauss-Jordan elimination with partial pivoting
+   * \param A is the DoubleMatrix that will be replaced by its inverse
+   * \return 1 if the inverse has been calculated, 0 if the matrix is singular
+   */
+  int calcInverse(DoubleMatrix& A);
+  /**
+   * \brief This function will calculate the step that minimises the quadratic model within the trust region and the bounds, using a truncated conjugate gradient method
+   * \param point is the DoubleVector of the current best point
+   * \param grad is the DoubleVector of the gradient of the quadratic model at the current best point
+   * \param hess is the DoubleMatrix of the second derivatives of the quadratic model
+   * \param lowerb is the DoubleVector of the lower bounds of the parameters
+   * \param upperb is the DoubleVector of the upper bounds of the parameters
+   * \param delta is the radius of the trust region
+   * \param step is the DoubleVector that will contain the calculated step
+   */
+  void calcStep(const DoubleVector& point, const DoubleVector& grad, const DoubleMatrix& hess,
+    const DoubleVector& lowerb, const DoubleVector& upperb, double delta, DoubleVector& step);
+  /**
+   * \brief This is the maximum number of function evaluations for the BOBYQA optimiation
+   */
+  int bobyqaiter;
+  /**
+   * \brief This is the halt criteria for the BOBYQA algorithm, the final radius of the trust region
+   */
+  double bobyqaeps;
+  /**
+   * \brief This is the initial radius of the trust region
+   */
+  double rhobeg;
+};
+
 #endif
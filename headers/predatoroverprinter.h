@@ -34,6 +34,11 @@ public:
    */
   virtual void Print(const TimeClass* const TimeInfo, int printtime);
 protected:
+  /**
+   * \brief This will print the requested information for the printer class in the binary format
+   * \param TimeInfo is the TimeClass for the current model
+   */
+  void printBinary(const TimeClass* const TimeInfo);
   /**
    * \brief This is the IntMatrix used to store aggregated area information
    */
@@ -93,6 +93,13 @@ public:
    * \param predcons is the DoubleVector containing the predation data
    */
   void addBiomassConsumption(int area, const DoubleVector& predcons);
+  /**
+   * \brief This function will add predation (by biomass) from all the length groups of a predator to the amount of the prey that is consumed
+   * \param area is the area that the consumption is being calculated on
+   * \param predcons is the DoubleMatrix containing the predation data, with one row for each length group of the predator
+   * \note This is equivalent to calling addBiomassConsumption for each row of predcons
+   */
+  void addBiomassConsumption(int area, const DoubleMatrix& predcons);
   /**
    * \brief This function will add predation (by numbers) to the amount of the prey that is consumed
    * \param area is the area that the consumption is being calculated on
@@ -112,6 +119,12 @@ public:
    * \return biomass
    */
   double getBiomass(int area, int length) const { return biomass[this->areaNum(area)][length]; };
+  /**
+   * \brief This will return the biomass of prey that is available for consumption by predators
+   * \param area is the area that the consumption is being calculated on
+   * \return biomass, a DoubleVector containing the biomass for each length group of the prey
+   */
+  const DoubleVector& getBiomass(int area) const { return biomass[this->areaNum(area)]; };
   /**
    * \brief This will return the number of prey that is available for consumption by predators
    * \param area is the area that the consumption is being calculated on
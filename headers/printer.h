@@ -12,6 +12,7 @@
 #include "likelihoodptrvector.h"
 #include "charptrvector.h"
 #include "intmatrix.h"
+#include "binaryoutput.h"
 #include "gadget.h"
 
 enum PrinterType { STOCKPRINTER = 1, PREDATORPRINTER, PREDATOROVERPRINTER,
@@ -29,7 +30,7 @@ public:
    * \brief This is the default Printer constructor
    * \param ptype is the PrinterType of the printer
    */
-  Printer(PrinterType ptype) { type = ptype; };
+  Printer(PrinterType ptype) { type = ptype; binout = 0; };
   /**
    * \brief This is the default Printer destructor
    */
@@ -70,6 +71,15 @@ public:
    * \param likevec is the LikelihoodPtrVector of all the available likelihood components
    */
   virtual void setLikelihood(LikelihoodPtrVector& likevec) {};
+  /**
+   * \brief This will check whether the printer class will print the requested information on a given timestep
+   * \param time is the timestep in the model
+   * \param printtime is the flag to denote when the printing is taking place
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the printer class will print the information, 0 otherwise
+   */
+  virtual int isPrintStep(int time, int printtime, const TimeClass* const TimeInfo) const {
+    return ((printtime == printtimeid) && (AAT.atTime(time))); };
   /**
    * \brief This will return the name of the output file
    * \return name
@@ -108,6 +118,11 @@ protected:
    * \note This value is set to precision + 4
    */
   int width;
+  /**
+   * \brief This is the BinaryOutput used to write the information to the output file in a binary format
+   * \note The default value is 0, which corresponds to writing the information to the output file as text
+   */
+  BinaryOutput* binout;
 private:
   /**
    * \brief This denotes what type of printer class has been created
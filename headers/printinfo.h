@@ -42,6 +42,16 @@ public:
    * \param prec is the precision
    */
   void setPrecision(int prec) { givenPrecision = prec; };
+  /**
+   * \brief This function will set the flag used to determine whether the model parameters should be printed to file in a binary format
+   * \param binary is the flag
+   */
+  void setBinaryOutput(int binary) { binaryoutput = binary; };
+  /**
+   * \brief This function will set the flag used to determine whether the model parameters should be printed to file
+   * \param print is the flag
+   */
+  void setPrint(int print) { printoutput = print; };
   /**
    * \brief This function will check the printing intervals and precision values that have been set, and override them with default vakues if required
    * \param net is the flag to denote whether the current model run is a network run or not
@@ -72,6 +82,11 @@ public:
    * \return print interval
    */
   int getPrintIteration() const { return printiter; };
+  /**
+   * \brief This function will return the flag used to determine whether the model parameters should be printed to file in a binary format
+   * \return flag
+   */
+  int getBinaryOutput() const { return binaryoutput; };
 private:
   /**
    * \brief This is the name of the file that the final parameter values will be written to
@@ -93,6 +108,10 @@ private:
    * \brief This is the precision that should be used when printing the model parameters
    */
   int givenPrecision;
+  /**
+   * \brief This is the flag used to denote whether the model parameters should be printed in a binary format or not
+   */
+  int binaryoutput;
 };
 
 #endif
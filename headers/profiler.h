@@ -0,0 +1,234 @@
+#ifndef profiler_h
+#define profiler_h
+
+#include "doublematrix.h"
+#include "doublematrixptrvector.h"
+#include "doublevector.h"
+#include "intvector.h"
+#include "charptrvector.h"
+#include "baseclassptrvector.h"
+#include "likelihoodptrvector.h"
+#include "gadget.h"
+
+/* The phases of the simulation that are timed by the profiler */
+enum ProfilePhase { PROFRESET = 0, PROFLIKERESET, PROFTAGS, PROFPRINT, PROFMIGRATE,
+  PROFCALCNUMBERS, PROFCALCEAT, PROFCHECKEAT, PROFADJUSTEAT, PROFREDUCEPOP, PROFGROW,
+  PROFPOPPART1, PROFPOPPART2, PROFPOPPART3, PROFPOPPART4, PROFPOPPART5,
+  PROFLIKELIHOOD, PROFAGEPART1, PROFAGEPART2, PROFAGEPART3, PROFKEEPER, NUMPROFPHASES };
+
+/* The hardware performance counters that can be added to the profile */
+enum ProfileCounter { PROFCYCLES = 0, PROFINSTRUCTIONS, PROFCACHEMISSES,
+  PROFBRANCHMISSES, NUMPROFCOUNTERS };
+
+/**
+ * \class Profiler
+ * \brief This is the class used to time the phases of the model simulation
+ *
+ * This class is used to find out where the time is spent when the model is simulated, when Gadget is started with the -profile switch.  The time spent on each phase of the simulation is stored for each stock, fleet and otherfood class, or for each likelihood component, and a summary table is written to file when Gadget finishes.  The clock is only read at the boundaries between the phases, so the overhead of the profiling is small, and when the profiling is not active each call to addTime only checks a flag.
+ *
+ * On Linux, the hardware performance counters (cycles, instructions, last level cache misses and branch misses) can also be read at the boundaries between the phases, using the perf_event_open system call, so that the instructions per cycle and the cache miss rates can be found for each phase and each stock.  If these counters are not available then only the time spent on each phase is measured.
+ * \note The simulations that are run by the worker processes during a parallel optimising run are not included in the profile
+ */
+class Profiler {
+public:
+  /**
+   * \brief This is the default Profiler constructor
+   */
+  Profiler();
+  /**
+   * \brief This is the default Profiler destructor
+   */
+  ~Profiler();
+  /**
+   * \brief This function will open the file that the profile of the model simulation will be written to
+   * \param filename is the name of the file that the profile will be written to
+   * \param evals is the flag to denote whether the times for each simulation should be written to the file
+   * \param counters is the flag to denote whether the hardware performance counters should be read
+   */
+  void Initialise(const char* filename, int evals, int counters);
+  /**
+   * \brief This function will start the profiling of the model simulation, if a profile file has been opened
+   * \param basevec is the BaseClassPtrVector of the stocks, fleets and otherfood classes for the model
+   * \param likevec is the LikelihoodPtrVector of the likelihood components for the model
+   * \note This function must be called after the model has been initialised, since the stocks and likelihood components are stored by index
+   */
+  void setObjects(const BaseClassPtrVector& basevec, const LikelihoodPtrVector& likevec);
+  /**
+   * \brief This function will return the flag used to denote whether the simulation is being profiled
+   * \return active
+   */
+  int isActive() const { return active; };
+  /**
+   * \brief This function will start the timer for the next phase
+   */
+  void startTimer() {
+    if (active) {
+      lasttime = getTime();
+      if (counting)
+        readCounters(lastcounts);
+    }
+  };
+  /**
+   * \brief This function will add the time since the timer was last read to a phase
+   * \param phase is the ProfilePhase that the time is added to
+   * \param id is the index of the stock or likelihood component for the phase
+   */
+  void addTime(int phase, int id) {
+    if (active) {
+      double now = getTime();
+      phasetimes[phase][id] += now - lasttime;
+      lasttime = now;
+      if (counting)
+        addCounters(phase, id);
+    }
+  };
+  /**
+   * \brief This function will start the timer for a model simulation
+   */
+  void startSimulation();
+  /**
+   * \brief This function will stop the timer for a model simulation, and write the times for that simulation to file if required
+   */
+  void endSimulation();
+  /**
+   * \brief This function will write the summary table of the profile to file
+   */
+  void writeSummary();
+private:
+  /**
+   * \brief This function will read the monotonic clock
+   * \return time in seconds
+   */
+  static double getTime() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+  };
+  /**
+   * \brief This function will return the name of the object for a phase
+   * \param phase is the ProfilePhase
+   * \param id is the index of the object for the phase
+   * \return name
+   */
+  const char* getObjectName(int phase, int id) const;
+  /**
+   * \brief This function will open the hardware performance counters, if they are available
+   */
+  void openCounters();
+  /**
+   * \brief This function will close the hardware performance counters
+   */
+  void closeCounters();
+  /**
+   * \brief This function will read the current values of the hardware performance counters
+   * \param counts is the DoubleVector that the values of the counters will be stored in
+   */
+  void readCounters(DoubleVector& counts);
+  /**
+   * \brief This function will add the change in the hardware performance counters since they were last read to a phase
+   * \param phase is the ProfilePhase that the counts are added to
+   * \param id is the index of the stock or likelihood component for the phase
+   */
+  void addCounters(int phase, int id);
+  /**
+   * \brief This function will write the hardware performance counters for a row of the summary table
+   * \param counts is the DoubleVector of the values of the hardware performance counters
+   */
+  void writeCounters(const DoubleVector& counts);
+  /**
+   * \brief This is the flag used to denote whether the simulation is being profiled
+   */
+  int active;
+  /**
+   * \brief This is the flag used to denote whether the profile file has been opened
+   */
+  int requested;
+  /**
+   * \brief This is the flag used to denote whether the times for each simulation should be written to file
+   */
+  int printevals;
+  /**
+   * \brief This is the flag used to denote whether the hardware performance counters are being read
+   */
+  int counting;
+  /**
+   * \brief This is the file descriptor for the group of hardware performance counters
+   */
+  int groupfd;
+  /**
+   * \brief This is the IntVector of the file descriptor for each hardware performance counter (-1 if the counter is not available)
+   */
+  IntVector counterfd;
+  /**
+   * \brief This is the IntVector of the position of each hardware performance counter in the data read from the group
+   */
+  IntVector counterpos;
+  /**
+   * \brief This is the number of hardware performance counters that are being read
+   */
+  int numcounters;
+  /**
+   * \brief This is the flag used to denote whether the hardware performance counters have been multiplexed by the kernel
+   */
+  int multiplexed;
+  /**
+   * \brief This is the number of simulations that have been profiled
+   */
+  int numsims;
+  /**
+   * \brief This is the time that the timer was last read
+   */
+  double lasttime;
+  /**
+   * \brief This is the time that the current simulation was started
+   */
+  double simstart;
+  /**
+   * \brief This is the total time spent in the simulations that have been profiled
+   */
+  double simtime;
+  /**
+   * \brief This is the DoubleMatrix, indexed by phase and object, of the time spent on each phase
+   */
+  DoubleMatrix phasetimes;
+  /**
+   * \brief This is the DoubleVector of the total time spent on each phase at the end of the previous simulation
+   */
+  DoubleVector lasttotals;
+  /**
+   * \brief This is the DoubleMatrixPtrVector, indexed by counter, phase and object, of the hardware performance counters for each phase
+   */
+  DoubleMatrixPtrVector phasecounts;
+  /**
+   * \brief This is the DoubleVector of the values of the hardware performance counters when they were last read
+   */
+  DoubleVector lastcounts;
+  /**
+   * \brief This is the DoubleVector of the values of the hardware performance counters when the current simulation was started
+   */
+  DoubleVector simstartcounts;
+  /**
+   * \brief This is the DoubleVector of the total of the hardware performance counters for the simulations that have been profiled
+   */
+  DoubleVector simcounts;
+  /**
+   * \brief This is the DoubleVector used to read the hardware performance counters
+   */
+  DoubleVector nowcounts;
+  /**
+   * \brief This is the CharPtrVector of the names of the stocks, fleets and otherfood classes
+   */
+  CharPtrVector basenames;
+  /**
+   * \brief This is the CharPtrVector of the names of the likelihood components
+   */
+  CharPtrVector likenames;
+  /**
+   * \brief This is the file that the profile is written to
+   */
+  ofstream outfile;
+};
+
+extern Profiler profile;
+
+#endif
@@ -45,6 +45,21 @@ public:
    * \return masterReceiveData
    */
   const int getMasterReceiveDataTag() const { return masterReceiveData; };
+  /**
+   * \brief This function will return the flag used to indicate that the PVM master is sending packed variables data
+   * \return masterSendPacked
+   */
+  const int getMasterSendPackedTag() const { return masterSendPacked; };
+  /**
+   * \brief This function will return the flag used to indicate that the PVM master is receiving packed data
+   * \return masterReceivePacked
+   */
+  const int getMasterReceivePackedTag() const { return masterReceivePacked; };
+  /**
+   * \brief This function will return the flag used to indicate that the PVM master is receiving the scores from each likelihood component
+   * \return masterReceiveLikelihood
+   */
+  const int getMasterReceiveLikelihoodTag() const { return masterReceiveLikelihood; };
   /**
    * \brief This function will return the flag used to indicate that a task has died
    * \return taskDied
@@ -89,6 +104,21 @@ private:
    * \brief This is the flag used to indicate that the PVM master is receiving data
    */
   int masterReceiveData;
+  /**
+   * \brief This is the flag used to indicate that the PVM master is sending packed variables data
+   * \note The packed variables data is sent as a single message containing the tag, the id and the values of the variables
+   */
+  int masterSendPacked;
+  /**
+   * \brief This is the flag used to indicate that the PVM master is receiving packed data
+   * \note The packed data is sent as a single message containing the tag, the id, the identity of the slave and the result
+   */
+  int masterReceivePacked;
+  /**
+   * \brief This is the flag used to indicate that the PVM master is receiving the scores from each likelihood component
+   * \note This message is only sent when Gadget is started with the -netlikelihoods switch, straight after the packed data message for the same point, and contains the tag, the id and then the unweighted score from each likelihood component
+   */
+  int masterReceiveLikelihood;
   /**
    * \brief This is the flag used to indicate the data encoding that will take place during the PVM network communication
    * \note Possible values for dataEncode are 0 (for XDR encoding), 1 (for no encoding, the default) and 2 (to leave the data in place during the network communication)
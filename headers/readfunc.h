@@ -5,6 +5,7 @@
 #include "areatime.h"
 #include "charptrvector.h"
 #include "formulamatrixptrvector.h"
+#include "sparseformulamatrixptrvector.h"
 #include "commentstream.h"
 
 /**
@@ -24,7 +25,7 @@ void readAmounts(CommentStream& infile, const IntVector& tmpareas,
   const TimeClass* const TimeInfo, const AreaClass* const Area,
   FormulaMatrix& amount, const char* givenname);
 void readGrowthAmounts(CommentStream& infile, const TimeClass* const TimeInfo,
-  const AreaClass* const Area, FormulaMatrixPtrVector& amount,
+  const AreaClass* const Area, SparseFormulaMatrixPtrVector& amount,
   const CharPtrVector& lenindex, const IntVector& tmpareas);
 
 #endif
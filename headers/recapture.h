@@ -45,12 +45,25 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   */
+  virtual int isCumulative() const { return 1; };
   /**
    * \brief This will select the fleets and stocks required to calculate the Recaptures likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  /**
+   * \brief This function will move the observation data for the Recaptures likelihood score into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    store.storeMatrices(obsDistribution);
+    store.storeMatrices(obsLogFactorial);
+  };
   /**
    * \brief This function will print summary information from the Recaptures likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -78,6 +91,10 @@ private:
    * \return likelihood score
    */
   double calcLikPoisson(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will calculate the part of the Poisson likelihood score that only depends on the data read from the input file
+   */
+  void calcDataTerms();
   /**
    * \brief This is the RecAggregator used to collect information about the racptured tagged fish
    */
@@ -127,6 +144,11 @@ private:
    * \note The indices for this object are [tag][time][area][length]
    */
   DoubleMatrixPtrMatrix obsDistribution;
+  /**
+   * \brief This is the DoubleMatrixPtrMatrix used to store the log factorial of the length distribution information specified in the input file
+   * \note The indices for this object are [tag][time][area][length]
+   */
+  DoubleMatrixPtrMatrix obsLogFactorial;
   /**
    * \brief This is the DoubleMatrixPtrMatrix used to store length distribution information calculated in the model for the timesteps that there were observed recaptures
    * \note The indices for this object are [tag][time][area][length]
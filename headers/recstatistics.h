@@ -46,12 +46,25 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   */
+  virtual int isCumulative() const { return 1; };
   /**
    * \brief This will select the fleets and stocks required to calculate the RecStatistics likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  /**
+   * \brief This function will move the observation data for the RecStatistics likelihood score into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    store.storeMatrices(obsMean);
+    store.storeMatrices(obsStdDev);
+  };
   /**
    * \brief This function will print summary information from the RecStatistics likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -1,11 +1,13 @@
 #ifndef renewal_h
 #define renewal_h
 
-#include "formulamatrixptrvector.h"
+#include "formulavector.h"
+#include "sparseformulamatrixptrvector.h"
 #include "conversionindex.h"
 #include "commentstream.h"
 #include "stock.h"
 #include "livesonareas.h"
+#include "intmatrix.h"
 
 /**
  * \class RenewalData
@@ -113,6 +115,10 @@ protected:
    * \brief This is the IntVector of areas that the renewal will take place on
    */
   IntVector renewalArea;
+  /**
+   * \brief This is the IntMatrix, indexed by timestep, of the renewal data that will take place on that timestep
+   */
+  IntMatrix renewalSchedule;
   /**
    * \brief This is the IntVector of ages that the renewal will take place on
    */
@@ -122,9 +128,9 @@ protected:
    */
   AgeBandMatrixPtrVector renewalDistribution;
   /**
-   * \brief This is the FormulaMatrixPtrVector that contains the number (from the input file) of the renewal population
+   * \brief This is the SparseFormulaMatrixPtrVector that contains the number (from the input file) of the renewal population
    */
-  FormulaMatrixPtrVector renewalNumber;
+  SparseFormulaMatrixPtrVector renewalNumber;
   /**
    * \brief This is the FormulaVector of the multiplier used to calculate the renewal population
    */
@@ -0,0 +1,86 @@
+#ifndef replicates_h
+#define replicates_h
+
+#include "charptrvector.h"
+#include "intvector.h"
+#include "doublematrix.h"
+#include "likelihoodptrvector.h"
+#include "commentstream.h"
+#include "gadget.h"
+
+enum ReplicateType { JACKKNIFEREPLICATE = 1, BOOTSTRAPREPLICATE };
+
+/**
+ * \class Replicates
+ * \brief This is the class used to optimise the bootstrap and jackknife replicates of the model
+ *
+ * This class is used to optimise a list of replicates of the model, when Gadget is started with the -replicates switch.  For a jackknife replicate the weight for one of the likelihood components is set to zero, so that the model is fitted without that data.  For a bootstrap replicate the timesteps with data for each likelihood component are resampled with replacement, and the likelihood score from each timestep is scaled by the number of times that timestep has been selected.  The model is only read from the input files once, and each replicate is optimised by a separate process created using fork() once the model has been initialised, so the replicates can be optimised in parallel.  The optimised parameters for each replicate are written to a separate file, and the likelihood scores for all the replicates are written to a summary file.
+ * \note Only the likelihood components that are calculated from the data for each timestep (catchdistribution, catchinkilos, catchstatistics, stockdistribution, surveydistribution and migrationproportion) are resampled for the bootstrap replicates
+ */
+class Replicates {
+public:
+  /**
+   * \brief This is the Replicates constructor
+   * \param infile is the CommentStream to read the list of replicates from
+   * \param likevec is the LikelihoodPtrVector of the likelihood components for the current model
+   */
+  Replicates(CommentStream& infile, const LikelihoodPtrVector& likevec);
+  /**
+   * \brief This is the default Replicates destructor
+   */
+  ~Replicates();
+  /**
+   * \brief This function will optimise each of the replicates, using several processes if required
+   * \param numworkers is the number of replicates that should be optimised at the same time
+   * \param filename is the name of the file that the optimised parameters will be written to, which is extended with the name of each replicate
+   * \param prec is the precision to use when writing the parameters to file
+   */
+  void Optimise(int numworkers, const char* const filename, int prec);
+  /**
+   * \brief This function will write the likelihood scores for each replicate to file
+   * \param filename is the name of the file to write the likelihood scores to
+   * \param likevec is the LikelihoodPtrVector of the likelihood components for the current model
+   */
+  void writeSummary(const char* const filename, const LikelihoodPtrVector& likevec);
+  /**
+   * \brief This will return the number of replicates
+   * \return number of replicates
+   */
+  int numReplicates() const { return names.Size(); };
+private:
+  /**
+   * \brief This function will optimise one replicate of the model
+   * \param rep is the index of the replicate
+   * \param outfile is the file descriptor that the results are sent to
+   * \param filename is the name of the file that the optimised parameters will be written to
+   * \param prec is the precision to use when writing the parameters to file
+   * \note This function is only called by the process created for the replicate, and will not return
+   */
+  void runReplicate(int rep, int outfile, const char* const filename, int prec);
+  /**
+   * \brief This is the CharPtrVector of the names of the replicates
+   */
+  CharPtrVector names;
+  /**
+   * \brief This is the IntVector of the ReplicateType of each replicate
+   */
+  IntVector types;
+  /**
+   * \brief This is the IntVector of the index of the likelihood component that is removed for a jackknife replicate, or the seed used to resample the data for a bootstrap replicate
+   */
+  IntVector values;
+  /**
+   * \brief This is the number of likelihood components for the current model
+   */
+  int numlike;
+  /**
+   * \brief This is the DoubleMatrix of the results for each replicate, with each row containing the number of function evaluations, the overall likelihood score and the unweighted likelihood score for each likelihood component
+   */
+  DoubleMatrix results;
+  /**
+   * \brief This is the IntVector of the flags used to denote whether each replicate has been optimised successfully
+   */
+  IntVector finished;
+};
+
+#endif
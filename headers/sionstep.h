@@ -10,6 +10,7 @@
 #include "actionattimes.h"
 #include "agebandmatrix.h"
 #include "stockaggregator.h"
+#include "observationstore.h"
 #include "regressionline.h"
 #include "hasname.h"
 #include "gadget.h"
@@ -58,6 +59,14 @@ public:
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) = 0;
+  /**
+   * \brief This function will move the survey index data, and the weights if specified, into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    store.storeMatrices(obsIndex);
+    store.storeMatrices(weightIndex);
+  };
   /**
    * \brief This function will reset the SIOnStep information
    */
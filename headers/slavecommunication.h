@@ -38,6 +38,17 @@ private:
   struct timeval tmout;
   ParameterVector netDataStr;
 
+  //JMB packed communication - once the master has sent a packed vector
+  //the next vector is received while the current one is being calculated
+  int packedMode;
+  double* packedData;
+  int stopMessage;
+  MPI_Request packedRequest[2];
+  void postPackedReceive();
+  int receivePacked();
+  int receiveQueued();
+  void cancelPacked();
+
 public:
   SlaveCommunication();
   ~SlaveCommunication();
@@ -47,7 +58,8 @@ public:
   int receive();
   int receiveFromMaster();
   int send(NetDataResult* sendData);
-  int sendToMaster(double res);
+  int sendPacked(NetDataResult* sendData, const DoubleVector& likes);
+  int sendToMaster(double res, const DoubleVector& likes);
   int receivedVector();
   //void getVector(DoubleVector& vec);
   void getVector(double* vec);
@@ -0,0 +1,89 @@
+#ifndef sparseformulamatrix_h
+#define sparseformulamatrix_h
+
+#include "formula.h"
+
+/**
+ * \class SparseFormulaMatrix
+ * \brief This class implements a fixed size matrix of Formula values, where the entries that are constant values are stored in a dense array of doubles and only the entries that depend on the parameters are stored as Formula
+ * \note This is intended for large tables of data (such as the growth for each timestep and length group) where almost all the entries are constant values
+ */
+class SparseFormulaMatrix {
+public:
+  /**
+   * \brief This is the SparseFormulaMatrix constructor for a specified size
+   * \param nr is the number of rows of the matrix to be created
+   * \param nc is the number of columns of the matrix to be created
+   * \param initial is the initial value for all the entries of the matrix
+   */
+  SparseFormulaMatrix(int nr, int nc, double initial);
+  /**
+   * \brief This is the SparseFormulaMatrix destructor
+   * \note This will free all the memory allocated to all the elements of the matrix
+   */
+  ~SparseFormulaMatrix();
+  /**
+   * \brief This will return the number of columns of the matrix
+   * \return the number of columns of the matrix
+   */
+  int Ncol() const { return ncol; };
+  /**
+   * \brief This will return the number of rows of the matrix
+   * \return the number of rows of the matrix
+   */
+  int Nrow() const { return nrow; };
+  /**
+   * \brief This will return the current value of an element of the matrix
+   * \param row is the row of the element to be returned
+   * \param col is the column of the element to be returned
+   * \return the value of the specified element
+   */
+  double getValue(int row, int col) const {
+    int pos = row * ncol + col;
+    if ((formulas == 0) || (formulas[pos] == 0))
+      return values[pos];
+    return *formulas[pos];
+  };
+  /**
+   * \brief This will return the Formula stored for an element of the matrix
+   * \param row is the row of the element to be returned
+   * \param col is the column of the element to be returned
+   * \return the Formula for the specified element
+   * \note A Formula will be created for the element if it is currently stored as a constant value
+   */
+  Formula& getFormula(int row, int col);
+  /**
+   * \brief This will set an element of the matrix to a Formula
+   * \param row is the row of the element to be set
+   * \param col is the column of the element to be set
+   * \param F is the Formula for the element
+   * \note The value will be stored in the dense array if the Formula is a constant value
+   */
+  void setFormula(int row, int col, const Formula& F);
+  /**
+   * \brief This function will inform Keeper of the values of the stored Formula
+   * \param keeper is the Keeper for the current model
+   * \note Any stored Formula that are constant values will be moved to the dense array
+   */
+  void Inform(Keeper* keeper);
+protected:
+  /**
+   * \brief This is number of rows of the matrix
+   */
+  int nrow;
+  /**
+   * \brief This is number of columns of the matrix
+   */
+  int ncol;
+  /**
+   * \brief This is the dense array of the constant values in the matrix
+   */
+  double* values;
+  /**
+   * \brief This is the array of Formula for the entries that are not constant values (NULL for the entries that are stored in the dense array)
+   * \note This is only created when the first Formula is stored in the matrix
+   */
+  Formula** formulas;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef sparseformulamatrixptrvector_h
+#define sparseformulamatrixptrvector_h
+
+#include "sparseformulamatrix.h"
+
+/**
+ * \class SparseFormulaMatrixPtrVector
+ * \brief This class implements a dynamic vector of SparseFormulaMatrix values
+ */
+class SparseFormulaMatrixPtrVector {
+public:
+  /**
+   * \brief This is the default SparseFormulaMatrixPtrVector constructor
+   */
+  SparseFormulaMatrixPtrVector() { size = 0; v = 0; };
+  /**
+   * \brief This is the SparseFormulaMatrixPtrVector constructor that creates a copy of an existing SparseFormulaMatrixPtrVector
+   * \param initial is the SparseFormulaMatrixPtrVector to copy
+   */
+  SparseFormulaMatrixPtrVector(const SparseFormulaMatrixPtrVector& initial);
+  /**
+   * \brief This is the SparseFormulaMatrixPtrVector destructor
+   * \note This will free all the memory allocated to all the elements of the vector
+   */
+  ~SparseFormulaMatrixPtrVector();
+  /**
+   * \brief This will add one new entry to the vector
+   * \param value is the value that will be entered for the new entry
+   */
+  void resize(SparseFormulaMatrix* value);
+  /**
+   * \brief This will delete an entry from the vector
+   * \param pos is the element of the vector to be deleted
+   * \note This will free the memory allocated to the deleted element of the vector
+   */
+  void Delete(int pos);
+  /**
+   * \brief This will return the size of the vector
+   * \return the size of the vector
+   */
+  int Size() const { return size; };
+  /**
+   * \brief This will return the value of an element of the vector
+   * \param pos is the element of the vector to be returned
+   * \return the value of the specified element
+   */
+  SparseFormulaMatrix*& operator [] (int pos) { return v[pos]; };
+  /**
+   * \brief This will return the value of an element of the vector
+   * \param pos is the element of the vector to be returned
+   * \return the value of the specified element
+   */
+  SparseFormulaMatrix* const& operator [] (int pos) const { return v[pos]; };
+protected:
+  /**
+   * \brief This is the vector of SparseFormulaMatrix values
+   */
+  SparseFormulaMatrix** v;
+  /**
+   * \brief This is the size of the vector
+   */
+  int size;
+};
+
+#endif
+
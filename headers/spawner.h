@@ -126,6 +126,10 @@ protected:
    * \brief This is the IntVector used to store information about the areas where the spawning takes place
    */
   IntVector spawnArea;
+  /**
+   * \brief This is the IntMatrix, indexed by timestep and area, of flags denoting whether the spawning takes place
+   */
+  IntMatrix spawnSchedule;
   /**
    * \brief This is the LengthGroupDivision of the stock
    */
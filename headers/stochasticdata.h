@@ -21,6 +21,12 @@
  */
 class StochasticData {
 public:
+#ifdef GADGET_NETWORK
+  /**
+   * \brief This is the StochasticData constructor for a network run, which will receive the data from the network
+   */
+  StochasticData();
+#endif
   /**
    * \brief This is the default StochasticData constructor
    */
@@ -97,8 +103,9 @@ public:
   /**
    * \brief This function will send data to the PVM network from the model
    * \param score is the likelihood score obtained from the current run, to be sent to the PVM master
+   * \param likes is the DoubleVector of the unweighted likelihood scores from each likelihood component, to be sent to the PVM master
    */
-  void sendDataToNetwork(double score);
+  void sendDataToNetwork(double score, const DoubleVector& likes);
   /**
    * \brief This function will read updated data that is sent to the model from the PVM network
    */
@@ -6,6 +6,7 @@
 #include "stockptrvector.h"
 #include "conversionindexptrvector.h"
 #include "intmatrix.h"
+#include "lengthgroup.h"
 
 /**
  * \class StockAggregator
@@ -44,6 +45,16 @@ public:
    * \param outfile is the ofstream to the file that the aggregator information gets sent to
    */
   void Print(ofstream &outfile) const;
+  /**
+   * \brief This function will check if the aggregator would aggregate the same stock information as a new aggregator created with the given parameters
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param Lgrpdiv is the LengthGroupDivision that the stocks will be aggregated to
+   * \param Areas is the IntMatrix of areas that the stocks to be aggregated live on
+   * \param Ages is the IntMatrix of ages of the stocks to be aggregated
+   * \return 1 if the aggregated stock information would be the same, 0 otherwise
+   */
+  int isSameAggregation(const StockPtrVector& Stocks, const LengthGroupDivision* const Lgrpdiv,
+    const IntMatrix& Areas, const IntMatrix& Ages) const;
 protected:
   /**
    * \brief This is the StockPtrVector of the stocks that will be aggregated
@@ -69,6 +80,14 @@ protected:
    * \brief This is the AgeBandMatrix used to temporarily store information when aggregating the stocks
    */
   const AgeBandMatrix* alptr;
+  /**
+   * \brief This is the LengthGroupDivision that the stocks will be aggregated to
+   */
+  LengthGroupDivision* LgrpDiv;
+  /**
+   * \brief This is the identifier of the section of the timestep when the stock information was last aggregated
+   */
+  long int section;
 };
 
 #endif
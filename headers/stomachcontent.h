@@ -56,6 +56,11 @@ public:
    * \param Preys is the PreyPtrVector of all the available preys
    */
   virtual void setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys);
+  /**
+   * \brief This function will move the stomach content data into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) { store.storeMatrices(obsConsumption); };
   /**
    * \brief This function will print summary information from each StomachContent likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -85,10 +90,10 @@ protected:
    */
   DoubleMatrixPtrMatrix obsConsumption;
   /**
-   * \brief This is the DoubleMatrixPtrMatrix used to store consumption (stomach content) information calculated in the model
-   * \note The indices for this object are [time][area][predator][prey]
+   * \brief This is the DoubleMatrixPtrVector used to store consumption (stomach content) information calculated in the model on the current timestep
+   * \note The indices for this object are [area][predator][prey]
    */
-  DoubleMatrixPtrMatrix modelConsumption;
+  DoubleMatrixPtrVector modelConsumption;
   /**
    * \brief This is the DoubleMatrix used to store the calculated likelihood information
    * \note The indices for this object are [time][area]
@@ -201,7 +206,15 @@ public:
   /**
    * \brief This is the default SCNumbers destructor
    */
-  virtual ~SCNumbers() {};
+  virtual ~SCNumbers();
+  /**
+   * \brief This function will move the stomach content data, and the data-only part of the multinomial likelihood score, into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    SC::storeObservations(store);
+    store.storeMatrices(obsDataTerm);
+  };
   /**
    * \brief This function will aggregate consumption information for each StomachContent calculation
    * \param i is the index of the prey that is being consumed
@@ -219,10 +232,19 @@ protected:
    * \return likelihood score
    */
   virtual double calcLikelihood();
+  /**
+   * \brief This function will calculate the part of the multinomial likelihood score that only depends on the data read from the input file
+   */
+  void calcDataTerms();
   /**
    * \brief This is the Multinomial that is used when calculating the likelihood score
    */
   Multinomial MN;
+  /**
+   * \brief This is the DoubleMatrixPtrVector used to store the part of the multinomial likelihood score that only depends on the data read from the input file
+   * \note The indices for this object are [time][area][prey]
+   */
+  DoubleMatrixPtrVector obsDataTerm;
   /**
    * \brief This is the DoubleVector used to temporarily store the observed consumption when calculating the likelihood score
    */
@@ -256,6 +278,15 @@ public:
    * \brief This is the default SCAmounts destructor
    */
   virtual ~SCAmounts();
+  /**
+   * \brief This function will move the stomach content data, and the standard deviations and number of samples, into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) {
+    SC::storeObservations(store);
+    store.storeMatrices(stddev);
+    store.storeMatrices(number);
+  };
   /**
    * \brief This function will print information from each SCAmounts calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -411,6 +442,12 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   * \note The scnumbers function can give negative scores
+   */
+  virtual int isCumulative() const;
   /**
    * \brief This will select the predators and preys required to calculate the StomachContent likelihood score
    * \param Predators is the PredatorPtrVector of all the available predators
@@ -418,6 +455,11 @@ public:
    */
   void setPredatorsAndPreys(PredatorPtrVector& Predators, PreyPtrVector& Preys)
     { StomCont->setPredatorsAndPreys(Predators, Preys); };
+  /**
+   * \brief This function will move the observation data for the StomachContent likelihood score into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  void storeObservations(ObservationStore& store) { StomCont->storeObservations(store); };
   /**
    * \brief This function will print summary information from each StomachContent likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
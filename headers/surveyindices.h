@@ -41,6 +41,11 @@ public:
    * \param Stocks is the StockPtrVector of all the available stocks
    */
   void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  /**
+   * \brief This function will move the observation data for the SurveyIndices likelihood score into an ObservationStore
+   * \param store is the ObservationStore that will hold the observation data
+   */
+  virtual void storeObservations(ObservationStore& store) { SI->storeObservations(store); };
   /**
    * \brief This function will reset the SurveyIndices likelihood information
    * \param keeper is the Keeper for the current model
@@ -51,6 +56,11 @@ public:
    * \param outfile is the ofstream that all the model information gets sent to
    */
   virtual void Print(ofstream& outfile) const;
+  /**
+   * \brief This will check whether the likelihood score for the likelihood component can only increase as the model is simulated
+   * \return 1 if the likelihood score is a sum of non-negative terms, 0 otherwise
+   */
+  virtual int isCumulative() const { return 1; };
   /**
    * \brief This function will print information from each SurveyIndices calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
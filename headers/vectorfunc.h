@@ -0,0 +1,36 @@
+#ifndef vectorfunc_h
+#define vectorfunc_h
+
+#include "doublevector.h"
+#include "gadget.h"
+
+/* JMB these functions raise every element of a vector to a power, using   */
+/* a plain loop that calls pow for each element.  pow is used rather than  */
+/* exp(power * log(x)) so that the results are the same as calling pow for */
+/* each element where the powers are needed                                */
+
+/**
+ * \brief This function will raise each element of a vector to a power
+ * \param result is the DoubleVector that will contain the values raised to the power
+ * \param x is the DoubleVector of values
+ * \param power is the power
+ * \note result needs to have at least as many elements as x
+ */
+inline void powVector(DoubleVector& result, const DoubleVector& x, double power) {
+  int i;
+  for (i = 0; i < x.Size(); i++)
+    result[i] = pow(x[i], power);
+}
+
+/**
+ * \brief This function will raise each element of a vector to a power
+ * \param x is the DoubleVector of values, which will be replaced by the values raised to the power
+ * \param power is the power
+ */
+inline void powVector(DoubleVector& x, double power) {
+  int i;
+  for (i = 0; i < x.Size(); i++)
+    x[i] = pow(x[i], power);
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef workerpool_h
+#define workerpool_h
+
+#include "doublematrix.h"
+#include "gadget.h"
+
+/**
+ * \class WorkerPool
+ * \brief This is the base class used to calculate the likelihood score for several points in parallel during an optimising run
+ *
+ * This class is used to distribute a batch of points from the optimisation algorithm to a number of worker processes, which each run the model for the parameter values at one point and then return the likelihood score from that model run.  The points are sent to the workers as the unscaled values for all the parameters, and the result returned for each point is the overall likelihood score followed by the unweighted likelihood score for each likelihood component, so that the process controlling the optimisation can write the -o output for each model run.
+ * \note This will always be overridden by the derived classes that actually communicate with the worker processes
+ */
+class WorkerPool {
+public:
+  /**
+   * \brief This is the WorkerPool constructor
+   * \param workers is the number of worker processes
+   * \param nvar is the number of parameters sent to the worker processes for each point
+   * \param nlike is the number of likelihood components returned from the worker processes for each point
+   */
+  WorkerPool(int workers, int nvar, int nlike) : numworkers(workers), numvar(nvar), numlike(nlike) {};
+  /**
+   * \brief This is the default WorkerPool destructor
+   */
+  virtual ~WorkerPool() {};
+  /**
+   * \brief This function will calculate the likelihood score for a batch of points using the worker processes
+   * \param points is the DoubleMatrix of the points, with each row containing the unscaled values for all the parameters
+   * \param results is the DoubleMatrix that will contain the results, with each row containing the overall likelihood score followed by the unweighted likelihood score for each likelihood component
+   */
+  virtual void evaluatePoints(const DoubleMatrix& points, DoubleMatrix& results) = 0;
+  /**
+   * \brief This function will return the number of worker processes
+   * \return number of worker processes
+   */
+  int numWorkers() const { return numworkers; };
+protected:
+  /**
+   * \brief This is the number of worker processes
+   */
+  int numworkers;
+  /**
+   * \brief This is the number of parameters sent to the worker processes for each point
+   */
+  int numvar;
+  /**
+   * \brief This is the number of likelihood components returned from the worker processes for each point
+   */
+  int numlike;
+};
+
+#endif
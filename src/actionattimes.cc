@@ -76,6 +76,7 @@ int ActionAtTimes::readFromFile(CommentStream& infile, const TimeClass* const Ti
 
   if (!infile.eof())
     infile.seekg(pos);
+  this->compileSchedule(TimeInfo);
   return 1;
 }
 
@@ -84,12 +85,20 @@ void ActionAtTimes::addActions(const IntVector& years,
 
   if (years.Size() != steps.Size())
     handle.logMessage(LOGFAIL, "Error in actionattimes - different number of years and steps");
+
+  int i;
+  if (timeIndex.Size() == 0)
+    timeIndex.resize(TimeInfo->numTotalSteps() + 1, -1);
+  for (i = 0; i < years.Size(); i++)
+    if (TimeInfo->isWithinPeriod(years[i], steps[i]))
+      timeIndex[TimeInfo->calcSteps(years[i], steps[i])] = i;
+
   if (everyStep)
     return;
-  int i;
   for (i = 0; i < years.Size(); i++)
     if (TimeInfo->isWithinPeriod(years[i], steps[i]))
       TimeSteps.resize(1, TimeInfo->calcSteps(years[i], steps[i]));
+  this->compileSchedule(TimeInfo);
 }
 
 void ActionAtTimes::addActionsAllYears(const IntVector& steps, const TimeClass* const TimeInfo) {
@@ -101,6 +110,7 @@ void ActionAtTimes::addActionsAllYears(const IntVector& steps, const TimeClass*
     if ((TimeInfo->getLastYear() != TimeInfo->getFirstYear()) ||
         (TimeInfo->getFirstStep() <= steps[i] && steps[i] <= TimeInfo->getLastStep()))
       Steps.resize(1, steps[i]);
+  this->compileSchedule(TimeInfo);
 }
 
 void ActionAtTimes::addActionsAllSteps(const IntVector& years, const TimeClass* const TimeInfo) {
@@ -111,14 +121,57 @@ void ActionAtTimes::addActionsAllSteps(const IntVector& years, const TimeClass*
   for (i = 0; i < years.Size(); i++)
     if (TimeInfo->getFirstYear() <= years[i] && years[i] <= TimeInfo->getLastYear())
       Years.resize(1, years[i]);
+  this->compileSchedule(TimeInfo);
+}
+
+void ActionAtTimes::compileSchedule(const TimeClass* const TimeInfo) {
+  int i, time, year, step;
+
+  //JMB store a flag for every timestep so that the lists dont need to be searched during the simulation
+  activeTime.Reset();
+  activeTime.resize(TimeInfo->numTotalSteps() + 1, 0);
+  year = TimeInfo->getFirstYear();
+  step = TimeInfo->getFirstStep();
+  for (time = 1; time < activeTime.Size(); time++) {
+    if (everyStep)
+      activeTime[time] = 1;
+    for (i = 0; i < Steps.Size(); i++)
+      if (Steps[i] == step)
+        activeTime[time] = 1;
+    for (i = 0; i < Years.Size(); i++)
+      if (Years[i] == year)
+        activeTime[time] = 1;
+    for (i = 0; i < TimeSteps.Size(); i++)
+      if (TimeSteps[i] == time)
+        activeTime[time] = 1;
+
+    if (step == TimeInfo->numSteps()) {
+      step = 1;
+      year++;
+    } else
+      step++;
+  }
+}
+
+int ActionAtTimes::atTime(int time) const {
+  if ((time > 0) && (time < activeTime.Size()))
+    return activeTime[time];
+  return 0;
+}
+
+int ActionAtTimes::getTimeIndex(const TimeClass* const TimeInfo) const {
+  int time = TimeInfo->getTime();
+  if ((time > 0) && (time < timeIndex.Size()))
+    return timeIndex[time];
+  return -1;
 }
 
-/* This function could be better implemented -- e.g. sort the vectors
- * TimeSteps, Years and Steps and use that to increase speed. That
- * could be done by insisting that TimeInfo's time is not decreasing
- * between calls, so that we can keep three indices, one for each
- * vector, telling us where we quit our search in the last call */
 int ActionAtTimes::atCurrentTime(const TimeClass* const TimeInfo) const {
+  int time = TimeInfo->getTime();
+  if ((time > 0) && (time < activeTime.Size()))
+    return activeTime[time];
+
+  //JMB outside the model timesteps, so search the lists of actions
   if (everyStep)
     return 1;
   int i;
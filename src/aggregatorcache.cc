@@ -0,0 +1,113 @@
+#include "aggregatorcache.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+AggregatorCache aggcache;
+
+AggregatorCache::AggregatorCache() {
+  fleetaggs = 0;
+  stockaggs = 0;
+  section = 0;
+  lastsection = 0;
+}
+
+AggregatorCache::~AggregatorCache() {
+  int i;
+  for (i = 0; i < fleetusers.Size(); i++)
+    if (fleetaggs[i] != 0)
+      delete fleetaggs[i];
+  for (i = 0; i < stockusers.Size(); i++)
+    if (stockaggs[i] != 0)
+      delete stockaggs[i];
+  if (fleetaggs != 0)
+    delete[] fleetaggs;
+  if (stockaggs != 0)
+    delete[] stockaggs;
+}
+
+FleetPreyAggregator* AggregatorCache::getFleetPreyAggregator(const FleetPtrVector& Fleets,
+  const StockPtrVector& Stocks, LengthGroupDivision* const Lgrpdiv,
+  const IntMatrix& Areas, const IntMatrix& Ages, int overcons) {
+
+  int i;
+  for (i = 0; i < fleetusers.Size(); i++) {
+    if ((fleetaggs[i] != 0) && (fleetaggs[i]->isSameAggregation(Fleets, Stocks, Lgrpdiv, Areas, Ages, overcons))) {
+      fleetusers[i]++;
+      return fleetaggs[i];
+    }
+  }
+
+  FleetPreyAggregator** tmpaggs = new FleetPreyAggregator*[fleetusers.Size() + 1];
+  for (i = 0; i < fleetusers.Size(); i++)
+    tmpaggs[i] = fleetaggs[i];
+  tmpaggs[fleetusers.Size()] = new FleetPreyAggregator(Fleets, Stocks, Lgrpdiv, Areas, Ages, overcons);
+  if (fleetaggs != 0)
+    delete[] fleetaggs;
+  fleetaggs = tmpaggs;
+  fleetusers.resize(1, 1);
+  return fleetaggs[fleetusers.Size() - 1];
+}
+
+StockAggregator* AggregatorCache::getStockAggregator(const StockPtrVector& Stocks,
+  const LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas, const IntMatrix& Ages) {
+
+  int i;
+  for (i = 0; i < stockusers.Size(); i++) {
+    if ((stockaggs[i] != 0) && (stockaggs[i]->isSameAggregation(Stocks, Lgrpdiv, Areas, Ages))) {
+      stockusers[i]++;
+      return stockaggs[i];
+    }
+  }
+
+  StockAggregator** tmpaggs = new StockAggregator*[stockusers.Size() + 1];
+  for (i = 0; i < stockusers.Size(); i++)
+    tmpaggs[i] = stockaggs[i];
+  tmpaggs[stockusers.Size()] = new StockAggregator(Stocks, Lgrpdiv, Areas, Ages);
+  if (stockaggs != 0)
+    delete[] stockaggs;
+  stockaggs = tmpaggs;
+  stockusers.resize(1, 1);
+  return stockaggs[stockusers.Size() - 1];
+}
+
+void AggregatorCache::deleteAggregator(FleetPreyAggregator* aggregator) {
+  int i;
+  for (i = 0; i < fleetusers.Size(); i++) {
+    if (fleetaggs[i] == aggregator) {
+      fleetusers[i]--;
+      if (fleetusers[i] == 0) {
+        delete fleetaggs[i];
+        fleetaggs[i] = 0;
+      }
+      return;
+    }
+  }
+  handle.logMessage(LOGWARN, "Warning in aggregatorcache - failed to find aggregator to delete");
+}
+
+void AggregatorCache::deleteAggregator(StockAggregator* aggregator) {
+  int i;
+  for (i = 0; i < stockusers.Size(); i++) {
+    if (stockaggs[i] == aggregator) {
+      stockusers[i]--;
+      if (stockusers[i] == 0) {
+        delete stockaggs[i];
+        stockaggs[i] = 0;
+      }
+      return;
+    }
+  }
+  handle.logMessage(LOGWARN, "Warning in aggregatorcache - failed to find aggregator to delete");
+}
+
+int AggregatorCache::numShared() const {
+  int i, count = 0;
+  for (i = 0; i < fleetusers.Size(); i++)
+    if (fleetusers[i] > 1)
+      count++;
+  for (i = 0; i < stockusers.Size(); i++)
+    if (stockusers[i] > 1)
+      count++;
+  return count;
+}
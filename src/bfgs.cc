@@ -82,32 +82,38 @@ double OptInfoBFGS::getSmallestEigenValue(DoubleMatrix M) {
 /* based on the forward difference gradient approximation (A5.6.3 FDGRAD)   */
 /* Numerical Methods for Unconstrained Optimization and Nonlinear Equations */
 /* by J E Dennis and Robert B Schnabel, published by SIAM, 1996             */
+/* JMB there is no exact gradient, since the simulation isnt written for    */
+/* automatic differentiation, so this needs one simulation per parameter    */
 void OptInfoBFGS::gradient(DoubleVector& point, double pointvalue, DoubleVector& newgrad) {
 
-  double ftmp, tmpacc;
   int i, j;
   int nvars = point.Size();
-  DoubleVector gtmp(point);
+  DoubleVector tmpacc(nvars, 0.0);
+  DoubleVector ftmp(nvars, 0.0);
+  DoubleMatrix gtmp(nvars, nvars, 0.0);
 
   for (i = 0; i < nvars; i++) {
     for (j = 0; j < nvars; j++)
-      gtmp[j] = point[j];
+      gtmp[i][j] = point[j];
 
     //JMB the scaled parameter values should aways be positive
     if (point[i] < 0.0)
       handle.logMessage(LOGINFO, "Error in BFGS - negative parameter when calculating the gradient", point[i]);
 
-    tmpacc = gradacc * max(point[i], 1.0);
-    gtmp[i] += tmpacc;
-    ftmp = EcoSystem->SimulateAndUpdate(gtmp);
-    newgrad[i] = (ftmp - pointvalue) / tmpacc;
+    tmpacc[i] = gradacc * max(point[i], 1.0);
+    gtmp[i][i] += tmpacc[i];
   }
+
+  //JMB the points are independent, so they can be calculated in parallel
+  EcoSystem->SimulateAndUpdate(gtmp, ftmp);
+  for (i = 0; i < nvars; i++)
+    newgrad[i] = (ftmp[i] - pointvalue) / tmpacc[i];
 }
 
 void OptInfoBFGS::OptimiseLikelihood() {
 
   double hy, yBy, temphy, tempyby, normgrad;
-  double searchgrad, newf, tmpf, betan;
+  double searchgrad, newf, tmpf, betan, gradaccx;
   int i, j, resetgrad, offset, armijo;
 
   handle.logMessage(LOGINFO, "\nStarting BFGS optimisation algorithm\n");
@@ -142,6 +148,7 @@ void OptInfoBFGS::OptimiseLikelihood() {
   }
 
   this->gradient(trialx, newf, grad);
+  gradaccx = gradacc;
   tmpf = newf;
   offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
   sigma = -sigma; //JMB change sign of sigma (and consequently searchgrad)
@@ -216,7 +223,7 @@ void OptInfoBFGS::OptimiseLikelihood() {
         for (i = 0; i < nvars; i++)
           trialx[i] = x[i] + (betan * search[i]);
 
-        tmpf = EcoSystem->SimulateAndUpdate(trialx);
+        tmpf = EcoSystem->SimulateAndUpdate(trialx, newf);
         if ((newf > tmpf) && ((newf - tmpf) > (betan * searchgrad)))
           armijo = 1;
         else
@@ -226,9 +233,14 @@ void OptInfoBFGS::OptimiseLikelihood() {
 
     if (armijo) {
       this->gradient(trialx, tmpf, grad);
+      gradaccx = gradacc;
     } else {
       resetgrad = 1;
-      this->gradient(x, newf, grad);
+      //JMB grad is already the gradient at x, so only calculate it again if the step size has changed
+      if (!isEqual(gradaccx, gradacc)) {
+        this->gradient(x, newf, grad);
+        gradaccx = gradacc;
+      }
       continue;
     }
 
@@ -0,0 +1,112 @@
+#include "binaryoutput.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+BinaryOutput::BinaryOutput(ofstream& out, int size)
+  : outfile(out), blocksize(size), numrows(0), column(0), headerwritten(0) {
+
+  if ((blocksize < 1) || (blocksize > binaryBlockSize))
+    blocksize = binaryBlockSize;
+}
+
+BinaryOutput::~BinaryOutput() {
+  this->Flush();
+  int i;
+  for (i = 0; i < names.Size(); i++) {
+    delete[] names[i];
+    if (separators[i] != 0)
+      delete[] separators[i];
+  }
+}
+
+void BinaryOutput::addColumn(const char* name, ColumnType ctype, int width, int prec, const CharPtrVector* labelvec) {
+  if ((numrows > 0) || (column > 0))
+    handle.logMessage(LOGFAIL, "Error in binary output - cannot add a column after values have been stored");
+  if ((ctype == LABELCOLUMN) && (labelvec == 0))
+    handle.logMessage(LOGFAIL, "Error in binary output - no labels given for column", name);
+
+  char* colname = new char[strlen(name) + 1];
+  strcpy(colname, name);
+  names.resize(colname);
+  types.resize(1, ctype);
+  widths.resize(1, width);
+  precisions.resize(1, prec);
+  separators.resize((char*)0);
+  labels.push_back(labelvec);
+  buffer.AddRows(1, blocksize, 0.0);
+}
+
+void BinaryOutput::setSeparator(const char* text) {
+  if ((numrows > 0) || (column > 0) || (headerwritten) || (names.Size() == 0))
+    handle.logMessage(LOGFAIL, "Error in binary output - cannot set the separator after values have been stored");
+
+  int i = names.Size() - 1;
+  if (separators[i] != 0)
+    delete[] separators[i];
+  separators[i] = new char[strlen(text) + 1];
+  strcpy(separators[i], text);
+}
+
+void BinaryOutput::storeValue(double value) {
+  buffer[column][numrows] = value;
+  column++;
+  if (column == names.Size()) {
+    column = 0;
+    numrows++;
+    if (numrows == blocksize)
+      this->Flush();
+  }
+}
+
+void BinaryOutput::writeString(const char* text) {
+  int len = strlen(text);
+  this->writeInt(len);
+  outfile.write(text, len);
+}
+
+void BinaryOutput::writeHeader() {
+  int i, j;
+  outfile.write(binaryMagic, strlen(binaryMagic));
+  this->writeInt(binaryVersion);
+  this->writeInt(binaryByteOrder);
+  this->writeInt(names.Size());
+  for (i = 0; i < names.Size(); i++) {
+    this->writeInt(types[i]);
+    this->writeInt(widths[i]);
+    this->writeInt(precisions[i]);
+    this->writeString(names[i]);
+    this->writeString(separators[i] == 0 ? "" : separators[i]);
+    if (types[i] == LABELCOLUMN) {
+      this->writeInt(labels[i]->Size());
+      for (j = 0; j < labels[i]->Size(); j++)
+        this->writeString((*labels[i])[j]);
+    }
+  }
+  headerwritten = 1;
+}
+
+void BinaryOutput::Flush() {
+  if (!headerwritten)
+    this->writeHeader();
+  if (numrows == 0)
+    return;
+
+  int i, j;
+  if (intbuffer.Size() == 0)
+    intbuffer.resize(blocksize, 0);
+
+  //JMB each block is written as the number of rows and then each column in turn
+  this->writeInt(numrows);
+  for (i = 0; i < names.Size(); i++) {
+    if (types[i] == DOUBLECOLUMN) {
+      outfile.write((const char*)&buffer[i][0], numrows * sizeof(double));
+    } else {
+      for (j = 0; j < numrows; j++)
+        intbuffer[j] = (int)buffer[i][j];
+      outfile.write((const char*)&intbuffer[0], numrows * sizeof(int));
+    }
+  }
+  outfile.flush();
+  numrows = 0;
+}
@@ -0,0 +1,163 @@
+#include "binaryoutput.h"
+#include "gadget.h"
+
+/* JMB this is a standalone program to convert the binary output files  */
+/* written by the printer classes back to the standard text format, so */
+/* it doesnt link to the rest of the gadget object files                */
+
+static int readInt(ifstream& infile) {
+  int value = 0;
+  infile.read((char*)&value, sizeof(int));
+  return value;
+}
+
+static char* readString(ifstream& infile) {
+  int len = readInt(infile);
+  char* text = new char[len + 1];
+  infile.read(text, len);
+  text[len] = '\0';
+  return text;
+}
+
+static void failConversion(const char* filename, const char* msg) {
+  cerr << "Error in bintotext - " << msg << " in file " << filename << endl;
+  exit(EXIT_FAILURE);
+}
+
+int main(int aNumber, char* const aVector[]) {
+
+  if ((aNumber != 2) && (aNumber != 3)) {
+    cerr << "Usage: bintotext <binary print file> [<text print file>]\n"
+      << "Converts the binary output from a Gadget printer class back to text\n";
+    return EXIT_FAILURE;
+  }
+
+  ifstream infile;
+  infile.open(aVector[1], ios::in | ios::binary);
+  if (infile.fail())
+    failConversion(aVector[1], "failed to open binary output");
+
+  ofstream textfile;
+  if (aNumber == 3) {
+    textfile.open(aVector[2], ios::out);
+    if (textfile.fail())
+      failConversion(aVector[2], "failed to open text output");
+  }
+  ostream& outfile = (aNumber == 3 ? textfile : cout);
+
+  //copy the text lines from the start of the file, up to the binary header
+  int i, j, k;
+  int len = strlen(binaryMagic);
+  char magic[MaxStrLength];
+  char line[LongString];
+  streampos pos;
+  while (!infile.eof()) {
+    pos = infile.tellg();
+    strncpy(magic, "", MaxStrLength);
+    infile.read(magic, len);
+    if ((!infile.fail()) && (strncmp(magic, binaryMagic, len) == 0))
+      break;
+
+    infile.clear();
+    infile.seekg(pos);
+    infile.getline(line, LongString);
+    if ((infile.eof()) || (infile.fail()))
+      failConversion(aVector[1], "missing binary header");
+    outfile << line << endl;
+  }
+  //JMB version 1 files dont contain the separators, so use the default separators
+  int version = readInt(infile);
+  if ((version < 1) || (version > binaryVersion))
+    failConversion(aVector[1], "unsupported binary version");
+  if (readInt(infile) != binaryByteOrder)
+    failConversion(aVector[1], "binary file written with different byte order");
+
+  int ncols = readInt(infile);
+  if ((ncols <= 0) || (infile.fail()))
+    failConversion(aVector[1], "invalid number of columns");
+
+  IntVector types(ncols, 0);
+  IntVector widths(ncols, 0);
+  IntVector precisions(ncols, 0);
+  CharPtrVector separators;
+  vector<CharPtrVector*> labels(ncols, (CharPtrVector*)0);
+  for (i = 0; i < ncols; i++) {
+    types[i] = readInt(infile);
+    widths[i] = readInt(infile);
+    precisions[i] = readInt(infile);
+    delete[] readString(infile);  //column name is not needed for the text output
+    separators.resize((char*)0);
+    if (version > 1)
+      separators[i] = readString(infile);
+    if ((separators[i] != 0) && (strlen(separators[i]) == 0)) {
+      delete[] separators[i];
+      separators[i] = 0;
+    }
+    if (types[i] == LABELCOLUMN) {
+      labels[i] = new CharPtrVector;
+      k = readInt(infile);
+      for (j = 0; j < k; j++)
+        labels[i]->resize(readString(infile));
+    }
+  }
+
+  int nrows;
+  DoubleMatrix values;
+  IntVector intvalues;
+  while (!infile.fail()) {
+    nrows = readInt(infile);
+    if (infile.eof())
+      break;
+    if ((nrows <= 0) || (nrows > binaryBlockSize) || (infile.fail()))
+      failConversion(aVector[1], "invalid number of rows in block");
+
+    if (values.Nrow() == 0) {
+      values.AddRows(ncols, binaryBlockSize, 0.0);
+      intvalues.resize(binaryBlockSize, 0);
+    }
+
+    for (i = 0; i < ncols; i++) {
+      if (types[i] == DOUBLECOLUMN) {
+        infile.read((char*)&values[i][0], nrows * sizeof(double));
+      } else {
+        infile.read((char*)&intvalues[0], nrows * sizeof(int));
+        for (j = 0; j < nrows; j++)
+          values[i][j] = intvalues[j];
+      }
+    }
+    if (infile.fail())
+      failConversion(aVector[1], "unexpected end of file");
+
+    for (j = 0; j < nrows; j++) {
+      for (i = 0; i < ncols; i++) {
+        if (types[i] == DOUBLECOLUMN)
+          outfile << setprecision(precisions[i]) << setw(widths[i]) << values[i][j];
+        else if (types[i] == LABELCOLUMN)
+          outfile << setw(widths[i]) << (*labels[i])[(int)values[i][j]];
+        else
+          outfile << setw(widths[i]) << (int)values[i][j];
+
+        if (separators[i] != 0)
+          outfile << separators[i];
+        else if (i == ncols - 1)
+          outfile << '\n';
+        else
+          outfile << sep;
+      }
+    }
+  }
+
+  for (i = 0; i < ncols; i++) {
+    if (separators[i] != 0)
+      delete[] separators[i];
+    if (labels[i] != 0) {
+      for (j = 0; j < labels[i]->Size(); j++)
+        delete[] (*labels[i])[j];
+      delete labels[i];
+    }
+  }
+  infile.close();
+  if (aNumber == 3)
+    textfile.close();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,516 @@
+#include "errorhandler.h"
+#include "optinfo.h"
+#include "mathfunc.h"
+#include "doublematrix.h"
+#include "intvector.h"
+#include "ecosystem.h"
+#include "gadget.h"
+#include "global.h"
+
+/* JMB this is a simplified version of the BOBYQA algorithm that calculates  */
+/* the quadratic model directly from the interpolation points, rather than   */
+/* updating the inverse of the interpolation matrix for each iteration.  The */
+/* interpolation points are stored relative to the best point, and scaled by */
+/* the radius of the trust region, to keep the interpolation matrix stable   */
+
+extern Ecosystem* EcoSystem;
+
+/* calculate the inverse of a matrix using Gauss-Jordan elimination with */
+/* partial pivoting, since the interpolation matrix is not positive definite */
+int OptInfoBOBYQA::calcInverse(DoubleMatrix& A) {
+
+  int i, j, k, piv;
+  double tmp;
+  int size = A.Nrow();
+  DoubleMatrix inv(size, size, 0.0);
+
+  for (i = 0; i < size; i++)
+    inv[i][i] = 1.0;
+
+  for (k = 0; k < size; k++) {
+    piv = k;
+    for (i = k + 1; i < size; i++)
+      if (fabs(A[i][k]) > fabs(A[piv][k]))
+        piv = i;
+    if (isZero(A[piv][k]))
+      return 0;
+
+    if (piv != k) {
+      for (j = 0; j < size; j++) {
+        tmp = A[k][j];
+        A[k][j] = A[piv][j];
+        A[piv][j] = tmp;
+        tmp = inv[k][j];
+        inv[k][j] = inv[piv][j];
+        inv[piv][j] = tmp;
+      }
+    }
+
+    tmp = 1.0 / A[k][k];
+    for (j = 0; j < size; j++) {
+      A[k][j] *= tmp;
+      inv[k][j] *= tmp;
+    }
+
+    for (i = 0; i < size; i++) {
+      if ((i == k) || (isZero(A[i][k])))
+        continue;
+      tmp = A[i][k];
+      for (j = 0; j < size; j++) {
+        A[i][j] -= tmp * A[k][j];
+        inv[i][j] -= tmp * inv[k][j];
+      }
+    }
+  }
+
+  for (i = 0; i < size; i++)
+    for (j = 0; j < size; j++)
+      A[i][j] = inv[i][j];
+  return 1;
+}
+
+/* calculate the step that minimises the quadratic model within the trust  */
+/* region using the truncated conjugate gradient method, given by Jorge    */
+/* Nocedal and Stephen J Wright, ''Numerical Optimization'' (algorithm 7.2) */
+/* published by Springer, fixing each parameter when it reaches a bound    */
+void OptInfoBOBYQA::calcStep(const DoubleVector& point, const DoubleVector& grad, const DoubleMatrix& hess,
+  const DoubleVector& lowerb, const DoubleVector& upperb, double delta, DoubleVector& step) {
+
+  int i, j, iter, hit, ibound, restart;
+  double alpha, tmp, gg, ggold, dhd, ss, sd, dd;
+  int nvars = point.Size();
+  DoubleVector gs(grad);
+  DoubleVector d(nvars, 0.0);
+  DoubleVector hd(nvars, 0.0);
+  IntVector isfree(nvars, 1);
+
+  for (i = 0; i < nvars; i++) {
+    step[i] = 0.0;
+    if ((point[i] < lowerb[i] || isEqual(point[i], lowerb[i])) && (grad[i] > 0.0))
+      isfree[i] = 0;
+    if ((point[i] > upperb[i] || isEqual(point[i], upperb[i])) && (grad[i] < 0.0))
+      isfree[i] = 0;
+  }
+
+  gg = 0.0;
+  ibound = 0;
+  restart = 1;
+  for (iter = 0; iter < 10 * (nvars + 1); iter++) {
+    //JMB restart with the steepest descent direction when a parameter has been fixed
+    if (restart) {
+      gg = 0.0;
+      for (i = 0; i < nvars; i++) {
+        d[i] = (isfree[i] ? 0.0 - gs[i] : 0.0);
+        gg += d[i] * d[i];
+      }
+      restart = 0;
+    }
+    if (isZero(gg))
+      break;
+
+    dhd = ss = sd = dd = tmp = 0.0;
+    for (i = 0; i < nvars; i++) {
+      hd[i] = 0.0;
+      for (j = 0; j < nvars; j++)
+        hd[i] += hess[i][j] * d[j];
+      dhd += d[i] * hd[i];
+      ss += step[i] * step[i];
+      sd += step[i] * d[i];
+      dd += d[i] * d[i];
+      tmp -= gs[i] * d[i];
+    }
+
+    // find the first of the trust region boundary, the minimum along d or a bound
+    hit = 1;
+    alpha = (sqrt(max(0.0, sd * sd + dd * (delta * delta - ss))) - sd) / dd;
+    if ((dhd > 0.0) && ((tmp / dhd) < alpha)) {
+      alpha = tmp / dhd;
+      hit = 0;
+    }
+    for (i = 0; i < nvars; i++) {
+      if ((!isfree[i]) || (isZero(d[i])))
+        continue;
+      tmp = ((d[i] > 0.0 ? upperb[i] : lowerb[i]) - point[i] - step[i]) / d[i];
+      if (tmp < alpha) {
+        alpha = tmp;
+        hit = 2;
+        ibound = i;
+      }
+    }
+    alpha = max(alpha, 0.0);
+
+    for (i = 0; i < nvars; i++) {
+      step[i] += alpha * d[i];
+      gs[i] += alpha * hd[i];
+    }
+
+    if (hit == 1)
+      break;
+
+    if (hit == 2) {
+      step[ibound] = (d[ibound] > 0.0 ? upperb[ibound] : lowerb[ibound]) - point[ibound];
+      isfree[ibound] = 0;
+      restart = 1;
+      continue;
+    }
+
+    ggold = gg;
+    gg = 0.0;
+    for (i = 0; i < nvars; i++)
+      if (isfree[i])
+        gg += gs[i] * gs[i];
+    for (i = 0; i < nvars; i++)
+      d[i] = (isfree[i] ? (gg / ggold) * d[i] - gs[i] : 0.0);
+  }
+}
+
+void OptInfoBOBYQA::OptimiseLikelihood() {
+
+  double tmp, rho, rhoold, delta, fopt, newf, pred, ratio, snorm, dist, best;
+  int i, j, k, offset, npt, size, kopt, knew, kfar;
+  int nvars = EcoSystem->numOptVariables();
+
+  handle.logMessage(LOGINFO, "\nStarting BOBYQA optimisation algorithm\n");
+  npt = 2 * nvars + 1;
+  size = npt + nvars + 1;
+  DoubleVector x(nvars);
+  DoubleVector trialx(nvars);
+  DoubleVector init(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector grad(nvars, 0.0);
+  DoubleVector step(nvars, 0.0);
+  DoubleVector fval(npt, 0.0);
+  DoubleVector lag(npt, 0.0);
+  DoubleVector initf(npt - 1, 0.0);
+  DoubleVector rhs(size, 0.0);
+  DoubleVector coef(size, 0.0);
+  DoubleMatrix xpt(npt, nvars, 0.0);
+  DoubleMatrix ypt(npt, nvars, 0.0);
+  DoubleMatrix initx(npt - 1, nvars, 0.0);
+  DoubleMatrix hess(nvars, nvars, 0.0);
+  DoubleMatrix W(size, size, 0.0);
+
+  EcoSystem->scaleVariables();  //JMB need to scale variables
+  EcoSystem->getOptScaledValues(x);
+  EcoSystem->getOptInitialValues(init);
+  EcoSystem->getOptLowerBounds(lowerb);
+  EcoSystem->getOptUpperBounds(upperb);
+
+  rho = rhobeg;
+  for (i = 0; i < nvars; i++) {
+    // Scaling the bounds, because the parameters are scaled
+    lowerb[i] = lowerb[i] / init[i];
+    upperb[i] = upperb[i] / init[i];
+    if (lowerb[i] > upperb[i]) {
+      tmp = lowerb[i];
+      lowerb[i] = upperb[i];
+      upperb[i] = tmp;
+    }
+
+    //JMB make sure that the starting point is within the bounds
+    if (x[i] < lowerb[i])
+      x[i] = lowerb[i];
+    else if (x[i] > upperb[i])
+      x[i] = upperb[i];
+
+    //JMB the initial interpolation points need to fit between the bounds
+    rho = min(rho, (upperb[i] - lowerb[i]) / 3.0);
+  }
+
+  if (rho < verysmall) {
+    handle.logMessage(LOGINFO, "Error starting BOBYQA optimisation with the bounds for a parameter equal");
+    converge = -1;
+    iters = 1;
+    return;
+  }
+
+  fopt = EcoSystem->SimulateAndUpdate(x);
+  if (fopt != fopt) { // check for NaN
+    handle.logMessage(LOGINFO, "Error starting BOBYQA optimisation with f(x) = infinity");
+    converge = -1;
+    iters = 1;
+    return;
+  }
+
+  // the initial interpolation points move each parameter in turn, away from the bounds
+  offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
+  for (i = 0; i < nvars; i++) {
+    xpt[0][i] = x[i];
+    for (j = 0; j < nvars; j++)
+      initx[2 * i][j] = initx[2 * i + 1][j] = x[j];
+
+    if ((x[i] + rho) > upperb[i]) {
+      initx[2 * i][i] -= rho;
+      initx[2 * i + 1][i] -= 2.0 * rho;
+    } else if ((x[i] - rho) < lowerb[i]) {
+      initx[2 * i][i] += rho;
+      initx[2 * i + 1][i] += 2.0 * rho;
+    } else {
+      initx[2 * i][i] += rho;
+      initx[2 * i + 1][i] -= rho;
+    }
+  }
+
+  //JMB the interpolation points are independent, so they can be calculated in parallel
+  EcoSystem->SimulateAndUpdate(initx, initf);
+  fval[0] = fopt;
+  kopt = 0;
+  for (k = 1; k < npt; k++) {
+    for (i = 0; i < nvars; i++)
+      xpt[k][i] = initx[k - 1][i];
+    fval[k] = (initf[k - 1] != initf[k - 1] ? verybig : initf[k - 1]);
+    if (fval[k] < fval[kopt])
+      kopt = k;
+  }
+  fopt = fval[kopt];
+
+  delta = rho;
+  kfar = -1;
+  converge = 0;
+  while (1) {
+    // terminate the algorithm if too many function evaluations occur
+    iters = EcoSystem->getFuncEval() - offset;
+    if (iters > bobyqaiter)
+      break;
+
+    // calculate the interpolation matrix, scaled by the lower bound for the trust region radius
+    for (k = 0; k < npt; k++)
+      for (i = 0; i < nvars; i++)
+        ypt[k][i] = (xpt[k][i] - xpt[kopt][i]) / rho;
+
+    for (j = 0; j < size; j++)
+      for (k = 0; k < size; k++)
+        W[j][k] = 0.0;
+    for (j = 0; j < npt; j++) {
+      for (k = 0; k <= j; k++) {
+        tmp = 0.0;
+        for (i = 0; i < nvars; i++)
+          tmp += ypt[j][i] * ypt[k][i];
+        W[j][k] = W[k][j] = 0.5 * tmp * tmp;
+      }
+      W[j][npt] = W[npt][j] = 1.0;
+      for (i = 0; i < nvars; i++)
+        W[j][npt + 1 + i] = W[npt + 1 + i][j] = ypt[j][i];
+    }
+
+    if (!(this->calcInverse(W))) {
+      handle.logMessage(LOGINFO, "Error in BOBYQA optimisation after", iters, "function evaluations, interpolation points are degenerate");
+      converge = -1;
+      break;
+    }
+
+    //JMB the new quadratic model interpolates all the points, with the smallest change to the second derivatives
+    for (j = 0; j < size; j++)
+      rhs[j] = 0.0;
+    for (j = 0; j < npt; j++) {
+      tmp = 0.0;
+      for (i = 0; i < nvars; i++)
+        for (k = 0; k < nvars; k++)
+          tmp += ypt[j][i] * hess[i][k] * ypt[j][k];
+      rhs[j] = fval[j] - fopt - 0.5 * rho * rho * tmp;
+    }
+    for (j = 0; j < size; j++) {
+      coef[j] = 0.0;
+      for (k = 0; k < npt; k++)
+        coef[j] += W[j][k] * rhs[k];
+    }
+    for (i = 0; i < nvars; i++) {
+      grad[i] = coef[npt + 1 + i] / rho;
+      for (k = 0; k < nvars; k++) {
+        tmp = 0.0;
+        for (j = 0; j < npt; j++)
+          tmp += coef[j] * ypt[j][i] * ypt[j][k];
+        hess[i][k] += tmp / (rho * rho);
+      }
+    }
+
+    if (kfar >= 0) {
+      //JMB move the interpolation point that is furthest away to improve the interpolation matrix
+      dist = 0.0;
+      for (i = 0; i < nvars; i++)
+        dist += ypt[kfar][i] * ypt[kfar][i];
+      dist = sqrt(dist);
+
+      best = -1.0;
+      for (j = -1; j < 2; j += 2) {
+        for (i = 0; i < nvars; i++) {
+          trialx[i] = xpt[kopt][i] + j * delta * ypt[kfar][i] / dist;
+          if (trialx[i] < lowerb[i])
+            trialx[i] = lowerb[i];
+          else if (trialx[i] > upperb[i])
+            trialx[i] = upperb[i];
+          step[i] = (trialx[i] - xpt[kopt][i]) / rho;
+        }
+
+        // calculate the value of the Lagrange function for this point at the trial point
+        tmp = W[kfar][npt];
+        for (k = 0; k < npt; k++) {
+          ratio = 0.0;
+          for (i = 0; i < nvars; i++)
+            ratio += ypt[k][i] * step[i];
+          tmp += W[kfar][k] * 0.5 * ratio * ratio;
+        }
+        for (i = 0; i < nvars; i++)
+          tmp += W[kfar][npt + 1 + i] * step[i];
+
+        if (fabs(tmp) > best) {
+          best = fabs(tmp);
+          for (i = 0; i < nvars; i++)
+            x[i] = trialx[i];
+        }
+      }
+
+      knew = kfar;
+      kfar = -1;
+      newf = EcoSystem->SimulateAndUpdate(x);
+      ratio = 1.0;
+
+    } else {
+      // minimise the quadratic model within the trust region
+      this->calcStep(xpt[kopt], grad, hess, lowerb, upperb, delta, step);
+      snorm = pred = 0.0;
+      for (i = 0; i < nvars; i++) {
+        snorm += step[i] * step[i];
+        tmp = 0.0;
+        for (k = 0; k < nvars; k++)
+          tmp += hess[i][k] * step[k];
+        pred -= step[i] * (grad[i] + 0.5 * tmp);
+      }
+      snorm = sqrt(snorm);
+
+      if ((snorm < 0.5 * rho) || (pred < verysmall)) {
+        //JMB the step is too short to be useful, so reduce the trust region radius
+        delta = 0.5 * delta;
+        if (delta < 1.5 * rho)
+          delta = rho;
+        knew = -1;
+        ratio = -1.0;
+
+      } else {
+        for (i = 0; i < nvars; i++) {
+          x[i] = xpt[kopt][i] + step[i];
+          if (x[i] < lowerb[i])
+            x[i] = lowerb[i];
+          else if (x[i] > upperb[i])
+            x[i] = upperb[i];
+        }
+
+        newf = EcoSystem->SimulateAndUpdate(x);
+        if (newf != newf)
+          newf = verybig;
+        ratio = (fopt - newf) / pred;
+        if (ratio < 0.1)
+          delta = min(0.5 * delta, snorm);
+        else if (ratio < 0.7)
+          delta = max(0.5 * delta, snorm);
+        else
+          delta = max(0.5 * delta, 2.0 * snorm);
+        if (delta < 1.5 * rho)
+          delta = rho;
+
+        //JMB replace the interpolation point that keeps the interpolation matrix most stable
+        for (j = 0; j < npt; j++) {
+          dist = 0.0;
+          for (i = 0; i < nvars; i++)
+            dist += ypt[j][i] * step[i] / rho;
+          lag[j] = 0.5 * dist * dist;
+        }
+
+        knew = -1;
+        best = 0.0;
+        for (k = 0; k < npt; k++) {
+          if ((k == kopt) && (newf > fopt))
+            continue;
+
+          // calculate the value of the Lagrange function for this point at the new point
+          tmp = W[k][npt];
+          for (j = 0; j < npt; j++)
+            tmp += W[k][j] * lag[j];
+          for (i = 0; i < nvars; i++)
+            tmp += W[k][npt + 1 + i] * step[i] / rho;
+
+          dist = 0.0;
+          for (i = 0; i < nvars; i++)
+            dist += ypt[k][i] * ypt[k][i];
+          dist *= (rho * rho) / (delta * delta);
+          tmp = fabs(tmp) * max(1.0, dist * dist);
+          if (tmp > best) {
+            best = tmp;
+            knew = k;
+          }
+        }
+      }
+    }
+
+    if (knew >= 0) {
+      if (newf != newf)
+        newf = verybig;
+      for (i = 0; i < nvars; i++)
+        xpt[knew][i] = x[i];
+      fval[knew] = newf;
+
+      if (newf < fopt) {
+        fopt = newf;
+        kopt = knew;
+        for (i = 0; i < nvars; i++)
+          trialx[i] = x[i] * init[i];
+
+        iters = EcoSystem->getFuncEval() - offset;
+        EcoSystem->storeVariables(fopt, trialx);
+        handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+        handle.logMessage(LOGINFO, "The likelihood score is", fopt, "at the point");
+        EcoSystem->writeBestValues();
+      }
+    }
+
+    if (ratio >= 0.1)
+      continue;
+
+    //JMB if an interpolation point is too far away then move it before reducing the trust region
+    best = 4.0 * delta * delta;
+    for (k = 0; k < npt; k++) {
+      dist = 0.0;
+      for (i = 0; i < nvars; i++)
+        dist += (xpt[k][i] - xpt[kopt][i]) * (xpt[k][i] - xpt[kopt][i]);
+      if (dist > best) {
+        best = dist;
+        kfar = k;
+      }
+    }
+    if ((kfar >= 0) || (delta > rho))
+      continue;
+
+    // terminate the algorithm if the convergence criteria has been met
+    if (rho < bobyqaeps || isEqual(rho, bobyqaeps)) {
+      converge = 1;
+      break;
+    }
+
+    rhoold = rho;
+    ratio = rho / bobyqaeps;
+    if (ratio < 16.0)
+      rho = bobyqaeps;
+    else if (ratio < 250.0)
+      rho = sqrt(ratio) * bobyqaeps;
+    else
+      rho *= 0.1;
+    delta = max(0.5 * rhoold, rho);
+    iters = EcoSystem->getFuncEval() - offset;
+    handle.logMessage(LOGINFO, "Reducing the BOBYQA trust region radius after", iters, "function evaluations");
+  }
+
+  handle.logMessage(LOGINFO, "\nStopping BOBYQA optimisation algorithm\n");
+  handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+  if (converge == 1)
+    handle.logMessage(LOGINFO, "The optimisation stopped because an optimum was found for this run");
+  else if (converge == 0) {
+    handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+    handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+  }
+
+  for (i = 0; i < nvars; i++)
+    x[i] = xpt[kopt][i];
+  score = EcoSystem->SimulateAndUpdate(x);
+  handle.logMessage(LOGINFO, "\nBOBYQA finished with a likelihood score of", score);
+}
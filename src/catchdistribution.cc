@@ -11,11 +11,12 @@
 #include "stockprey.h"
 #include "ludecomposition.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 CatchDistribution::CatchDistribution(CommentStream& infile, const AreaClass* const Area,
   const TimeClass* const TimeInfo, Keeper* const keeper, double weight, const char* name)
-  : Likelihood(CATCHDISTRIBUTIONLIKELIHOOD, weight, name), alptr(0) {
+  : Likelihood(CATCHDISTRIBUTIONLIKELIHOOD, weight, name), aggregator(0), alptr(0) {
 
   int i, j;
   char text[MaxStrLength];
@@ -222,6 +223,9 @@ CatchDistribution::CatchDistribution(CommentStream& infile, const AreaClass* con
       handle.logMessage(LOGWARN, "Warning in catchdistribution - unrecognised function", functionname);
       break;
   }
+
+  if (functionnumber == 1)
+    this->calcDataTerms(numarea, numage, numlen);
 }
 
 void CatchDistribution::readDistributionData(CommentStream& infile,
@@ -290,12 +294,9 @@ void CatchDistribution::readDistributionData(CommentStream& infile,
         timeid = (Years.Size() - 1);
 
         obsDistribution.resize();
-        modelDistribution.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-          modelDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-        }
       }
 
     } else
@@ -309,6 +310,10 @@ void CatchDistribution::readDistributionData(CommentStream& infile,
       reject++;  //count number of rejected data points read from file
   }
 
+  //JMB the model distribution is only needed for the current timestep
+  for (i = 0; i < numarea; i++)
+    modelDistribution.resize(new DoubleMatrix(numage, numlen, 0.0));
+
   AAT.addActions(Years, Steps, TimeInfo);
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in catchdistribution - found no data in the data file for", this->getName());
@@ -330,15 +335,18 @@ CatchDistribution::~CatchDistribution() {
   for (i = 0; i < lenindex.Size(); i++)
     delete[] lenindex[i];
   for (i = 0; i < obsDistribution.Nrow(); i++)
-    for (j = 0; j < obsDistribution.Ncol(i); j++) {
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
       delete obsDistribution[i][j];
-      delete modelDistribution[i][j];
-    }
+  for (i = 0; i < modelDistribution.Size(); i++)
+    delete modelDistribution[i];
   for (i = 0; i < modelYearData.Size(); i++) {
     delete modelYearData[i];
     delete obsYearData[i];
   }
-  delete aggregator;
+  for (i = 0; i < obsDataTerm.Size(); i++)
+    delete obsDataTerm[i];
+  if (aggregator != 0)
+    aggcache.deleteAggregator(aggregator);
   delete LgrpDiv;
   delete[] functionname;
 }
@@ -348,10 +356,9 @@ void CatchDistribution::Reset(const Keeper* const keeper) {
   if (isZero(weight))
     handle.logMessage(LOGWARN, "Warning in catchdistribution - zero weight for", this->getName());
 
-  int i, j;
-  for (i = 0; i < modelDistribution.Nrow(); i++)
-    for (j = 0; j < modelDistribution.Ncol(i); j++)
-      (*modelDistribution[i][j]).setToZero();
+  int i;
+  for (i = 0; i < modelDistribution.Size(); i++)
+    (*modelDistribution[i]).setToZero();
   if (yearly)
     for (i = 0; i < modelYearData.Size(); i++) {
       (*modelYearData[i]).setToZero();
@@ -427,27 +434,24 @@ void CatchDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, age, len;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, age, len;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchdistribution - invalid timestep");
 
-  for (area = 0; area < modelDistribution.Ncol(timeindex); area++) {
-    for (age = 0; age < modelDistribution[timeindex][area]->Nrow(); age++) {
-      for (len = 0; len < modelDistribution[timeindex][area]->Ncol(age); len++) {
+  for (area = 0; area < modelDistribution.Size(); area++) {
+    for (age = 0; age < modelDistribution[area]->Nrow(); age++) {
+      for (len = 0; len < modelDistribution[area]->Ncol(age); len++) {
         outfile << setw(lowwidth) << Years[timeindex] << sep << setw(lowwidth)
           << Steps[timeindex] << sep << setw(printwidth) << areaindex[area] << sep
           << setw(printwidth) << ageindex[age] << sep << setw(printwidth)
           << lenindex[len] << sep << setprecision(largeprecision) << setw(largewidth);
 
         //JMB crude filter to remove the 'silly' values from the output
-        if ((*modelDistribution[timeindex][area])[age][len] < rathersmall)
+        if ((*modelDistribution[area])[age][len] < rathersmall)
           outfile << 0 << endl;
         else
-          outfile << (*modelDistribution[timeindex][area])[age][len] << endl;
+          outfile << (*modelDistribution[area])[age][len] << endl;
       }
     }
   }
@@ -554,7 +558,7 @@ void CatchDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
       handle.logMessage(LOGWARN, "Warning in catchdistribution - maximum length group greater than stock length");
   }
 
-  aggregator = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+  aggregator = aggcache.getFleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
 }
 
 void CatchDistribution::addLikelihood(const TimeClass* const TimeInfo) {
@@ -565,11 +569,7 @@ void CatchDistribution::addLikelihood(const TimeClass* const TimeInfo) {
   if ((handle.getLogLevel() >= LOGMESSAGE) && ((!yearly) || (TimeInfo->getStep() == TimeInfo->numSteps())))
     handle.logMessage(LOGMESSAGE, "Calculating likelihood score for catchdistribution component", this->getName());
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchdistribution - invalid timestep");
 
@@ -629,28 +629,52 @@ double CatchDistribution::calcLikMultinomial() {
     likelihoodValues[timeindex][area] = 0.0;
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[area])[age][len] = ((*alptr)[area][age][len]).N;
 
     if (numage == 1) {
       //only one age-group, so calculate multinomial based on length distribution
       likelihoodValues[timeindex][area] +=
         MN.calcLogLikelihood((*obsDistribution[timeindex][area])[0],
-          (*modelDistribution[timeindex][area])[0]);
+          (*modelDistribution[area])[0], (*obsDataTerm[timeindex])[area][0]);
 
     } else {
       //many age-groups, so calculate multinomial based on age distribution per length group
       for (len = 0; len < numlen; len++) {
         for (age = 0; age < numage; age++) {
-          dist[age] = (*modelDistribution[timeindex][area])[age][len];
+          dist[age] = (*modelDistribution[area])[age][len];
           data[age] = (*obsDistribution[timeindex][area])[age][len];
         }
-        likelihoodValues[timeindex][area] += MN.calcLogLikelihood(data, dist);
+        likelihoodValues[timeindex][area] += MN.calcLogLikelihood(data, dist, (*obsDataTerm[timeindex])[area][len]);
       }
     }
   }
   return MN.getLogLikelihood();
 }
 
+void CatchDistribution::calcDataTerms(int numarea, int numage, int numlen) {
+  int i, area, age, len;
+  DoubleVector data(numage, 0.0);
+
+  //the observed data wont change, so the log factorials only need to be calculated once
+  for (i = 0; i < obsDistribution.Nrow(); i++) {
+    if (numage == 1) {
+      obsDataTerm.resize(new DoubleMatrix(numarea, 1, 0.0));
+      for (area = 0; area < numarea; area++)
+        (*obsDataTerm[i])[area][0] = MN.calcDataTerm((*obsDistribution[i][area])[0]);
+
+    } else {
+      obsDataTerm.resize(new DoubleMatrix(numarea, numlen, 0.0));
+      for (area = 0; area < numarea; area++) {
+        for (len = 0; len < numlen; len++) {
+          for (age = 0; age < numage; age++)
+            data[age] = (*obsDistribution[i][area])[age][len];
+          (*obsDataTerm[i])[area][len] = MN.calcDataTerm(data);
+        }
+      }
+    }
+  }
+}
+
 double CatchDistribution::calcLikPearson(const TimeClass* const TimeInfo) {
   /* written by Hoskuldur Bjornsson 29/8 98
    * corrected by kgf 16/9 98
@@ -669,17 +693,17 @@ double CatchDistribution::calcLikPearson(const TimeClass* const TimeInfo) {
     //JMB - changed to remove the need to store minrow and mincol stuff ...
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+        (*modelDistribution[area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
           likelihoodValues[timeindex][area] +=
-            ((*modelDistribution[timeindex][area])[age][len] -
+            ((*modelDistribution[area])[age][len] -
             (*obsDistribution[timeindex][area])[age][len]) *
-            ((*modelDistribution[timeindex][area])[age][len] -
+            ((*modelDistribution[area])[age][len] -
             (*obsDistribution[timeindex][area])[age][len]) /
-            fabs(((*modelDistribution[timeindex][area])[age][len] + epsilon));
+            fabs(((*modelDistribution[area])[age][len] + epsilon));
         }
       }
       totallikelihood += likelihoodValues[timeindex][area];
@@ -693,7 +717,7 @@ double CatchDistribution::calcLikPearson(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -730,15 +754,15 @@ double CatchDistribution::calcLikGamma(const TimeClass* const TimeInfo) {
     //JMB - changed to remove the need to store minrow and mincol stuff ...
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+        (*modelDistribution[area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
           likelihoodValues[timeindex][area] +=
             (*obsDistribution[timeindex][area])[age][len] /
-            ((*modelDistribution[timeindex][area])[age][len] + epsilon) +
-            log((*modelDistribution[timeindex][area])[age][len] + epsilon);
+            ((*modelDistribution[area])[age][len] + epsilon) +
+            log((*modelDistribution[area])[age][len] + epsilon);
         }
       }
       totallikelihood += likelihoodValues[timeindex][area];
@@ -752,7 +776,7 @@ double CatchDistribution::calcLikGamma(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -790,12 +814,12 @@ double CatchDistribution::calcLikLog(const TimeClass* const TimeInfo) {
     //JMB - changed to remove the need to store minrow and mincol stuff ...
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+        (*modelDistribution[area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
+          totalmodel += (*modelDistribution[area])[age][len];
           totaldata += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -811,7 +835,7 @@ double CatchDistribution::calcLikLog(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -845,14 +869,14 @@ double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[area])[age][len] = ((*alptr)[area][age][len]).N;
 
     totalmodel = 0.0;
     totaldata = 0.0;
     if (!yearly) { //calculate likelihood on all steps
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
+          totalmodel += (*modelDistribution[area])[age][len];
           totaldata += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -865,7 +889,7 @@ double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
           temp = (((*obsDistribution[timeindex][area])[age][len] * totaldata)
-            - ((*modelDistribution[timeindex][area])[age][len] * totalmodel));
+            - ((*modelDistribution[area])[age][len] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -880,7 +904,7 @@ double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -927,7 +951,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[area])[age][len] = ((*alptr)[area][age][len]).N;
 
     if (!yearly) { //calculate likelihood on all steps
       //calculate an age distribution for each length class
@@ -935,7 +959,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
         totalmodel = 0.0;
         totaldata = 0.0;
         for (age = 0; age < numage; age++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
+          totalmodel += (*modelDistribution[area])[age][len];
           totaldata += (*obsDistribution[timeindex][area])[age][len];
         }
 
@@ -946,7 +970,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 
         for (age = 0; age < numage; age++) {
           temp = (((*obsDistribution[timeindex][area])[age][len] * totaldata)
-            - ((*modelDistribution[timeindex][area])[age][len] * totalmodel));
+            - ((*modelDistribution[area])[age][len] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -961,7 +985,7 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
 
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          (*modelYearData[area])[age][len] += (*modelDistribution[timeindex][area])[age][len];
+          (*modelYearData[area])[age][len] += (*modelDistribution[area])[age][len];
           (*obsYearData[area])[age][len] += (*obsDistribution[timeindex][area])[age][len];
         }
       }
@@ -1038,9 +1062,9 @@ double CatchDistribution::calcLikMVNormal() {
     likelihoodValues[timeindex][area] = 0.0;
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[area])[age][len] = ((*alptr)[area][age][len]).N;
         sumdata += (*obsDistribution[timeindex][area])[age][len];
-        sumdist += (*modelDistribution[timeindex][area])[age][len];
+        sumdist += (*modelDistribution[area])[age][len];
       }
     }
 
@@ -1057,7 +1081,7 @@ double CatchDistribution::calcLikMVNormal() {
       diff.setToZero();
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
         diff[len] = ((*obsDistribution[timeindex][area])[age][len] * sumdata)
-                    - ((*modelDistribution[timeindex][area])[age][len] * sumdist);
+                    - ((*modelDistribution[area])[age][len] * sumdist);
 
       likelihoodValues[timeindex][area] += diff * LU.Solve(diff);
     }
@@ -1083,9 +1107,9 @@ double CatchDistribution::calcLikMVLogistic() {
       sumdata = 0.0;
       sumdist = 0.0;
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+        (*modelDistribution[area])[age][len] = ((*alptr)[area][age][len]).N;
         sumdata += (*obsDistribution[timeindex][area])[age][len];
-        sumdist += (*modelDistribution[timeindex][area])[age][len];
+        sumdist += (*modelDistribution[area])[age][len];
       }
 
       if (isZero(sumdata))
@@ -1101,7 +1125,7 @@ double CatchDistribution::calcLikMVLogistic() {
       nu.setToZero();
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
         nu[len] = log(((*obsDistribution[timeindex][area])[age][len] * sumdata) + verysmall)
-                  - log(((*modelDistribution[timeindex][area])[age][len] * sumdist) + verysmall);
+                  - log(((*modelDistribution[area])[age][len] * sumdist) + verysmall);
 
         sumnu += nu[len];
       }
@@ -184,11 +184,8 @@ void CatchInKilos::addLikelihood(const TimeClass* const TimeInfo) {
     for (i = 0; i < Years.Size(); i++)
       if (Years[i] == TimeInfo->getYear())
         timeindex = i;
-  } else {
-    for (i = 0; i < Years.Size(); i++)
-      if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-        timeindex = i;
-  }
+  } else
+    timeindex = AAT.getTimeIndex(TimeInfo);
 
   double l = 0.0;
   switch (functionnumber) {
@@ -404,11 +401,8 @@ void CatchInKilos::printLikelihood(ofstream& outfile, const TimeClass* const Tim
     for (i = 0; i < Years.Size(); i++)
       if (Years[i] == TimeInfo->getYear())
         timeindex = i;
-  } else {
-    for (i = 0; i < Years.Size(); i++)
-      if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-        timeindex = i;
-  }
+  } else
+    timeindex = AAT.getTimeIndex(TimeInfo);
 
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchinkilos - invalid timestep");
@@ -9,11 +9,12 @@
 #include "mathfunc.h"
 #include "readaggregation.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 CatchStatistics::CatchStatistics(CommentStream& infile, const AreaClass* const Area,
   const TimeClass* const TimeInfo, double weight, const char* name)
-  : Likelihood(CATCHSTATISTICSLIKELIHOOD, weight, name), alptr(0) {
+  : Likelihood(CATCHSTATISTICSLIKELIHOOD, weight, name), aggregator(0), alptr(0) {
 
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
@@ -244,7 +245,8 @@ CatchStatistics::~CatchStatistics() {
     delete[] areaindex[i];
   for (i = 0; i < ageindex.Size(); i++)
     delete[] ageindex[i];
-  delete aggregator;
+  if (aggregator != 0)
+    aggcache.deleteAggregator(aggregator);
   for (i = 0; i < numbers.Size(); i++) {
     delete numbers[i];
     delete obsMean[i];
@@ -393,7 +395,7 @@ void CatchStatistics::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector&
       handle.logMessage(LOGWARN, "Warning in catchstatistics - maximum length group greater than stock length");
   }
 
-  aggregator = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+  aggregator = aggcache.getFleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
 }
 
 void CatchStatistics::addLikelihood(const TimeClass* const TimeInfo) {
@@ -401,11 +403,7 @@ void CatchStatistics::addLikelihood(const TimeClass* const TimeInfo) {
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
     return;
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchstatistics - invalid timestep");
 
@@ -481,11 +479,8 @@ void CatchStatistics::printLikelihood(ofstream& outfile, const TimeClass* const
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, age;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, age;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchstatistics - invalid timestep");
 
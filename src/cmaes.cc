@@ -0,0 +1,331 @@
+#include "errorhandler.h"
+#include "optinfo.h"
+#include "mathfunc.h"
+#include "doublematrix.h"
+#include "intvector.h"
+#include "ecosystem.h"
+#include "gadget.h"
+#include "global.h"
+
+/* JMB the parameters are mapped onto the unit interval using the bounds, */
+/* so that the initial distribution covers each parameter in the same way */
+/* and the trial points can be reflected back into the bounds             */
+
+extern Ecosystem* EcoSystem;
+
+/* calculate the eigenvectors and eigenvalues of a symmetric matrix */
+/* using the cyclic Jacobi method, given by Press et al, Numerical  */
+/* Recipes in C (2nd edition, section 11.1) published by CUP, 1992  */
+void OptInfoCMAES::calcEigen(const DoubleMatrix& C, DoubleMatrix& B, DoubleVector& D) {
+
+  int i, j, k, sweep;
+  double off, theta, t, c, s, tmpp, tmpq;
+  int nvars = C.Nrow();
+  DoubleMatrix A(C);
+
+  for (i = 0; i < nvars; i++) {
+    for (j = 0; j < nvars; j++)
+      B[i][j] = 0.0;
+    B[i][i] = 1.0;
+  }
+
+  for (sweep = 0; sweep < 50; sweep++) {
+    off = 0.0;
+    for (i = 0; i < nvars; i++)
+      for (j = i + 1; j < nvars; j++)
+        off += A[i][j] * A[i][j];
+    if (off < verysmall)
+      break;
+
+    for (i = 0; i < nvars; i++) {
+      for (j = i + 1; j < nvars; j++) {
+        if (isZero(A[i][j]))
+          continue;
+
+        theta = (A[j][j] - A[i][i]) / (2.0 * A[i][j]);
+        t = 1.0 / (fabs(theta) + sqrt(theta * theta + 1.0));
+        if (theta < 0.0)
+          t = -t;
+        c = 1.0 / sqrt(t * t + 1.0);
+        s = t * c;
+
+        for (k = 0; k < nvars; k++) {
+          tmpp = A[k][i];
+          tmpq = A[k][j];
+          A[k][i] = c * tmpp - s * tmpq;
+          A[k][j] = s * tmpp + c * tmpq;
+        }
+        for (k = 0; k < nvars; k++) {
+          tmpp = A[i][k];
+          tmpq = A[j][k];
+          A[i][k] = c * tmpp - s * tmpq;
+          A[j][k] = s * tmpp + c * tmpq;
+        }
+        for (k = 0; k < nvars; k++) {
+          tmpp = B[k][i];
+          tmpq = B[k][j];
+          B[k][i] = c * tmpp - s * tmpq;
+          B[k][j] = s * tmpp + c * tmpq;
+        }
+      }
+    }
+  }
+
+  //JMB D contains the standard deviations along each eigenvector
+  for (i = 0; i < nvars; i++)
+    D[i] = sqrt(max(A[i][i], verysmall));
+}
+
+void OptInfoCMAES::OptimiseLikelihood() {
+
+  double tmp, bestf, stepsize, mueff, cc, cs, c1, cmu, damps, chin, normps, hsig, maxd, mind;
+  int i, j, k, l, offset, run, gen, eigengen, numlambda, mu, stop;
+
+  handle.logMessage(LOGINFO, "\nStarting CMA-ES optimisation algorithm\n");
+  int nvars = EcoSystem->numOptVariables();
+  DoubleVector x(nvars);
+  DoubleVector bestx(nvars);
+  DoubleVector init(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector width(nvars);
+  DoubleVector tmpvec(nvars, 0.0);
+  DoubleVector step(nvars, 0.0);
+
+  EcoSystem->scaleVariables();  //JMB need to scale variables
+  EcoSystem->getOptScaledValues(x);
+  EcoSystem->getOptInitialValues(init);
+  EcoSystem->getOptLowerBounds(lowerb);
+  EcoSystem->getOptUpperBounds(upperb);
+
+  for (i = 0; i < nvars; i++) {
+    // Scaling the bounds, because the parameters are scaled
+    lowerb[i] = lowerb[i] / init[i];
+    upperb[i] = upperb[i] / init[i];
+    if (lowerb[i] > upperb[i]) {
+      tmp = lowerb[i];
+      lowerb[i] = upperb[i];
+      upperb[i] = tmp;
+    }
+    width[i] = upperb[i] - lowerb[i];
+    bestx[i] = x[i];
+  }
+
+  bestf = EcoSystem->SimulateAndUpdate(x);
+  if (bestf != bestf) { // check for NaN
+    handle.logMessage(LOGINFO, "Error starting CMA-ES optimisation with f(x) = infinity");
+    converge = -1;
+    iters = 1;
+    return;
+  }
+
+  offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
+  numlambda = lambda;
+  if (numlambda == 0)
+    numlambda = 4 + (int)(3.0 * log((double)nvars));
+
+  converge = 1;
+  for (run = 0; run <= restarts; run++) {
+    if (run > 0) {
+      numlambda *= 2;
+      handle.logMessage(LOGINFO, "\nRestarting CMA-ES optimisation algorithm with a population size of", numlambda);
+    }
+
+    // set the weights and the learning rates for this population size
+    mu = numlambda / 2;
+    DoubleVector weights(mu, 0.0);
+    tmp = 0.0;
+    for (k = 0; k < mu; k++) {
+      weights[k] = log(mu + 0.5) - log(k + 1.0);
+      tmp += weights[k];
+    }
+    mueff = 0.0;
+    for (k = 0; k < mu; k++) {
+      weights[k] /= tmp;
+      mueff += weights[k] * weights[k];
+    }
+    mueff = 1.0 / mueff;
+
+    cc = (4.0 + mueff / nvars) / (nvars + 4.0 + 2.0 * mueff / nvars);
+    cs = (mueff + 2.0) / (nvars + mueff + 5.0);
+    c1 = 2.0 / ((nvars + 1.3) * (nvars + 1.3) + mueff);
+    cmu = min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((nvars + 2.0) * (nvars + 2.0) + mueff));
+    damps = 1.0 + 2.0 * max(0.0, sqrt((mueff - 1.0) / (nvars + 1.0)) - 1.0) + cs;
+    chin = sqrt((double)nvars) * (1.0 - 1.0 / (4.0 * nvars) + 1.0 / (21.0 * nvars * nvars));
+
+    DoubleVector mean(nvars, 0.0);
+    DoubleVector oldmean(nvars, 0.0);
+    DoubleVector pc(nvars, 0.0);
+    DoubleVector ps(nvars, 0.0);
+    DoubleVector D(nvars, 1.0);
+    DoubleVector f(numlambda, 0.0);
+    IntVector index(numlambda, 0);
+    DoubleMatrix C(nvars, nvars, 0.0);
+    DoubleMatrix B(nvars, nvars, 0.0);
+    DoubleMatrix pop(numlambda, nvars, 0.0);
+    DoubleMatrix ypop(numlambda, nvars, 0.0);
+    DoubleMatrix trialx(numlambda, nvars, 0.0);
+    for (i = 0; i < nvars; i++) {
+      C[i][i] = 1.0;
+      B[i][i] = 1.0;
+    }
+
+    //JMB the first run starts from the current point, and the restarts start from a random point
+    for (i = 0; i < nvars; i++) {
+      if (run > 0)
+        mean[i] = randomNumber();
+      else if (!(isZero(width[i])))
+        mean[i] = (x[i] - lowerb[i]) / width[i];
+    }
+
+    stepsize = sigma;
+    gen = 0;
+    eigengen = 0;
+    stop = 0;
+    while (!stop) {
+      // terminate the algorithm if too many function evaluations will occur
+      iters = EcoSystem->getFuncEval() - offset;
+      if ((iters + numlambda) > cmaesiter) {
+        converge = 0;
+        break;
+      }
+
+      // generate the trial points, reflecting them back into the bounds
+      for (k = 0; k < numlambda; k++) {
+        for (i = 0; i < nvars; i++)
+          tmpvec[i] = D[i] * randomNormal();
+        for (i = 0; i < nvars; i++) {
+          tmp = 0.0;
+          for (j = 0; j < nvars; j++)
+            tmp += B[i][j] * tmpvec[j];
+
+          pop[k][i] = fmod(fabs(mean[i] + stepsize * tmp), 2.0);
+          if (pop[k][i] > 1.0)
+            pop[k][i] = 2.0 - pop[k][i];
+          ypop[k][i] = (pop[k][i] - mean[i]) / stepsize;
+          trialx[k][i] = lowerb[i] + pop[k][i] * width[i];
+        }
+      }
+
+      //JMB the trial points are independent, so they can be calculated in parallel
+      EcoSystem->SimulateAndUpdate(trialx, f);
+      iters = EcoSystem->getFuncEval() - offset;
+
+      // sort the trial points by the likelihood score, with any NaN values last
+      for (k = 0; k < numlambda; k++) {
+        for (l = k; l > 0; l--) {
+          if ((f[index[l - 1]] != f[index[l - 1]]) || (f[k] < f[index[l - 1]]))
+            index[l] = index[l - 1];
+          else
+            break;
+        }
+        index[l] = k;
+      }
+
+      if (f[index[0]] < bestf) {
+        bestf = f[index[0]];
+        for (i = 0; i < nvars; i++) {
+          bestx[i] = trialx[index[0]][i];
+          tmpvec[i] = bestx[i] * init[i];
+        }
+
+        EcoSystem->storeVariables(bestf, tmpvec);
+        handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+        handle.logMessage(LOGINFO, "The likelihood score is", bestf, "at the point");
+        EcoSystem->writeBestValues();
+      }
+
+      // move the mean to the weighted average of the best trial points
+      for (i = 0; i < nvars; i++) {
+        oldmean[i] = mean[i];
+        mean[i] = 0.0;
+        for (k = 0; k < mu; k++)
+          mean[i] += weights[k] * pop[index[k]][i];
+        step[i] = (mean[i] - oldmean[i]) / stepsize;
+      }
+
+      // update the evolution path for the step size, using the inverse square root of C
+      for (j = 0; j < nvars; j++) {
+        tmp = 0.0;
+        for (i = 0; i < nvars; i++)
+          tmp += B[i][j] * step[i];
+        tmpvec[j] = tmp / D[j];
+      }
+      normps = 0.0;
+      for (i = 0; i < nvars; i++) {
+        tmp = 0.0;
+        for (j = 0; j < nvars; j++)
+          tmp += B[i][j] * tmpvec[j];
+        ps[i] = (1.0 - cs) * ps[i] + sqrt(cs * (2.0 - cs) * mueff) * tmp;
+        normps += ps[i] * ps[i];
+      }
+      normps = sqrt(normps);
+
+      // update the evolution path for the covariance matrix
+      hsig = 0.0;
+      if ((normps / sqrt(1.0 - pow(1.0 - cs, 2.0 * (gen + 1))) / chin) < (1.4 + 2.0 / (nvars + 1.0)))
+        hsig = 1.0;
+      for (i = 0; i < nvars; i++)
+        pc[i] = (1.0 - cc) * pc[i] + hsig * sqrt(cc * (2.0 - cc) * mueff) * step[i];
+
+      // adapt the covariance matrix, using the rank-one and rank-mu updates
+      for (i = 0; i < nvars; i++) {
+        for (j = 0; j <= i; j++) {
+          tmp = 0.0;
+          for (k = 0; k < mu; k++)
+            tmp += weights[k] * ypop[index[k]][i] * ypop[index[k]][j];
+          C[i][j] = (1.0 - c1 - cmu) * C[i][j]
+            + c1 * (pc[i] * pc[j] + (1.0 - hsig) * cc * (2.0 - cc) * C[i][j])
+            + cmu * tmp;
+          C[j][i] = C[i][j];
+        }
+      }
+
+      // adapt the step size
+      stepsize *= exp((cs / damps) * (normps / chin - 1.0));
+      gen++;
+
+      //JMB only update the eigenvectors occasionally, since this is O(n^3)
+      if ((gen - eigengen) > (numlambda / (c1 + cmu) / nvars / 10.0)) {
+        this->calcEigen(C, B, D);
+        eigengen = gen;
+      }
+
+      //JMB increase the step size if the best trial points all have the same score
+      if (isEqual(f[index[0]], f[index[mu - 1]])) {
+        handle.logMessage(LOGINFO, "Warning in CMA-ES - flat likelihood surface after", iters, "function evaluations");
+        stepsize *= exp(0.2 + cs / damps);
+      }
+
+      // check whether the distribution has converged
+      maxd = mind = D[0];
+      for (i = 1; i < nvars; i++) {
+        maxd = max(maxd, D[i]);
+        mind = min(mind, D[i]);
+      }
+      if ((stepsize * maxd) < cmaeseps) {
+        handle.logMessage(LOGINFO, "The CMA-ES distribution converged after", iters, "function evaluations");
+        stop = 1;
+      } else if (maxd > (1e7 * mind)) {
+        handle.logMessage(LOGINFO, "Warning in CMA-ES - covariance matrix is ill-conditioned after", iters, "function evaluations");
+        stop = 1;
+      }
+    }
+
+    if (!converge)
+      break;
+  }
+
+  iters = EcoSystem->getFuncEval() - offset;
+  handle.logMessage(LOGINFO, "\nStopping CMA-ES optimisation algorithm\n");
+  handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+  if (converge)
+    handle.logMessage(LOGINFO, "The optimisation stopped because all the restarts have converged");
+  else {
+    handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+    handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+  }
+
+  score = EcoSystem->SimulateAndUpdate(bestx);
+  handle.logMessage(LOGINFO, "\nCMA-ES finished with a likelihood score of", score);
+}
@@ -2,6 +2,7 @@
 #include "gadget.h"
 
 DoubleVector::DoubleVector(int sz) {
+  shared = 0;
   size = (sz > 0 ? sz : 0);
   if (size > 0)
     v = new double[size];
@@ -10,6 +11,7 @@ DoubleVector::DoubleVector(int sz) {
 }
 
 DoubleVector::DoubleVector(int sz, double value) {
+  shared = 0;
   size = (sz > 0 ? sz : 0);
   int i;
   if (size > 0) {
@@ -21,6 +23,7 @@ DoubleVector::DoubleVector(int sz, double value) {
 }
 
 DoubleVector::DoubleVector(const DoubleVector& initial) {
+  shared = 0;
   size = initial.size;
   int i;
   if (size > 0) {
@@ -33,7 +36,8 @@ DoubleVector::DoubleVector(const DoubleVector& initial) {
 
 DoubleVector::~DoubleVector() {
   if (v != 0) {
-    delete[] v;
+    if (!shared)
+      delete[] v;
     v = 0;
   }
 }
@@ -55,9 +59,11 @@ void DoubleVector::resize(int addsize, double value) {
       vnew[i] = v[i];
     for (i = size; i < size + addsize; i++)
       vnew[i] = value;
-    delete[] v;
+    if (!shared)
+      delete[] v;
     v = vnew;
     size += addsize;
+    shared = 0;
   }
 }
 
@@ -69,26 +75,33 @@ void DoubleVector::Delete(int pos) {
       vnew[i] = v[i];
     for (i = pos; i < size - 1; i++)
       vnew[i] = v[i + 1];
-    delete[] v;
+    if (!shared)
+      delete[] v;
     v = vnew;
     size--;
   } else {
-    delete[] v;
+    if (!shared)
+      delete[] v;
     v = 0;
     size = 0;
   }
+  shared = 0;
 }
 
 void DoubleVector::Reset() {
   if (size > 0) {
-    delete[] v;
+    if (!shared)
+      delete[] v;
     v = 0;
     size = 0;
   }
+  shared = 0;
 }
 
 void DoubleVector::setToZero() {
   int i;
+  if (shared)
+    this->moveFromStore();
   for (i = 0; i < size; i++)
     v[i] = 0.0;
 }
@@ -104,15 +117,20 @@ double DoubleVector::operator * (const DoubleVector& d) const {
 
 DoubleVector& DoubleVector::operator = (const DoubleVector& d) {
   int i;
-  if (size == d.size) {
+  if (this == &d)
+    return *this;
+  //JMB dont write to the memory in the ObservationStore, since it may be read-only
+  if ((size == d.size) && (!shared)) {
     for (i = 0; i < size; i++)
       v[i] = d[i];
     return *this;
   }
   if (v != 0) {
-    delete[] v;
+    if (!shared)
+      delete[] v;
     v = 0;
   }
+  shared = 0;
   size = d.size;
   if (size > 0) {
     v = new double[size];
@@ -122,3 +140,26 @@ DoubleVector& DoubleVector::operator = (const DoubleVector& d) {
     v = 0;
   return *this;
 }
+
+void DoubleVector::moveToStore(double* storage) {
+  int i;
+  if ((size == 0) || (storage == v))
+    return;
+  for (i = 0; i < size; i++)
+    storage[i] = v[i];
+  if (!shared)
+    delete[] v;
+  v = storage;
+  shared = 1;
+}
+
+void DoubleVector::moveFromStore() {
+  int i;
+  if ((!shared) || (size == 0))
+    return;
+  double* vnew = new double[size];
+  for (i = 0; i < size; i++)
+    vnew[i] = v[i];
+  v = vnew;
+  shared = 0;
+}
@@ -1,13 +1,29 @@
 #include "ecosystem.h"
+#include "localworkerpool.h"
+#include "ludecomposition.h"
+#include "mathfunc.h"
 #include "runid.h"
+#include "profiler.h"
 #include "global.h"
 
+#ifdef GADGET_NETWORK
+#include "mastercommunication.h"
+#endif
+
 Ecosystem::Ecosystem(const MainInfo& main) : printinfo(main.getPI()) {
 
   funceval = 0;
   interrupted = 0;
   likelihood = 0.0;
   keeper = new Keeper;
+  workers = 0;
+  obsstore = 0;
+  evalcache = 0;
+  restoremodel = 0;
+  checkbound = 0;
+  likebound = 0.0;
+  numstopped = 0;
+  resample = 0;
 
   // initialise counter used when printing output files
   printcount = printinfo.getPrintIteration() - 1;
@@ -51,6 +67,12 @@ Ecosystem::Ecosystem(const MainInfo& main) : printinfo(main.getPI()) {
 
 Ecosystem::~Ecosystem() {
   int i;
+  if (workers != 0)
+    delete workers;
+  if ((obsstore != 0) && (obsstore->removeReference() == 0))
+    delete obsstore;
+  if (evalcache != 0)
+    delete evalcache;
   for (i = 0; i < optvec.Size(); i++)
     delete optvec[i];
   for (i = 0; i < printvec.Size(); i++)
@@ -67,7 +89,8 @@ Ecosystem::~Ecosystem() {
   delete keeper;
 }
 
-void Ecosystem::writeStatus(const char* filename) const {
+void Ecosystem::writeStatus(const char* filename) {
+  this->restoreModel();
   ofstream outfile;
   outfile.open(filename, ios::out);
   handle.checkIfFailure(outfile, filename);
@@ -104,9 +127,53 @@ void Ecosystem::Optimise() {
     optvec[i]->OptimiseLikelihood();
     this->writeOptValues();
   }
+
+  if (evalcache->numHits() > 0)
+    handle.logMessage(LOGINFO, "\nThe likelihood score was found in the cache of previous points for", evalcache->numHits(), "function evaluations");
+  handle.logMessage(LOGMESSAGE, "Number of function evaluations not found in the cache", evalcache->numMisses());
+  if (numstopped > 0)
+    handle.logMessage(LOGINFO, "The simulation was stopped early for", numstopped, "function evaluations");
 }
 
-double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
+void Ecosystem::startWorkers(const MainInfo& main) {
+  if ((workers != 0) || (main.getNumWorkers() < 2))
+    return;
+
+#ifdef GADGET_NETWORK
+  workers = new MasterCommunication(main.getNumWorkers(), likevec.Size(), main, keeper);
+#else
+  workers = new LocalWorkerPool(main.getNumWorkers(), keeper->numVariables(), likevec.Size());
+#endif
+  handle.logMessage(LOGINFO, "Calculating the likelihood score using", workers->numWorkers(), "processes");
+}
+
+void Ecosystem::resampleLikelihood(int seed) {
+  int i, j, k;
+  IntVector steps;
+
+  //JMB the timesteps with data are resampled with replacement for each likelihood component
+  resampleweights.Reset();
+  resampleweights.AddRows(likevec.Size(), TimeInfo->numTotalSteps(), 1.0);
+  srand(seed);
+  for (k = 0; k < likevec.Size(); k++) {
+    if (!likevec[k]->canResample())
+      continue;
+
+    steps.Reset();
+    for (i = 0; i < likeSchedule.Nrow(); i++)
+      for (j = 0; j < likeSchedule[i].Size(); j++)
+        if (likeSchedule[i][j] == k)
+          steps.resize(1, i);
+
+    for (i = 0; i < steps.Size(); i++)
+      resampleweights[k][steps[i]] = 0.0;
+    for (i = 0; i < steps.Size(); i++)
+      resampleweights[k][steps[rand() % steps.Size()]] += 1.0;
+  }
+  resample = 1;
+}
+
+void Ecosystem::setCurrentValues(const DoubleVector& x) {
   int i, j;
 
   if (funceval == 0) {
@@ -126,14 +193,31 @@ double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
       j++;
     }
   }
+}
 
+double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
+  this->setCurrentValues(x);
+  profile.startTimer();
   keeper->Update(currentval);
-  this->Simulate(0);  //dont print whilst optimising
+  profile.addTime(PROFKEEPER, 0);
+
+  //JMB only simulate the model if this point hasnt been calculated recently
+  if (evalcache->findPoint(currentval, likelihood, cachelikes))
+    restoremodel = 1;
+  else {
+    this->Simulate(0);  //dont print whilst optimising
+    //JMB dont store the score if the simulation was stopped early, since it is incomplete
+    if (restoremodel == 0) {
+      this->getUnweightedLikelihoods(cachelikes);
+      evalcache->storePoint(currentval, likelihood, cachelikes);
+    } else
+      numstopped++;
+  }
 
   if (printinfo.getPrint()) {
     printcount++;
     if (printcount == printinfo.getPrintIteration()) {
-      keeper->writeValues(likevec, printinfo.getPrecision());
+      keeper->writeValues(likevec, currentval, cachelikes, likelihood, printinfo.getPrecision());
       printcount = 0;
     }
   }
@@ -142,37 +226,325 @@ double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
   return likelihood;
 }
 
-void Ecosystem::writeOptValues() {
+double Ecosystem::SimulateAndUpdate(const DoubleVector& x, double bound) {
+  //JMB only stop the simulation early if the score for this point isnt going to be printed
+  if ((this->canStopEarly()) && ((!printinfo.getPrint()) || (printcount + 1 != printinfo.getPrintIteration()))) {
+    checkbound = 1;
+    likebound = bound;
+  }
+
+  double score = this->SimulateAndUpdate(x);
+  checkbound = 0;
+  return score;
+}
+
+int Ecosystem::canStopEarly() const {
   int i;
-  DoubleVector tmpvec(likevec.Size(), 0.0);
+  //JMB the partial score is only a lower bound if no component can decrease the score
   for (i = 0; i < likevec.Size(); i++)
-    tmpvec[i] = likevec[i]->getUnweightedLikelihood();
+    if ((!likevec[i]->isCumulative()) || (likevec[i]->getWeight() < 0.0))
+      return 0;
+  return 1;
+}
+
+void Ecosystem::SimulateAndUpdate(const DoubleMatrix& x, DoubleVector& f) {
+  int i, j;
+
+  //JMB a single point is calculated here, so the model is left at that point
+  if ((workers == 0) || (x.Nrow() < 2)) {
+    for (i = 0; i < x.Nrow(); i++)
+      f[i] = this->SimulateAndUpdate(x[i]);
+    return;
+  }
+
+  int num = 0;
+  DoubleMatrix points(x.Nrow(), keeper->numVariables(), 0.0);
+  DoubleMatrix results(x.Nrow(), likevec.Size() + 1, 0.0);
+  DoubleVector likes(likevec.Size(), 0.0);
+  IntVector found(x.Nrow(), 0);
+  for (i = 0; i < x.Nrow(); i++) {
+    this->setCurrentValues(x[i]);
+    points[i] = currentval;
+    if (evalcache->findPoint(currentval, results[i][0], likes)) {
+      found[i] = 1;
+      for (j = 0; j < likes.Size(); j++)
+        results[i][j + 1] = likes[j];
+    } else
+      num++;
+  }
+
+  //JMB only send the points that havent been calculated recently to the parallel processes
+  if (num > 0) {
+    int k = 0;
+    DoubleMatrix newpoints(num, keeper->numVariables(), 0.0);
+    DoubleMatrix newresults(num, likevec.Size() + 1, 0.0);
+    for (i = 0; i < x.Nrow(); i++)
+      if (!found[i])
+        newpoints[k++] = points[i];
+
+    workers->evaluatePoints(newpoints, newresults);
+
+    k = 0;
+    for (i = 0; i < x.Nrow(); i++) {
+      if (!found[i]) {
+        results[i] = newresults[k];
+        for (j = 0; j < likes.Size(); j++)
+          likes[j] = results[i][j + 1];
+        evalcache->storePoint(points[i], results[i][0], likes);
+        k++;
+      }
+    }
+  }
+
+  //JMB the results are processed in order, as if they had been calculated here
+  for (i = 0; i < x.Nrow(); i++) {
+    if (printinfo.getPrint()) {
+      printcount++;
+      if (printcount == printinfo.getPrintIteration()) {
+        for (j = 0; j < likes.Size(); j++)
+          likes[j] = results[i][j + 1];
+        keeper->writeValues(likevec, points[i], likes, results[i][0], printinfo.getPrecision());
+        printcount = 0;
+      }
+    }
+
+    funceval++;
+    f[i] = results[i][0];
+  }
+
+  //JMB the model is left at the last point, but it hasnt been simulated here so it is marked as stale
+  i = x.Nrow() - 1;
+  keeper->Update(currentval);
+  likelihood = results[i][0];
+  for (j = 0; j < cachelikes.Size(); j++)
+    cachelikes[j] = results[i][j + 1];
+  restoremodel = 1;
+
+  this->checkInterrupted();
+}
+
+double Ecosystem::SimulateValues(const DoubleVector& val, DoubleVector& likes) {
+  keeper->Update(val);
+  this->Simulate(0);
+  this->getUnweightedLikelihoods(likes);
+  return likelihood;
+}
+
+void Ecosystem::restoreModel() {
+  if (restoremodel)
+    this->Simulate(0);
+}
+
+void Ecosystem::getUnweightedLikelihoods(DoubleVector& likes) const {
+  int i;
+  if (restoremodel == 1) {
+    //JMB the model hasnt been simulated, so use the scores from the cache
+    for (i = 0; i < likevec.Size(); i++)
+      likes[i] = cachelikes[i];
+    return;
+  }
+  for (i = 0; i < likevec.Size(); i++)
+    likes[i] = likevec[i]->getUnweightedLikelihood();
+}
+
+double Ecosystem::getOptLikelihoods(DoubleVector& likes) {
+  if (restoremodel == 2)
+    this->restoreModel();
+  this->getUnweightedLikelihoods(likes);
+  if (!isZero(keeper->getBestLikelihoodScore())) // no better point has been found
+    return keeper->getBestLikelihoodScore();
+  return likelihood;
+}
+
+void Ecosystem::writeOptValues() {
+  DoubleVector tmpvec(likevec.Size(), 0.0);
+  double score = this->getOptLikelihoods(tmpvec);
 
   handle.logMessage(LOGINFO, "\nAfter a total of", funceval, "function evaluations the best point found is");
   keeper->writeBestValues();
   handle.logMessage(LOGINFO, "\nThe scores from each likelihood component are");
   handle.logMessage(LOGINFO, tmpvec);
-  if (!isZero(keeper->getBestLikelihoodScore())) // no better point has been found
-    handle.logMessage(LOGINFO, "\nThe overall likelihood score is", keeper->getBestLikelihoodScore());
-  else
-    handle.logMessage(LOGINFO, "\nThe overall likelihood score is", this->getLikelihood());
+  handle.logMessage(LOGINFO, "\nThe overall likelihood score is", score);
 }
 
 void Ecosystem::writeInitialInformation(const char* const filename) {
-  keeper->openPrintFile(filename);
+  keeper->openPrintFile(filename, printinfo.getBinaryOutput());
   keeper->writeInitialInformation(likevec);
 }
 
 void Ecosystem::writeValues() {
-  keeper->writeValues(likevec, printinfo.getPrecision());
+  if (restoremodel == 2)
+    this->restoreModel();
+  if (restoremodel)
+    keeper->writeValues(likevec, currentval, cachelikes, likelihood, printinfo.getPrecision());
+  else
+    keeper->writeValues(likevec, printinfo.getPrecision());
 }
 
-void Ecosystem::writeParams(const char* const filename, int prec) const {
+void Ecosystem::writeParams(const char* const filename, int prec) {
   if ((funceval > 0) && (interrupted == 0)) {
     //JMB - print the final values to any output files specified
     //in case they have been missed by the -print value
     if (printinfo.getPrint())
-      keeper->writeValues(likevec, printinfo.getPrecision());
+      this->writeValues();
   }
+  //JMB - make sure that any buffered output has been written to file
+  if (printinfo.getPrint())
+    keeper->flushPrintFile();
   keeper->writeParams(optvec, filename, prec, interrupted);
 }
+
+void Ecosystem::writeHessian(const char* const filename, double step, int prec) {
+  int i, j, k, p, w, check;
+  int nvars = keeper->numOptVariables();
+  int oldprint = printinfo.getPrint();
+  int oldfunceval = funceval;
+  int oldprintcount = printcount;
+  double fx;
+  DoubleVector x(nvars, 0.0);
+  DoubleVector init(nvars, 0.0);
+  DoubleVector lowerb(nvars, 0.0);
+  DoubleVector upperb(nvars, 0.0);
+  DoubleVector h(nvars, 0.0);
+  DoubleMatrix hess(nvars, nvars, 0.0);
+  DoubleMatrix invhess(nvars, nvars, 0.0);
+  DoubleMatrix points(2 * nvars * nvars, nvars, 0.0);
+  DoubleVector f(2 * nvars * nvars, 0.0);
+  IntVector opt(keeper->numVariables(), 0);
+  ParameterVector sw(keeper->numVariables());
+
+  handle.logMessage(LOGINFO, "\nCalculating the Hessian matrix at the optimum using", points.Nrow(), "function evaluations");
+  keeper->scaleVariables();
+  keeper->getOptScaledValues(x);
+  keeper->getOptInitialValues(init);
+  keeper->getOptLowerBounds(lowerb);
+  keeper->getOptUpperBounds(upperb);
+  keeper->getOptFlags(opt);
+  keeper->getSwitches(sw);
+
+  //JMB the points used for the Hessian matrix arent part of the optimisation, so
+  //they arent counted as function evaluations or written to the optimisation output
+  printinfo.setPrint(0);
+  fx = this->SimulateAndUpdate(x);
+
+  //JMB the step size is scaled by the value of each parameter
+  k = 0;
+  for (i = 0; i < opt.Size(); i++) {
+    if (opt[i]) {
+      h[k] = step * max(fabs(x[k]), 1.0);
+      if (((x[k] - h[k]) * init[k] < min(lowerb[k], upperb[k])) || ((x[k] + h[k]) * init[k] > max(lowerb[k], upperb[k])))
+        handle.logMessage(LOGWARN, "Warning in ecosystem - Hessian matrix calculated outside the bounds for", sw[i].getName());
+      k++;
+    }
+  }
+
+  // the central difference points are x +/- h[i] for the diagonal, and x +/- h[i] +/- h[j] otherwise
+  k = 0;
+  for (i = 0; i < nvars; i++) {
+    for (j = 0; j < nvars; j++)
+      points[k][j] = points[k + 1][j] = x[j];
+    points[k][i] += h[i];
+    points[k + 1][i] -= h[i];
+    k += 2;
+  }
+  for (i = 0; i < nvars; i++) {
+    for (j = i + 1; j < nvars; j++) {
+      for (p = 0; p < 4; p++) {
+        for (w = 0; w < nvars; w++)
+          points[k + p][w] = x[w];
+        points[k + p][i] += ((p < 2) ? h[i] : -h[i]);
+        points[k + p][j] += (((p % 2) == 0) ? h[j] : -h[j]);
+      }
+      k += 4;
+    }
+  }
+
+  //JMB the points are independent, so they can be calculated in parallel
+  this->SimulateAndUpdate(points, f);
+
+  // calculate the Hessian matrix for the unscaled parameters
+  k = 0;
+  for (i = 0; i < nvars; i++) {
+    hess[i][i] = (f[k] - 2.0 * fx + f[k + 1]) / (h[i] * h[i] * init[i] * init[i]);
+    k += 2;
+  }
+  for (i = 0; i < nvars; i++) {
+    for (j = i + 1; j < nvars; j++) {
+      hess[i][j] = (f[k] - f[k + 1] - f[k + 2] + f[k + 3]) / (4.0 * h[i] * h[j] * init[i] * init[j]);
+      hess[j][i] = hess[i][j];
+      k += 4;
+    }
+  }
+
+  //JMB the Hessian matrix needs to be positive definite to calculate the inverse
+  LUDecomposition LU(hess);
+  check = !(LU.isIllegal());
+  if (check) {
+    DoubleVector unit(nvars, 0.0);
+    for (j = 0; j < nvars; j++) {
+      unit[j] = 1.0;
+      DoubleVector col(LU.Solve(unit));
+      for (i = 0; i < nvars; i++)
+        invhess[i][j] = col[i];
+      unit[j] = 0.0;
+    }
+  } else
+    handle.logMessage(LOGWARN, "Warning in ecosystem - Hessian matrix is not positive definite");
+
+  //JMB reset the model to the optimum
+  this->SimulateAndUpdate(x);
+  printinfo.setPrint(oldprint);
+  funceval = oldfunceval;
+  printcount = oldprintcount;
+
+  p = prec;
+  if (prec == 0)
+    p = largeprecision;
+  w = p + 8;
+
+  ofstream outfile;
+  outfile.open(filename, ios::out);
+  handle.checkIfFailure(outfile, filename);
+  handle.Open(filename);
+  outfile << "; ";
+  RUNID.Print(outfile);
+  outfile << "; Hessian matrix calculated using central differences with a step size of "
+    << step << "\n; at the point with a likelihood value of " << setprecision(p) << fx << endl;
+
+  outfile << "; square root of the diagonal of the inverse Hessian matrix for each parameter\n"
+    << "; these are only the standard errors if the likelihood score is a negative log-likelihood\n"
+    << "switch\tvalue\t\tstderr\n";
+  k = 0;
+  for (i = 0; i < opt.Size(); i++) {
+    if (opt[i]) {
+      outfile << sw[i].getName() << TAB << setw(w) << setprecision(p) << x[k] * init[k] << TAB << setw(w);
+      if (check && (invhess[k][k] > 0.0))
+        outfile << setprecision(p) << sqrt(invhess[k][k]) << endl;
+      else
+        outfile << "NA" << endl;
+      k++;
+    }
+  }
+
+  outfile << "; Hessian matrix\n";
+  for (i = 0; i < nvars; i++) {
+    for (j = 0; j < nvars; j++)
+      outfile << setw(w) << setprecision(p) << hess[i][j] << sep;
+    outfile << endl;
+  }
+
+  if (check) {
+    outfile << "; inverse Hessian matrix of the weighted likelihood score\n"
+      << "; this is only the covariance matrix if the likelihood score is a negative log-likelihood\n";
+    for (i = 0; i < nvars; i++) {
+      for (j = 0; j < nvars; j++)
+        outfile << setw(w) << setprecision(p) << invhess[i][j] << sep;
+      outfile << endl;
+    }
+  } else
+    outfile << "; the inverse Hessian matrix cannot be calculated because the Hessian matrix is not positive definite\n";
+
+  handle.Close();
+  outfile.close();
+  outfile.clear();
+}
@@ -0,0 +1,77 @@
+#include "evaluationcache.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+EvaluationCache::EvaluationCache(int size, int numvar, int numlike)
+  : points(size, numvar, 0.0), likelihoods(size, numlike, 0.0), scores(size, 0.0),
+    hashes(size, 0), lastused(size, 0) {
+
+  counter = hits = misses = 0;
+}
+
+int EvaluationCache::calcHash(const DoubleVector& point) const {
+  int i;
+  unsigned int j, hash = 2166136261u;
+  const unsigned char* ptr;
+
+  //JMB FNV-1a hash of the bytes of the values, since the values need to be exactly the same
+  for (i = 0; i < point.Size(); i++) {
+    ptr = (const unsigned char*)&point[i];
+    for (j = 0; j < sizeof(double); j++) {
+      hash ^= ptr[j];
+      hash *= 16777619u;
+    }
+  }
+  return (int)hash;
+}
+
+int EvaluationCache::findPoint(const DoubleVector& point, double& score, DoubleVector& likes) {
+  int i, j, hash, found;
+
+  hash = this->calcHash(point);
+  for (i = 0; i < lastused.Size(); i++) {
+    if ((lastused[i] == 0) || (hashes[i] != hash))
+      continue;
+
+    found = 1;
+    for (j = 0; j < point.Size(); j++) {
+      if (points[i][j] != point[j]) {
+        found = 0;
+        break;
+      }
+    }
+
+    if (found) {
+      score = scores[i];
+      for (j = 0; j < likes.Size(); j++)
+        likes[j] = likelihoods[i][j];
+      counter++;
+      lastused[i] = counter;
+      hits++;
+      return 1;
+    }
+  }
+
+  misses++;
+  return 0;
+}
+
+void EvaluationCache::storePoint(const DoubleVector& point, double score, const DoubleVector& likes) {
+  int i, j, pos;
+
+  //JMB replace the point that has been used least recently
+  pos = 0;
+  for (i = 1; i < lastused.Size(); i++)
+    if (lastused[i] < lastused[pos])
+      pos = i;
+
+  for (j = 0; j < point.Size(); j++)
+    points[pos][j] = point[j];
+  for (j = 0; j < likes.Size(); j++)
+    likelihoods[pos][j] = likes[j];
+  scores[pos] = score;
+  hashes[pos] = this->calcHash(point);
+  counter++;
+  lastused[pos] = counter;
+}
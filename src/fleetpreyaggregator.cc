@@ -4,16 +4,19 @@
 #include "stockprey.h"
 #include "poppredator.h"
 #include "fleet.h"
+#include "aggregatorcache.h"
 #include "gadget.h"
 #include "global.h"
 
 FleetPreyAggregator::FleetPreyAggregator(const FleetPtrVector& Fleets,
   const StockPtrVector& Stocks, LengthGroupDivision* const Lgrpdiv,
   const IntMatrix& Areas, const IntMatrix& Ages, int overcons)
-  : LgrpDiv(Lgrpdiv), areas(Areas), ages(Ages), overconsumption(overcons),
-    doescatch(Fleets.Size(), Stocks.Size(), 0), suitptr(0), alptr(0) {
+  : areas(Areas), ages(Ages), overconsumption(overcons),
+    doescatch(Fleets.Size(), Stocks.Size(), 0), suitptr(0), alptr(0), section(0) {
 
   int i, j;
+  //JMB store a copy of the length group division so that it can be compared later
+  LgrpDiv = new LengthGroupDivision(*Lgrpdiv);
   //JMB its simpler to just store pointers to the predators
   //and preys rather than pointers to the fleets and stocks
   for (i = 0; i < Stocks.Size(); i++)
@@ -44,6 +47,26 @@ FleetPreyAggregator::~FleetPreyAggregator() {
   int i;
   for (i = 0; i < CI.Size(); i++)
     delete CI[i];
+  delete LgrpDiv;
+}
+
+int FleetPreyAggregator::isSameAggregation(const FleetPtrVector& Fleets,
+  const StockPtrVector& Stocks, const LengthGroupDivision* const Lgrpdiv,
+  const IntMatrix& Areas, const IntMatrix& Ages, int overcons) const {
+
+  int i;
+  if ((overconsumption != overcons) || (predators.Size() != Fleets.Size()) || (preys.Size() != Stocks.Size()))
+    return 0;
+  //JMB the order of the fleets and stocks matters, since it changes the order of the sums
+  for (i = 0; i < predators.Size(); i++)
+    if (predators[i] != Fleets[i]->getPredator())
+      return 0;
+  for (i = 0; i < preys.Size(); i++)
+    if (preys[i] != Stocks[i]->getPrey())
+      return 0;
+  if ((!LgrpDiv->isSame(Lgrpdiv)) || (!areas.isSame(Areas)) || (!ages.isSame(Ages)))
+    return 0;
+  return 1;
 }
 
 void FleetPreyAggregator::Print(ofstream& outfile) const {
@@ -84,6 +107,11 @@ void FleetPreyAggregator::Sum() {
   int predl = 0;  //JMB there is only ever one length group ...
   double ratio;
 
+  //JMB the catch wont change until the model moves on, so only calculate it once
+  if ((aggcache.getSection() != 0) && (section == aggcache.getSection()))
+    return;
+  section = aggcache.getSection();
+
   this->Reset();
   //Sum over the appropriate predators, preys, areas, ages and length groups
   for (f = 0; f < predators.Size(); f++) {
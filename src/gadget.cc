@@ -4,7 +4,10 @@
 #include "gadget.h"
 #include "errorhandler.h"
 #include "stochasticdata.h"
+#include "replicates.h"
+#include "likelihoodprofile.h"
 #include "interrupthandler.h"
+#include "profiler.h"
 #include "global.h"
 
 Ecosystem* EcoSystem;
@@ -14,6 +17,8 @@ int main(int aNumber, char* const aVector[]) {
 
   MainInfo main;
   StochasticData* data = 0;
+  Replicates* replicates = 0;
+  LikelihoodProfile* likprofile = 0;
   int check = 0;
 
   //Initialise random number generator with system time [MNAA 02.02.26]
@@ -58,6 +63,8 @@ int main(int aNumber, char* const aVector[]) {
 
   if (chdir(workingdir) != 0)
     handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+  if (main.runProfile())
+    profile.Initialise(main.getProfileFile(), main.getProfileEvals(), main.getProfileCounters());
   if ((main.getPI()).getPrint())
     EcoSystem->writeInitialInformation((main.getPI()).getOutputFile());
 
@@ -65,11 +72,17 @@ int main(int aNumber, char* const aVector[]) {
     if (main.runNetwork()) {
 #ifdef GADGET_NETWORK //to help compiling when pvm libraries are unavailable
       EcoSystem->Initialise();
+      //JMB the scores from each likelihood component are only sent if the master has asked for them
+      DoubleVector likes;
+      if (main.runNetworkLikelihoods())
+        likes.resize(EcoSystem->getModelLikelihoodVector().Size(), 0.0);
       data = new StochasticData();
       while (data->getDataFromNetwork()) {
         EcoSystem->Update(data);
         EcoSystem->Simulate(main.runPrint());
-        data->sendDataToNetwork(EcoSystem->getLikelihood());
+        if (likes.Size() > 0)
+          EcoSystem->getUnweightedLikelihoods(likes);
+        data->sendDataToNetwork(EcoSystem->getLikelihood(), likes);
         data->readNextLineFromNetwork();
       }
       delete data;
@@ -143,22 +156,79 @@ int main(int aNumber, char* const aVector[]) {
       EcoSystem->writeStatus(main.getPrintInitialFile());
     }
 
-    EcoSystem->Optimise();
-    if (main.getForcePrint())
-      EcoSystem->Simulate(main.getForcePrint());
+    if (main.runReplicates()) {
+      if (chdir(inputdir) != 0) //JMB need to change back to inputdir to read the file
+        handle.logMessage(LOGFAIL, "Error - failed to change input directory to", inputdir);
+      ifstream infile;
+      infile.open(main.getReplicateFile(), ios::in);
+      CommentStream commin(infile);
+      handle.checkIfFailure(infile, main.getReplicateFile());
+      handle.Open(main.getReplicateFile());
+      replicates = new Replicates(commin, EcoSystem->getModelLikelihoodVector());
+      handle.Close();
+      infile.close();
+      infile.clear();
+      if (chdir(workingdir) != 0)
+        handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+
+      //JMB each replicate is optimised by a separate process, so -parallel sets the number of replicates optimised at once
+      PrintInfo pi(main.getPI());
+      char* summaryfile = new char[strlen(pi.getParamOutFile()) + 12];
+      strcpy(summaryfile, pi.getParamOutFile());
+      strcat(summaryfile, ".replicates");
+      replicates->Optimise(main.getNumWorkers(), pi.getParamOutFile(), pi.getPrecision());
+      replicates->writeSummary(summaryfile, EcoSystem->getModelLikelihoodVector());
+      delete[] summaryfile;
+      delete replicates;
+
+    } else if (main.runLikelihoodProfile()) {
+      if (chdir(inputdir) != 0) //JMB need to change back to inputdir to read the file
+        handle.logMessage(LOGFAIL, "Error - failed to change input directory to", inputdir);
+      ifstream infile;
+      infile.open(main.getLikelihoodProfileFile(), ios::in);
+      CommentStream commin(infile);
+      handle.checkIfFailure(infile, main.getLikelihoodProfileFile());
+      handle.Open(main.getLikelihoodProfileFile());
+      likprofile = new LikelihoodProfile(commin);
+      handle.Close();
+      infile.close();
+      infile.clear();
+      if (chdir(workingdir) != 0)
+        handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+
+      //JMB each grid point is optimised by a separate process, so -parallel sets the number of grid points optimised at once
+      PrintInfo pi(main.getPI());
+      char* profilefile = new char[strlen(pi.getParamOutFile()) + 9];
+      strcpy(profilefile, pi.getParamOutFile());
+      strcat(profilefile, ".profile");
+      likprofile->Optimise(main.getNumWorkers());
+      likprofile->writeProfile(profilefile, EcoSystem->getModelLikelihoodVector(), pi.getPrecision());
+      delete[] profilefile;
+      delete likprofile;
+
+    } else {
+      if (main.getNumWorkers() > 1)
+        EcoSystem->startWorkers(main);
+      EcoSystem->Optimise();
+      if (main.printHessian())
+        EcoSystem->writeHessian(main.getHessianFile(), main.getHessianStep(), (main.getPI()).getPrecision());
+      if (main.getForcePrint())
+        EcoSystem->Simulate(main.getForcePrint());
+    }
   }
 
   handle.logMessage(LOGMESSAGE, "");  //write blank line to log file
   if (main.printFinal() && !(main.runNetwork()))
     EcoSystem->writeStatus(main.getPrintFinalFile());
 
-  //JMB print final values of parameters
-  if (!(main.runNetwork()))
+  //JMB print final values of parameters, unless these have been written for each replicate or grid point
+  if (!(main.runNetwork()) && !(main.runReplicates()) && !(main.runLikelihoodProfile()))
     EcoSystem->writeParams((main.getPI()).getParamOutFile(), (main.getPI()).getPrecision());
 
   if (check)
     free(workingdir);
 
+  profile.writeSummary();
   delete EcoSystem;
   handle.logFinish();
   return EXIT_SUCCESS;
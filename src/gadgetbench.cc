@@ -0,0 +1,678 @@
+#include "gadget.h"
+#include <sys/time.h>
+#include <sys/stat.h>
+
+/* JMB this is a standalone program that generates synthetic Gadget models */
+/* and times the gadget executable running them, so that the performance   */
+/* of the simulation and the optimisation algorithms can be measured on a  */
+/* reproducible set of inputs.  It doesnt link to the gadget object files  */
+
+/* the size of a generated model */
+struct ModelSize {
+  const char* name;
+  int numstocks;
+  int numareas;
+  int numlengths;
+  int numages;
+  int numyears;
+  int numsteps;
+  int numsubsteps;
+  int numtags;
+  int numlikelihood;
+};
+
+/* the standard models used by the bench target */
+static const ModelSize benchModels[] = {
+  { "small", 2, 1, 10, 5, 5, 4, 1, 0, 2 },
+  { "medium", 3, 2, 20, 8, 10, 4, 2, 2, 4 },
+  { "large", 4, 4, 30, 10, 15, 4, 2, 4, 8 }
+};
+static const int numBenchModels = 3;
+
+/* the optimising algorithms that are timed, with the optinfo keyword */
+static const char* optNames[] = { "hooke", "simann", "bfgs", "lbfgs", "cmaes", "bobyqa" };
+static const int numOptNames = 6;
+
+static const int firstYear = 1990;
+static const double minLength = 5.0;
+static const double dl = 5.0;
+
+static long randomSeed = 1;
+
+static void failBench(const char* msg, const char* text) {
+  cerr << "Error in gadgetbench - " << msg << " " << text << endl;
+  exit(EXIT_FAILURE);
+}
+
+/* create a directory, and any parent directories that dont exist yet */
+static void makeDirectory(const char* dir) {
+  char path[LongString];
+  char* p;
+  if (strlen(dir) >= LongString)
+    failBench("directory name is too long", dir);
+  strcpy(path, dir);
+  for (p = path + 1; *p != '\0'; p++) {
+    if (*p != '/')
+      continue;
+    *p = '\0';
+    if ((mkdir(path, 0755) != 0) && (errno != EEXIST))
+      failBench("failed to create directory", path);
+    *p = '/';
+  }
+  if ((mkdir(path, 0755) != 0) && (errno != EEXIST))
+    failBench("failed to create directory", path);
+}
+
+/* minimal standard generator, so the data files are the same on all platforms */
+static double randomUniform() {
+  long hi = randomSeed / 127773;
+  long lo = randomSeed % 127773;
+  randomSeed = 16807 * lo - 2836 * hi;
+  if (randomSeed <= 0)
+    randomSeed += 2147483647;
+  return (double)randomSeed / 2147483647.0;
+}
+
+static double getTime() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec + ((double)tv.tv_usec * 1e-6);
+}
+
+static void openFile(ofstream& outfile, const char* dir, const char* name) {
+  char filename[LongString];
+  snprintf(filename, LongString, "%s/%s", dir, name);
+  outfile.open(filename, ios::out);
+  if (outfile.fail())
+    failBench("failed to open file", filename);
+  outfile.precision(printprecision);
+}
+
+static double maxLength(const ModelSize& model) {
+  return minLength + dl * model.numlengths;
+}
+
+static double linf(const ModelSize& model) {
+  return 1.2 * maxLength(model);
+}
+
+/* mean length at age for the initial population, which is kept below the */
+/* maximum length, since the growth parameter linf has to be greater than it */
+static double meanLength(const ModelSize& model, int age) {
+  double len = 0.9 * maxLength(model) * (1.0 - exp(-0.3 * age));
+  if (len < minLength + dl)
+    len = minLength + dl;
+  return len;
+}
+
+static double stdDev(const ModelSize& model, int age) {
+  return 0.1 * meanLength(model, age) + dl;
+}
+
+/* relative number of fish at a given age and length group */
+static double numberAtLength(const ModelSize& model, int age, int len) {
+  double mid = minLength + dl * (len + 0.5);
+  double z = (mid - meanLength(model, age)) / stdDev(model, age);
+  return 1000.0 * exp(-0.3 * (age - 1) - 0.5 * z * z);
+}
+
+static void writeMain(const ModelSize& model, const char* dir) {
+  int i;
+  ofstream outfile;
+  openFile(outfile, dir, "main");
+  outfile << "; synthetic " << model.name << " model generated by gadgetbench\n"
+    << "timefile\ttime\nareafile\tarea\nprintfiles\t;\n[stock]\nstockfiles";
+  for (i = 0; i < model.numstocks; i++)
+    outfile << "\tstock" << i + 1;
+  outfile << "\n[tagging]\n";
+  if (model.numtags > 0)
+    outfile << "tagfiles\ttagging\n";
+  outfile << "[otherfood]\n[fleet]\nfleetfiles\tfleet\n"
+    << "[likelihood]\nlikelihoodfiles\tlikelihood\n";
+  outfile.close();
+}
+
+static void writeTime(const ModelSize& model, const char* dir) {
+  int i;
+  ofstream outfile;
+  openFile(outfile, dir, "time");
+  outfile << "firstyear\t" << firstYear << "\nfirststep\t1\nlastyear\t"
+    << firstYear + model.numyears - 1 << "\nlaststep\t" << model.numsteps
+    << "\nnotimesteps\t" << model.numsteps;
+  for (i = 0; i < model.numsteps; i++)
+    outfile << sep << 12.0 / model.numsteps;
+  if (model.numsubsteps > 1) {
+    outfile << "\nnrofsubsteps";
+    for (i = 0; i < model.numsteps; i++)
+      outfile << sep << model.numsubsteps;
+  }
+  outfile << endl;
+  outfile.close();
+}
+
+static void writeArea(const ModelSize& model, const char* dir) {
+  int i, y, s;
+  ofstream outfile;
+  openFile(outfile, dir, "area");
+  outfile << "areas";
+  for (i = 0; i < model.numareas; i++)
+    outfile << TAB << i + 1;
+  outfile << "\nsize";
+  for (i = 0; i < model.numareas; i++)
+    outfile << TAB << 100000;
+  outfile << "\ntemperature\n";
+  for (y = 0; y < model.numyears; y++)
+    for (s = 0; s < model.numsteps; s++)
+      for (i = 0; i < model.numareas; i++)
+        outfile << firstYear + y << TAB << s + 1 << TAB << i + 1 << TAB << 5 << endl;
+  outfile.close();
+}
+
+static void writeAggregation(const ModelSize& model, const char* dir) {
+  int i;
+  ofstream outfile;
+  openFile(outfile, dir, "len.agg");
+  for (i = 0; i < model.numlengths; i++)
+    outfile << "len" << minLength + dl * i << TAB << minLength + dl * i
+      << TAB << minLength + dl * (i + 1) << endl;
+  outfile.close();
+
+  openFile(outfile, dir, "alllen.agg");
+  outfile << "alllen\t" << minLength << TAB << maxLength(model) << endl;
+  outfile.close();
+
+  openFile(outfile, dir, "age.agg");
+  for (i = 0; i < model.numages; i++)
+    outfile << "age" << i + 1 << TAB << i + 1 << endl;
+  outfile.close();
+
+  openFile(outfile, dir, "area.agg");
+  for (i = 0; i < model.numareas; i++)
+    outfile << "area" << i + 1 << TAB << i + 1 << endl;
+  outfile.close();
+}
+
+static void writeStock(const ModelSize& model, const char* dir, int stock) {
+  int i, j, y;
+  char name[MaxStrLength];
+  snprintf(name, MaxStrLength, "stock%d", stock + 1);
+  ofstream outfile;
+  openFile(outfile, dir, name);
+
+  outfile << "stockname\t" << name << "\nlivesonareas";
+  for (i = 0; i < model.numareas; i++)
+    outfile << TAB << i + 1;
+  outfile << "\nminage\t1\nmaxage\t" << model.numages << "\nminlength\t" << minLength
+    << "\nmaxlength\t" << maxLength(model) << "\ndl\t" << dl
+    << "\nrefweightfile\t" << name << ".refw\ngrowthandeatlengths\tlen.agg\n"
+    << "doesgrow\t1\ngrowthfunction\tlengthvbsimple\n"
+    << "growthparameters\t#" << name << ".linf #" << name << ".k 0.00001 3\n"
+    << "beta\t20\nmaxlengthgroupgrowth\t" << (model.numlengths > 5 ? 5 : model.numlengths - 1)
+    << "\nnaturalmortality";
+  for (i = 0; i < model.numages; i++)
+    outfile << sep << 0.2;
+  outfile << "\niseaten\t1\npreylengths\tlen.agg\n";
+
+  //the first stock is a predator on all the other stocks
+  if ((stock == 0) && (model.numstocks > 1)) {
+    outfile << "doeseat\t1\nsuitability\n";
+    for (i = 1; i < model.numstocks; i++)
+      outfile << "stock" << i + 1 << "\tfunction constant 0.5\n";
+    outfile << "preference\n";
+    for (i = 1; i < model.numstocks; i++)
+      outfile << "stock" << i + 1 << "\t1\n";
+    outfile << "maxconsumption\t0.00001 0 0 2\nhalffeedingvalue\t0.1\n";
+  } else
+    outfile << "doeseat\t0\n";
+
+  outfile << "initialconditions\nminage\t1\nmaxage\t" << model.numages
+    << "\nminlength\t" << minLength << "\nmaxlength\t" << maxLength(model)
+    << "\nnormalcondfile\t" << name << ".init\ndoesmigrate\t0\ndoesmature\t0\n"
+    << "doesmove\t0\ndoesrenew\t1\nminlength\t" << minLength << "\nmaxlength\t"
+    << maxLength(model) << "\nnormalcondfile\t" << name << ".rec\ndoesspawn\t0\n";
+  outfile.close();
+
+  ofstream subfile;
+  snprintf(name, MaxStrLength, "stock%d.refw", stock + 1);
+  openFile(subfile, dir, name);
+  for (i = 0; i <= model.numlengths; i++)
+    subfile << minLength + dl * i << TAB << 0.00001 * pow(minLength + dl * i, 3.0) << endl;
+  subfile.close();
+
+  snprintf(name, MaxStrLength, "stock%d.init", stock + 1);
+  openFile(subfile, dir, name);
+  for (i = 0; i < model.numages; i++)
+    for (j = 0; j < model.numareas; j++)
+      subfile << i + 1 << TAB << j + 1 << TAB << 10.0 * exp(-0.3 * i) << TAB << 1
+        << TAB << meanLength(model, i + 1) << TAB << stdDev(model, i + 1) << TAB << 1 << endl;
+  subfile.close();
+
+  snprintf(name, MaxStrLength, "stock%d.rec", stock + 1);
+  openFile(subfile, dir, name);
+  for (y = 0; y < model.numyears; y++)
+    for (j = 0; j < model.numareas; j++)
+      subfile << firstYear + y << TAB << 1 << TAB << j + 1 << TAB << 1 << TAB << "#stock"
+        << stock + 1 << ".rec" << TAB << meanLength(model, 1) << TAB
+        << stdDev(model, 1) << TAB << 1 << endl;
+  subfile.close();
+}
+
+static void writeFleet(const ModelSize& model, const char* dir) {
+  int i, y, s;
+  ofstream outfile;
+  openFile(outfile, dir, "fleet");
+  outfile << "[fleetcomponent]\ntotalfleet\tcomm\nlivesonareas";
+  for (i = 0; i < model.numareas; i++)
+    outfile << TAB << i + 1;
+  outfile << "\nmultiplicative\t1\nsuitability\n";
+  for (i = 0; i < model.numstocks; i++)
+    outfile << "stock" << i + 1 << "\tfunction newexponentiall50\t#comm.a\t#comm.l50\n";
+  outfile << "amount\tcatch.amount\n";
+  outfile.close();
+
+  openFile(outfile, dir, "catch.amount");
+  for (y = 0; y < model.numyears; y++)
+    for (s = 0; s < model.numsteps; s++)
+      for (i = 0; i < model.numareas; i++)
+        outfile << firstYear + y << TAB << s + 1 << TAB << i + 1 << "\tcomm\t"
+          << 200.0 * model.numstocks / model.numsteps << endl;
+  outfile.close();
+}
+
+static void writeTagging(const ModelSize& model, const char* dir) {
+  int i, t;
+  ofstream outfile, subfile;
+  openFile(outfile, dir, "tagging");
+  openFile(subfile, dir, "tag.numbers");
+  for (t = 0; t < model.numtags; t++) {
+    outfile << "[component]\ntagid\ttag" << t + 1 << "\nstock\tstock"
+      << (t % model.numstocks) + 1 << "\ntagarea\t" << (t % model.numareas) + 1
+      << "\ntagloss\t0.02\nnumbers\ttag.numbers\n";
+    for (i = model.numlengths / 3; i < (2 * model.numlengths) / 3; i++)
+      subfile << "tag" << t + 1 << TAB << firstYear + (t % model.numyears) << TAB << 1
+        << TAB << minLength + dl * i << TAB << 500 << endl;
+  }
+  outfile.close();
+  subfile.close();
+}
+
+/* the data is synthetic, with random noise around the initial population */
+static void writeCatchData(const ModelSize& model, const char* dir, const char* filename) {
+  int y, s, r, a, l;
+  ofstream outfile;
+  openFile(outfile, dir, filename);
+  for (y = 0; y < model.numyears; y++)
+    for (s = 0; s < model.numsteps; s++)
+      for (r = 0; r < model.numareas; r++)
+        for (a = 0; a < model.numages; a++)
+          for (l = 0; l < model.numlengths; l++)
+            outfile << firstYear + y << TAB << s + 1 << "\tarea" << r + 1 << "\tage"
+              << a + 1 << "\tlen" << minLength + dl * l << TAB
+              << numberAtLength(model, a + 1, l) * (0.5 + randomUniform()) << endl;
+  outfile.close();
+}
+
+static void writeSurveyData(const ModelSize& model, const char* dir, const char* filename) {
+  int y, r, a, l;
+  double number;
+  ofstream outfile;
+  openFile(outfile, dir, filename);
+  for (y = 0; y < model.numyears; y++)
+    for (r = 0; r < model.numareas; r++)
+      for (l = 0; l < model.numlengths; l++) {
+        number = 0.0;
+        for (a = 0; a < model.numages; a++)
+          number += numberAtLength(model, a + 1, l);
+        outfile << firstYear + y << "\t1\tarea" << r + 1 << "\tlen" << minLength + dl * l
+          << TAB << number * (0.5 + randomUniform()) + 1.0 << endl;
+      }
+  outfile.close();
+}
+
+static void writeRecaptureData(const ModelSize& model, const char* dir) {
+  int t, y, release;
+  ofstream outfile;
+  openFile(outfile, dir, "recaptures.data");
+  for (t = 0; t < model.numtags; t++) {
+    release = t % model.numyears;
+    for (y = release + 1; y < model.numyears; y++)
+      outfile << "tag" << t + 1 << TAB << firstYear + y << "\t1\tarea" << (t % model.numareas) + 1
+        << "\talllen\t" << (int)(50.0 * exp(-0.5 * (y - release)) * (0.5 + randomUniform())) << endl;
+  }
+  outfile.close();
+}
+
+static void writeLikelihood(const ModelSize& model, const char* dir) {
+  int i, stock;
+  char filename[MaxStrLength];
+  ofstream outfile;
+  openFile(outfile, dir, "likelihood");
+  outfile << "[component]\nname\tunderstocking\nweight\t100\ntype\tunderstocking\n";
+
+  //cycle through the component types, and the stocks for each type
+  for (i = 0; i < model.numlikelihood; i++) {
+    stock = (i % model.numstocks) + 1;
+    switch ((i / model.numstocks) % 3) {
+      case 0:
+      case 2:
+        snprintf(filename, MaxStrLength, "ldist%d.data", i + 1);
+        outfile << "[component]\nname\tldist" << i + 1 << "\nweight\t1\ntype\tcatchdistribution\n"
+          << "datafile\t" << filename << "\nfunction\t"
+          << ((i / model.numstocks) % 3 == 0 ? "sumofsquares" : "pearson")
+          << "\nareaaggfile\tarea.agg\nageaggfile\tage.agg\nlenaggfile\tlen.agg\n"
+          << "fleetnames\tcomm\nstocknames\tstock" << stock << endl;
+        writeCatchData(model, dir, filename);
+        break;
+      case 1:
+        snprintf(filename, MaxStrLength, "si%d.data", i + 1);
+        outfile << "[component]\nname\tsi" << i + 1 << "\nweight\t1\ntype\tsurveyindices\n"
+          << "datafile\t" << filename << "\nsitype\tlengths\nareaaggfile\tarea.agg\n"
+          << "lenaggfile\tlen.agg\nstocknames\tstock" << stock << "\nfittype\tfixedslopeloglinearfit\nslope\t1\n";
+        writeSurveyData(model, dir, filename);
+        break;
+    }
+  }
+
+  if (model.numtags > 0) {
+    outfile << "[component]\nname\trecaptures\nweight\t1\ntype\trecaptures\n"
+      << "datafile\trecaptures.data\nfunction\tpoisson\nareaaggfile\tarea.agg\n"
+      << "lenaggfile\talllen.agg\nfleetnames\tcomm\n";
+    writeRecaptureData(model, dir);
+  }
+  outfile.close();
+}
+
+static void writeParams(const ModelSize& model, const char* dir) {
+  int i;
+  ofstream outfile;
+  openFile(outfile, dir, "params.in");
+  outfile << "switch\tvalue\tlower\tupper\toptimise\n";
+  for (i = 0; i < model.numstocks; i++)
+    outfile << "stock" << i + 1 << ".linf\t" << linf(model) << TAB << maxLength(model)
+      << TAB << 2.0 * linf(model) << "\t1\nstock" << i + 1 << ".k\t0.3\t0.05\t1\t1\n"
+      << "stock" << i + 1 << ".rec\t5\t0.01\t100\t1\n";
+  outfile << "comm.a\t0.5\t0.01\t2\t1\ncomm.l50\t" << 0.5 * linf(model) << TAB
+    << minLength << TAB << maxLength(model) << "\t1\n";
+  outfile.close();
+}
+
+/* one optinfo file for each algorithm, all limited to the same number of evaluations */
+static void writeOptInfo(const char* dir, int numevals) {
+  int i;
+  char filename[MaxStrLength];
+  ofstream outfile;
+  for (i = 0; i < numOptNames; i++) {
+    snprintf(filename, MaxStrLength, "optinfo.%s", optNames[i]);
+    openFile(outfile, dir, filename);
+    outfile << "[" << optNames[i] << "]\n" << optNames[i] << "iter\t" << numevals << endl;
+    if (strcasecmp(optNames[i], "simann") == 0)
+      outfile << "seed\t7\n";
+    outfile.close();
+  }
+}
+
+static void generateModel(const ModelSize& model, const char* dir, int numevals) {
+  int i;
+  if ((model.numstocks < 1) || (model.numareas < 1) || (model.numlengths < 2)
+      || (model.numages < 1) || (model.numyears < 1) || (model.numsteps < 1)
+      || (model.numsubsteps < 1) || (model.numtags < 0) || (model.numlikelihood < 0))
+    failBench("invalid size for model", model.name);
+  makeDirectory(dir);
+
+  writeMain(model, dir);
+  writeTime(model, dir);
+  writeArea(model, dir);
+  writeAggregation(model, dir);
+  for (i = 0; i < model.numstocks; i++)
+    writeStock(model, dir, i);
+  writeFleet(model, dir);
+  if (model.numtags > 0)
+    writeTagging(model, dir);
+  writeLikelihood(model, dir);
+  writeParams(model, dir);
+  writeOptInfo(dir, numevals);
+}
+
+/* read the number of function evaluations from the header of the -p file */
+static int readEvaluations(const char* dir, const char* name) {
+  char filename[LongString];
+  char line[LongString];
+  int numevals = 0;
+  snprintf(filename, LongString, "%s/%s", dir, name);
+  ifstream infile(filename, ios::in);
+  while (!infile.fail() && !infile.eof()) {
+    infile.getline(line, LongString);
+    char* ptr = strstr(line, "ran for ");
+    if (ptr != NULL)
+      numevals += atoi(ptr + 8);
+  }
+  return numevals;
+}
+
+/* copy the time spent on each phase from the summary of the -profile file */
+static void readPhases(ostream& phasefile, const char* dir, const char* name,
+  const char* modelname, const char* runname) {
+
+  char filename[LongString];
+  char line[LongString];
+  char phase[MaxStrLength];
+  char object[MaxStrLength];
+  double seconds, persim, percent;
+  snprintf(filename, LongString, "%s/%s", dir, name);
+  ifstream infile(filename, ios::in);
+  if (infile.fail())
+    failBench("failed to open file", filename);
+  while (!infile.eof()) {
+    infile.getline(line, LongString);
+    if ((line[0] == chrComment) || (sscanf(line, "%128s %128s %lf %lf %lf",
+        phase, object, &seconds, &persim, &percent) != 5))
+      continue;
+    if (strcmp(object, "all") == 0)
+      phasefile << modelname << TAB << runname << TAB << phase << TAB << seconds
+        << TAB << persim << TAB << percent << endl;
+  }
+}
+
+/* time one run of gadget in the model directory, and write a line of results */
+static void timeRun(ostream& outfile, ostream& phasefile, const char* gadget, const char* dir,
+  const char* modelname, const char* runname, const char* args) {
+
+  char command[LongString];
+  snprintf(command, LongString, "cd %s && %s %s -i params.in -p params.%s -profile profile.%s > /dev/null",
+    dir, gadget, args, runname, runname);
+
+  double starttime = getTime();
+  if (system(command) != 0)
+    failBench("failed to run gadget for", command);
+  double seconds = getTime() - starttime;
+
+  char pfile[MaxStrLength];
+  snprintf(pfile, MaxStrLength, "params.%s", runname);
+  int numevals = readEvaluations(dir, pfile);
+  if (numevals == 0)
+    numevals = 1;  //a simulation run is a single function evaluation
+
+  outfile << modelname << TAB << runname << TAB << setprecision(smallprecision)
+    << seconds << TAB << numevals << TAB << numevals / seconds << endl;
+  snprintf(pfile, MaxStrLength, "profile.%s", runname);
+  readPhases(phasefile, dir, pfile, modelname, runname);
+  cout << modelname << TAB << runname << TAB << seconds << " seconds, "
+    << numevals << " evaluations\n";
+}
+
+static void runModel(ostream& outfile, ostream& phasefile, const char* gadget, const char* dir,
+  const char* modelname, const char* extra, int numevals) {
+
+  int i;
+  char args[LongString];
+  writeOptInfo(dir, numevals);
+  snprintf(args, LongString, "-s %s", extra);
+  timeRun(outfile, phasefile, gadget, dir, modelname, "simulate", args);
+  for (i = 0; i < numOptNames; i++) {
+    snprintf(args, LongString, "-l -opt optinfo.%s %s", optNames[i], extra);
+    timeRun(outfile, phasefile, gadget, dir, modelname, optNames[i], args);
+  }
+}
+
+static void writeHeader(ostream& outfile, ostream& phasefile) {
+  time_t runtime = time(NULL);
+  outfile << "; Gadget benchmark results from gadgetbench on " << ctime(&runtime)
+    << "; model\trun\tseconds\tevaluations\tevalspersec\n";
+  phasefile << "; Gadget benchmark profile from gadgetbench on " << ctime(&runtime)
+    << "; model\trun\tphase\tseconds\tpersimulation\tpercent\n";
+}
+
+static void printUsage() {
+  cout << "Usage: gadgetbench [options]\n"
+    << "Generates synthetic Gadget models and times the gadget executable on them\n"
+    << "\nOptions:\n"
+    << " -generate <dir>        generate a model in the directory <dir>\n"
+    << " -run <dir>             time the model in the directory <dir>\n"
+    << " -bench <dir>           generate and time the standard models in <dir>\n"
+    << " -size <name>           start from the standard model small, medium or large\n"
+    << " -stocks <n>            number of stocks\n"
+    << " -areas <n>             number of areas\n"
+    << " -lengths <n>           number of length groups\n"
+    << " -ages <n>              number of age groups\n"
+    << " -years <n>             number of years\n"
+    << " -steps <n>             number of timesteps in each year\n"
+    << " -substeps <n>          number of substeps in each timestep\n"
+    << " -tags <n>              number of tagging experiments\n"
+    << " -likelihood <n>        number of data likelihood components\n"
+    << " -evals <n>             maximum function evaluations for each optimiser\n"
+    << " -seed <n>              seed for the synthetic data\n"
+    << " -gadget <file>         the gadget executable to time (default ./gadget)\n"
+    << " -parallel <n>          pass -parallel <n> to the gadget executable\n"
+    << " -o <file>              write the results to <file> (default bench.out)\n"
+    << " -phases <file>         write the time for each phase to <file> (default bench.phases)\n"
+    << " -h --help              display this help screen and exit\n";
+}
+
+int main(int aNumber, char* const aVector[]) {
+
+  int i, k, numevals = 100;
+  char* gendir = NULL;
+  char* rundir = NULL;
+  char* benchdir = NULL;
+  char gadget[LongString];
+  char outname[LongString];
+  char phasename[LongString];
+  char extra[MaxStrLength];
+  strncpy(extra, "", MaxStrLength);
+  ModelSize model = benchModels[0];
+  model.name = "custom";
+
+  if (getcwd(gadget, LongString - 8) == NULL)
+    failBench("failed to find", "current directory");
+  strcat(gadget, "/gadget");
+  strncpy(outname, "bench.out", LongString);
+  strncpy(phasename, "bench.phases", LongString);
+
+  if (aNumber == 1) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  for (k = 1; k < aNumber; k++) {
+    if ((strcasecmp(aVector[k], "-h") == 0) || (strcasecmp(aVector[k], "--help") == 0)) {
+      printUsage();
+      return EXIT_SUCCESS;
+    }
+    if (k == aNumber - 1)
+      failBench("missing value for option", aVector[k]);
+    if (strcasecmp(aVector[k], "-generate") == 0)
+      gendir = aVector[++k];
+    else if (strcasecmp(aVector[k], "-run") == 0)
+      rundir = aVector[++k];
+    else if (strcasecmp(aVector[k], "-bench") == 0)
+      benchdir = aVector[++k];
+    else if (strcasecmp(aVector[k], "-size") == 0) {
+      k++;
+      for (i = 0; i < numBenchModels; i++)
+        if (strcasecmp(aVector[k], benchModels[i].name) == 0)
+          model = benchModels[i];
+      if (strcasecmp(aVector[k], model.name) != 0)
+        failBench("unrecognised model size", aVector[k]);
+    } else if (strcasecmp(aVector[k], "-stocks") == 0)
+      model.numstocks = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-areas") == 0)
+      model.numareas = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-lengths") == 0)
+      model.numlengths = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-ages") == 0)
+      model.numages = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-years") == 0)
+      model.numyears = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-steps") == 0)
+      model.numsteps = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-substeps") == 0)
+      model.numsubsteps = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-tags") == 0)
+      model.numtags = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-likelihood") == 0)
+      model.numlikelihood = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-evals") == 0)
+      numevals = atoi(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-seed") == 0)
+      randomSeed = atol(aVector[++k]);
+    else if (strcasecmp(aVector[k], "-gadget") == 0) {
+      //gadget is run from the model directory, so a relative path wont work
+      k++;
+      if (aVector[k][0] == '/')
+        strncpy(gadget, aVector[k], LongString - 1);
+      else if ((getcwd(gadget, LongString) == NULL) || (strlen(gadget) + strlen(aVector[k]) + 2 > LongString))
+        failBench("failed to find path for", aVector[k]);
+      else {
+        strcat(gadget, "/");
+        strcat(gadget, aVector[k]);
+      }
+    }
+    else if (strcasecmp(aVector[k], "-parallel") == 0)
+      snprintf(extra, MaxStrLength, "-parallel %d", atoi(aVector[++k]));
+    else if (strcasecmp(aVector[k], "-o") == 0)
+      strncpy(outname, aVector[++k], LongString - 1);
+    else if (strcasecmp(aVector[k], "-phases") == 0)
+      strncpy(phasename, aVector[++k], LongString - 1);
+    else {
+      printUsage();
+      failBench("unrecognised option", aVector[k]);
+    }
+  }
+
+  if ((randomSeed <= 0) || (randomSeed >= 2147483647))
+    failBench("seed must be between 1 and", "2147483646");
+  if ((gendir == NULL) && (rundir == NULL) && (benchdir == NULL))
+    failBench("nothing to do - specify", "-generate, -run or -bench");
+
+  if (gendir != NULL)
+    generateModel(model, gendir, numevals);
+
+  if ((rundir == NULL) && (benchdir == NULL))
+    return EXIT_SUCCESS;
+
+  ofstream outfile(outname, ios::out);
+  if (outfile.fail())
+    failBench("failed to open file", outname);
+  ofstream phasefile(phasename, ios::out);
+  if (phasefile.fail())
+    failBench("failed to open file", phasename);
+  phasefile.precision(smallprecision);
+  writeHeader(outfile, phasefile);
+
+  if (rundir != NULL)
+    runModel(outfile, phasefile, gadget, rundir, model.name, extra, numevals);
+
+  if (benchdir != NULL) {
+    char dir[LongString];
+    makeDirectory(benchdir);
+    for (i = 0; i < numBenchModels; i++) {
+      snprintf(dir, LongString, "%s/%s", benchdir, benchModels[i].name);
+      generateModel(benchModels[i], dir, numevals);
+      runModel(outfile, phasefile, gadget, dir, benchModels[i].name, extra, numevals);
+    }
+  }
+
+  outfile.close();
+  phasefile.close();
+  return EXIT_SUCCESS;
+}
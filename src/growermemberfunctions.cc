@@ -1,5 +1,6 @@
 #include "grower.h"
 #include "mathfunc.h"
+#include "vectorfunc.h"
 #include "errorhandler.h"
 #include "global.h"
 
@@ -13,6 +14,18 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
   double tmpMult = growthcalc->getMult();
   double tmpPower = growthcalc->getPower();
   double tmpDl = 1.0 / Lengths->dl();  //JMB no need to check zero here
+  int maxlgroup = Lengths->numLengthGroups() - 1;
+
+  //JMB the powers of the mean lengths are only calculated again when the power has changed
+  if (((functionnumber == 8) || (functionnumber == 10) || (functionnumber == 11))
+      && ((powLength.Size() != Lengths->numLengthGroups()) || (powPower != tmpPower))) {
+    if (powLength.Size() != Lengths->numLengthGroups()) {
+      powLength.Reset();
+      powLength.resize(Lengths->numLengthGroups(), 0.0);
+    }
+    powVector(powLength, Lengths->meanLengths(), tmpPower);
+    powPower = tmpPower;
+  }
 
   for (lgroup = 0; lgroup < Lengths->numLengthGroups(); lgroup++) {
     part3 = 1.0;
@@ -59,7 +72,7 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
       case 11:
         if (lgroup != Lengths->numLengthGroups())
           for (j = 1; j <= maxlengthgroupgrowth; j++)
-            (*wgrowth[inarea])[j][lgroup] = tmpMult * (pow(Lengths->meanLength(lgroup + j), tmpPower) - pow(Lengths->meanLength(lgroup), tmpPower));
+            (*wgrowth[inarea])[j][lgroup] = tmpMult * (powLength[min(lgroup + j, maxlgroup)] - powLength[lgroup]);
         break;
       default:
         handle.logMessage(LOGFAIL, "Error in grower - unrecognised growth function", functionnumber);
@@ -4,6 +4,7 @@
 #include "keeper.h"
 #include "readfunc.h"
 #include "readword.h"
+#include "vectorfunc.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -44,8 +45,9 @@ void GrowthCalcA::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
       (growthPar[7] * Area->getTemperature(area, TimeInfo->getTime()) + growthPar[8]);
 
   int i;
+  powVector(Lgrowth, LgrpDiv->meanLengths(), growthPar[1]);
   for (i = 0; i < Lgrowth.Size(); i++) {
-    Lgrowth[i] = tempL * pow(LgrpDiv->meanLength(i), growthPar[1]) * Fphi[i];
+    Lgrowth[i] = tempL * Lgrowth[i] * Fphi[i];
     if (Lgrowth[i] < 0.0)
       Lgrowth[i] = 0.0;
 
@@ -71,8 +73,8 @@ GrowthCalcB::GrowthCalcB(CommentStream& infile, const IntVector& Areas,
 
   int i;
   for (i = 0; i < Areas.Size(); i++) {
-    lgrowth.resize(new FormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
-    wgrowth.resize(new FormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
+    lgrowth.resize(new SparseFormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
+    wgrowth.resize(new SparseFormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
   }
 
   keeper->addString("growthcalcB");
@@ -118,8 +120,8 @@ void GrowthCalcB::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
 
   int i, inarea = this->areaNum(area);
   for (i = 0; i < Lgrowth.Size(); i++) {
-    Lgrowth[i] = (*lgrowth[inarea])[TimeInfo->getTime()][i];
-    Wgrowth[i] = (*wgrowth[inarea])[TimeInfo->getTime()][i];
+    Lgrowth[i] = lgrowth[inarea]->getValue(TimeInfo->getTime(), i);
+    Wgrowth[i] = wgrowth[inarea]->getValue(TimeInfo->getTime(), i);
     if ((handle.getLogLevel() >= LOGWARN) && ((Lgrowth[i] < 0.0) || (Wgrowth[i] < 0.0)))
       handle.logMessage(LOGWARN, "Warning in growth calculation - negative growth parameter");
   }
@@ -530,7 +532,7 @@ GrowthCalcF::GrowthCalcF(CommentStream& infile, const IntVector& Areas,
   growthPar.read(infile, TimeInfo, keeper);
 
   for (i = 0; i < Areas.Size(); i++)
-    wgrowth.resize(new FormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
+    wgrowth.resize(new SparseFormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
 
   ifstream datafile;
   CommentStream subdata(datafile);
@@ -568,7 +570,7 @@ void GrowthCalcF::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
 
   for (i = 0; i < Lgrowth.Size(); i++) {
     Lgrowth[i] = (growthPar[0] - LgrpDiv->meanLength(i)) * kval;
-    Wgrowth[i] = (*wgrowth[inarea])[t][i];
+    Wgrowth[i] = wgrowth[inarea]->getValue(t, i);
     if ((handle.getLogLevel() >= LOGWARN) && (Wgrowth[i] < 0.0))
       handle.logMessage(LOGWARN, "Warning in growth calculation - weight growth parameter is negative");
   }
@@ -594,7 +596,7 @@ GrowthCalcG::GrowthCalcG(CommentStream& infile, const IntVector& Areas,
   growthPar.read(infile, TimeInfo, keeper);
 
   for (i = 0; i < Areas.Size(); i++)
-    wgrowth.resize(new FormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
+    wgrowth.resize(new SparseFormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
 
   ifstream datafile;
   CommentStream subdata(datafile);
@@ -639,21 +641,21 @@ void GrowthCalcG::calcGrowth(int area, DoubleVector& Lgrowth, DoubleVector& Wgro
   if (isZero(growthPar[0])) {
     for (i = 0; i < Lgrowth.Size(); i++) {
       Lgrowth[i] = kval;
-      Wgrowth[i] = (*wgrowth[inarea])[t][i];
+      Wgrowth[i] = wgrowth[inarea]->getValue(t, i);
       if ((handle.getLogLevel() >= LOGWARN) && (Wgrowth[i] < 0.0))
         handle.logMessage(LOGWARN, "Warning in growth calculation - weight growth parameter is negative");
     }
   } else if (isEqual(growthPar[0], 1.0)) {
     for (i = 0; i < Lgrowth.Size(); i++) {
       Lgrowth[i] = kval * LgrpDiv->meanLength(i);
-      Wgrowth[i] = (*wgrowth[inarea])[t][i];
+      Wgrowth[i] = wgrowth[inarea]->getValue(t, i);
       if ((handle.getLogLevel() >= LOGWARN) && (Wgrowth[i] < 0.0))
         handle.logMessage(LOGWARN, "Warning in growth calculation - weight growth parameter is negative");
     }
   } else {
     for (i = 0; i < Lgrowth.Size(); i++) {
       Lgrowth[i] = kval * pow(LgrpDiv->meanLength(i), growthPar[0]);
-      Wgrowth[i] = (*wgrowth[inarea])[t][i];
+      Wgrowth[i] = wgrowth[inarea]->getValue(t, i);
       if ((handle.getLogLevel() >= LOGWARN) && (Wgrowth[i] < 0.0))
         handle.logMessage(LOGWARN, "Warning in growth calculation - weight growth parameter is negative");
     }
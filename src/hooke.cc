@@ -134,6 +134,7 @@
 #include "optinfo.h"
 #include "mathfunc.h"
 #include "doublevector.h"
+#include "doublematrix.h"
 #include "intvector.h"
 #include "errorhandler.h"
 #include "ecosystem.h"
@@ -149,16 +150,20 @@ double OptInfoHooke::bestNearby(DoubleVector& delta, DoubleVector& point, double
   int i;
   DoubleVector z(point);
 
+  //JMB if there is more than one process then look at all the coords at once
+  if (EcoSystem->numWorkers() > 1)
+    return this->parallelNearby(delta, point, prevbest, param);
+
   minf = prevbest;
   for (i = 0; i < point.Size(); i++) {
     z[param[i]] = point[param[i]] + delta[param[i]];
-    ftmp = EcoSystem->SimulateAndUpdate(z);
+    ftmp = EcoSystem->SimulateAndUpdate(z, minf);
     if (ftmp < minf) {
       minf = ftmp;
     } else {
       delta[param[i]] = 0.0 - delta[param[i]];
       z[param[i]] = point[param[i]] + delta[param[i]];
-      ftmp = EcoSystem->SimulateAndUpdate(z);
+      ftmp = EcoSystem->SimulateAndUpdate(z, minf);
       if (ftmp < minf)
         minf = ftmp;
       else
@@ -171,6 +176,85 @@ double OptInfoHooke::bestNearby(DoubleVector& delta, DoubleVector& point, double
   return minf;
 }
 
+/* given a point, look for a better one nearby, trying every coord at once  */
+/* each coord is moved on its own, first in the direction of delta and then */
+/* in the opposite direction, and then all the moves that have improved the */
+/* point are combined - if this isnt better than the best single move, then */
+/* only the best single move is kept                                        */
+double OptInfoHooke::parallelNearby(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param) {
+
+  double minf, ftmp;
+  int i, j, k, best, numchange;
+  int nvars = point.Size();
+  DoubleVector z(point);
+  DoubleVector f(nvars, 0.0);
+  DoubleMatrix trial(nvars, nvars, 0.0);
+  IntVector change(nvars, 0);
+  IntVector retry(nvars, 0);
+
+  for (i = 0; i < nvars; i++) {
+    for (j = 0; j < nvars; j++)
+      trial[i][j] = point[j];
+    trial[i][param[i]] += delta[param[i]];
+  }
+  EcoSystem->SimulateAndUpdate(trial, f);
+
+  k = 0;
+  for (i = 0; i < nvars; i++) {
+    if (f[i] < prevbest)
+      change[i] = 1;
+    else {
+      delta[param[i]] = 0.0 - delta[param[i]];
+      retry[k] = i;
+      k++;
+    }
+  }
+
+  if (k > 0) {
+    DoubleVector fretry(k, 0.0);
+    DoubleMatrix trialretry(k, nvars, 0.0);
+    for (i = 0; i < k; i++) {
+      for (j = 0; j < nvars; j++)
+        trialretry[i][j] = point[j];
+      trialretry[i][param[retry[i]]] += delta[param[retry[i]]];
+    }
+    EcoSystem->SimulateAndUpdate(trialretry, fretry);
+
+    for (i = 0; i < k; i++) {
+      f[retry[i]] = fretry[i];
+      if (fretry[i] < prevbest)
+        change[retry[i]] = 1;
+    }
+  }
+
+  minf = prevbest;
+  best = -1;
+  numchange = 0;
+  for (i = 0; i < nvars; i++) {
+    if (change[i]) {
+      z[param[i]] = point[param[i]] + delta[param[i]];
+      numchange++;
+      if (f[i] < minf) {
+        minf = f[i];
+        best = i;
+      }
+    }
+  }
+
+  if (numchange > 1) {
+    ftmp = EcoSystem->SimulateAndUpdate(z, minf);
+    if (ftmp < minf) {
+      for (i = 0; i < nvars; i++)
+        point[i] = z[i];
+      return ftmp;
+    }
+  }
+
+  if (best != -1)
+    point[param[best]] += delta[param[best]];
+  return minf;
+}
+
 void OptInfoHooke::OptimiseLikelihood() {
 
   double oldf, newf, bestf, steplength, tmp;
@@ -324,7 +408,7 @@ void OptInfoHooke::OptimiseLikelihood() {
 
       /* only move forward if this is really an improvement    */
       oldf = newf;
-      newf = EcoSystem->SimulateAndUpdate(trialx);
+      newf = EcoSystem->SimulateAndUpdate(trialx, oldf);
       if ((isEqual(newf, oldf)) || (newf > oldf)) {
         newf = oldf;  //JMB no improvement, so reset the value of newf
         break;
@@ -187,7 +187,7 @@ void InitialCond::readNumberData(CommentStream& infile, Keeper* const keeper,
 
   //initialise things
   for (areaid = 0; areaid < noareas; areaid++) {
-    initialNumber.resize(new FormulaMatrix(numage, numlen, 0.0));
+    initialNumber.resize(new SparseFormulaMatrix(numage, numlen, 0.0));
     initialPop[areaid].setToZero();
   }
 
@@ -244,7 +244,9 @@ void InitialCond::readNumberData(CommentStream& infile, Keeper* const keeper,
 
     if (keepdata == 1) {
       //initial data is required, so store it
-      infile >> (*initialNumber[areaid])[age - minage][lengthid] >> ws;
+      Formula tmpformula;
+      infile >> tmpformula >> ws;
+      initialNumber[areaid]->setFormula(age - minage, lengthid, tmpformula);
       infile >> initialPop[areaid][age][lengthid].W >> ws;
       count++;
 
@@ -573,7 +575,7 @@ void InitialCond::Initialise(AgeBandMatrixPtrVector& Alkeys) {
       maxage = initialPop[area].maxAge();
       for (age = minage; age <= maxage; age++) {
         for (l = initialPop[area].minLength(age); l < initialPop[area].maxLength(age); l++) {
-          initialPop[area][age][l].N = (*initialNumber[area])[age - minage][l];
+          initialPop[area][age][l].N = initialNumber[area]->getValue(age - minage, l);
           if (handle.getLogLevel() >= LOGWARN) {
             if (initialPop[area][age][l].N < 0.0)
               handle.logMessage(LOGWARN, "Warning in initial conditions - negative initial population for stock", this->getName());
@@ -31,6 +31,8 @@
 #include "migrationpenalty.h"
 #include "migrationproportion.h"
 #include "catchinkilos.h"
+#include "aggregatorcache.h"
+#include "profiler.h"
 #include "global.h"
 
 void Ecosystem::Initialise() {
@@ -161,6 +163,15 @@ void Ecosystem::Initialise() {
     }
   }
 
+  //JMB the observation data will not change now, so it can be shared with the worker processes
+  if (obsstore == 0) {
+    obsstore = new ObservationStore();
+    for (i = 0; i < likevec.Size(); i++)
+      likevec[i]->storeObservations(*obsstore);
+    obsstore->Freeze();
+    handle.logMessage(LOGMESSAGE, "Stored observation data for the likelihood components, number of values", (int)obsstore->getSize());
+  }
+
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in input files - no understocking likelihood component found");
   if (count > 1)
@@ -208,4 +219,43 @@ void Ecosystem::Initialise() {
         break;
     }
   }
+
+  count = aggcache.numShared();
+  if (count > 0)
+    handle.logMessage(LOGMESSAGE, "Number of aggregators shared between likelihood components and printers", count);
+
+  if (evalcache == 0) {
+    evalcache = new EvaluationCache(evalCacheSize, keeper->numVariables(), likevec.Size());
+    cachelikes.resize(likevec.Size(), 0.0);
+  }
+
+  this->compileSchedule();
+  profile.setObjects(basevec, likevec);
+
+  if (this->canStopEarly())
+    handle.logMessage(LOGMESSAGE, "The simulation can be stopped early when optimising the likelihood score");
+}
+
+void Ecosystem::compileSchedule() {
+  int i, j, time;
+
+  //JMB find the likelihood components and printers used on each timestep before the simulation starts
+  likeSchedule.Reset();
+  startPrintSchedule.Reset();
+  endPrintSchedule.Reset();
+  likeSchedule.AddRows(TimeInfo->numTotalSteps(), 0, 0);
+  startPrintSchedule.AddRows(TimeInfo->numTotalSteps(), 0, 0);
+  endPrintSchedule.AddRows(TimeInfo->numTotalSteps(), 0, 0);
+  for (i = 0; i < TimeInfo->numTotalSteps(); i++) {
+    time = i + 1;
+    for (j = 0; j < likevec.Size(); j++)
+      if (likevec[j]->isLikelihoodStep(time, TimeInfo))
+        likeSchedule[i].resize(1, j);
+    for (j = 0; j < printvec.Size(); j++) {
+      if (printvec[j]->isPrintStep(time, 1, TimeInfo))
+        startPrintSchedule[i].resize(1, j);
+      if (printvec[j]->isPrintStep(time, 0, TimeInfo))
+        endPrintSchedule[i].resize(1, j);
+    }
+  }
 }
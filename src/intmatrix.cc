@@ -119,3 +119,17 @@ void IntMatrix::setToZero() {
   for (i = 0; i < nrow; i++)
     (*v[i]).setToZero();
 }
+
+int IntMatrix::isSame(const IntMatrix& initial) const {
+  int i, j;
+  if (nrow != initial.nrow)
+    return 0;
+  for (i = 0; i < nrow; i++) {
+    if (v[i]->Size() != initial.v[i]->Size())
+      return 0;
+    for (j = 0; j < v[i]->Size(); j++)
+      if ((*v[i])[j] != (*initial.v[i])[j])
+        return 0;
+  }
+  return 1;
+}
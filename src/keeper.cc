@@ -11,17 +11,109 @@ Keeper::Keeper() {
   stack = new StrStack();
   boundsgiven = 0;
   fileopen = 0;
+  binout = 0;
+  lastflush = 0;
   numoptvar = 0;
   bestlikelihood = 0.0;
+  addrused = 0;
+  this->rebuildIndex();
 }
 
-void Keeper::keepVariable(double& value, Parameter& attr) {
+int Keeper::hashSwitch(const char* name) const {
+  int i;
+  unsigned int hash = 2166136261u;
+
+  //JMB FNV-1a hash of the switch name, ignoring the case since switch names arent case sensitive
+  for (i = 0; name[i] != '\0'; i++) {
+    hash ^= (unsigned int)tolower(name[i]);
+    hash *= 16777619u;
+  }
+  return (int)(hash & (unsigned int)(switchindex.Size() - 1));
+}
+
+int Keeper::hashAddress(const double* var) const {
+  //JMB the lowest bits of the address are the same for every double
+  size_t key = ((size_t)var) >> 3;
+  key ^= (key >> 16);
+  return (int)((unsigned int)(key * 2654435761u) & (unsigned int)(addrswitch.Size() - 1));
+}
+
+int Keeper::findSwitch(const Parameter& attr) const {
+  int pos = this->hashSwitch(attr.getName());
+  while (switchindex[pos] != -1) {
+    if (switches[switchindex[pos]] == attr)
+      return switchindex[pos];
+    pos = (pos + 1) & (switchindex.Size() - 1);
+  }
+  return -1;
+}
+
+int Keeper::findAddress(const double* var) const {
+  int pos = this->hashAddress(var);
+  while (addrswitch[pos] != -1) {
+    if ((addrswitch[pos] >= 0) && (address[addrswitch[pos]][addrslot[pos]].addr == var))
+      return pos;
+    pos = (pos + 1) & (addrswitch.Size() - 1);
+  }
+  return -1;
+}
+
+void Keeper::addAddress(int sw, int slot) {
+  //JMB keep the index of addresses less than half full
+  if (2 * (addrused + 1) > addrswitch.Size()) {
+    this->rebuildIndex();
+    return;
+  }
+
+  int pos = this->hashAddress(address[sw][slot].addr);
+  while (addrswitch[pos] >= 0)
+    pos = (pos + 1) & (addrswitch.Size() - 1);
+  if (addrswitch[pos] == -1)
+    addrused++;
+  addrswitch[pos] = sw;
+  addrslot[pos] = slot;
+}
+
+void Keeper::rebuildIndex() {
+  int i, j, pos, size;
+
+  size = 16;
+  while (size < 2 * switches.Size())
+    size *= 2;
+  switchindex.Reset();
+  switchindex.resize(size, -1);
+  for (i = 0; i < switches.Size(); i++) {
+    pos = this->hashSwitch(switches[i].getName());
+    while (switchindex[pos] != -1)
+      pos = (pos + 1) & (size - 1);
+    switchindex[pos] = i;
+  }
+
+  addrused = 0;
+  for (i = 0; i < address.Nrow(); i++)
+    addrused += address.Ncol(i);
+  size = 16;
+  while (size < 4 * addrused)
+    size *= 2;
+  addrswitch.Reset();
+  addrswitch.resize(size, -1);
+  addrslot.Reset();
+  addrslot.resize(size, -1);
+  for (i = 0; i < address.Nrow(); i++) {
+    for (j = 0; j < address.Ncol(i); j++) {
+      pos = this->hashAddress(address[i][j].addr);
+      while (addrswitch[pos] != -1)
+        pos = (pos + 1) & (size - 1);
+      addrswitch[pos] = i;
+      addrslot[pos] = j;
+    }
+  }
+}
 
-  int i, index = -1;
-  for (i = 0; i < switches.Size(); i++)
-    if (switches[i] == attr)
-      index = i;
+void Keeper::keepVariable(double& value, Parameter& attr) {
 
+  int i, index;
+  index = this->findSwitch(attr);
   if (index == -1) {
     //attr was not found -- add it to switches and values
     index = switches.Size();
@@ -39,6 +131,16 @@ void Keeper::keepVariable(double& value, Parameter& attr) {
     if (stack->getSize() != 0)
       address[index][0] = stack->sendAll();
 
+    if (2 * switches.Size() > switchindex.Size())
+      this->rebuildIndex();
+    else {
+      i = this->hashSwitch(attr.getName());
+      while (switchindex[i] != -1)
+        i = (i + 1) & (switchindex.Size() - 1);
+      switchindex[i] = index;
+      this->addAddress(index, 0);
+    }
+
   } else {
     if (value != values[index]) {
       handle.logFileMessage(LOGFAIL, "read repeated switch name but different initial value", switches[index].getName());
@@ -49,6 +151,7 @@ void Keeper::keepVariable(double& value, Parameter& attr) {
       address[index][i] = &value;
       if (stack->getSize() != 0)
         address[index][i] = stack->sendAll();
+      this->addAddress(index, i);
     }
   }
 }
@@ -56,6 +159,8 @@ void Keeper::keepVariable(double& value, Parameter& attr) {
 Keeper::~Keeper() {
   delete stack;
   if (fileopen) {
+    if (binout != 0)
+      delete binout;
     handle.Close();
     outfile.close();
     outfile.clear();
@@ -63,46 +168,45 @@ Keeper::~Keeper() {
 }
 
 void Keeper::deleteParameter(const double& var) {
-  int i, j, check;
-  check = 0;
-  for (i = 0; i < address.Nrow(); i++) {
-    for (j = 0; j < address[i].Size(); j++) {
-      if (address[i][j] == &var) {
-        check++;
-        address[i].Delete(j);
-        if (address[i].Size() == 0) {
-          //the variable we deleted was the only one with this switch
-          address.Delete(i);
-          switches.Delete(i);
-          values.Delete(i);
-          bestvalues.Delete(i);
-          opt.Delete(i);
-          lowerbds.Delete(i);
-          upperbds.Delete(i);
-          scaledvalues.Delete(i);
-          initialvalues.Delete(i);
-          i--;
-        }
-      }
-    }
-  }
-  if (check != 1)
+  int i, j, pos, slot;
+  pos = this->findAddress(&var);
+  if (pos == -1)
     handle.logMessage(LOGFAIL, "Error in keeper - failed to delete parameter");
+
+  i = addrswitch[pos];
+  slot = addrslot[pos];
+  addrswitch[pos] = -2;
+  //JMB the following addresses for this switch will move down one place
+  for (j = slot + 1; j < address.Ncol(i); j++)
+    addrslot[this->findAddress(address[i][j].addr)]--;
+  address[i].Delete(slot);
+
+  if (address[i].Size() == 0) {
+    //the variable we deleted was the only one with this switch
+    address.Delete(i);
+    switches.Delete(i);
+    values.Delete(i);
+    bestvalues.Delete(i);
+    opt.Delete(i);
+    lowerbds.Delete(i);
+    upperbds.Delete(i);
+    scaledvalues.Delete(i);
+    initialvalues.Delete(i);
+    this->rebuildIndex();
+  }
 }
 
 void Keeper::changeVariable(const double& pre, double& post) {
-  int i, j, check;
-  check = 0;
-  for (i = 0; i < address.Nrow(); i++) {
-    for (j = 0; j < address.Ncol(i); j++) {
-      if (address[i][j] == &pre) {
-        check++;
-        address[i][j] = &post;
-      }
-    }
-  }
-  if (check != 1)
+  int i, pos, slot;
+  pos = this->findAddress(&pre);
+  if (pos == -1)
     handle.logMessage(LOGFAIL, "Error in keeper - failed to change variables");
+
+  i = addrswitch[pos];
+  slot = addrslot[pos];
+  addrswitch[pos] = -2;
+  address[i][slot] = &post;
+  this->addAddress(i, slot);
 }
 
 void Keeper::clearLast() {
@@ -136,6 +240,12 @@ void Keeper::getCurrentValues(DoubleVector& val) const {
     val[i] = values[i];
 }
 
+void Keeper::getBestValues(DoubleVector& val) const {
+  int i;
+  for (i = 0; i < bestvalues.Size(); i++)
+    val[i] = bestvalues[i];
+}
+
 void Keeper::getInitialValues(DoubleVector& val) const {
   int i;
   for (i = 0; i < initialvalues.Size(); i++)
@@ -237,6 +347,26 @@ void Keeper::Update(int pos, double& value) {
     scaledvalues[pos] = value / initialvalues[pos];
 }
 
+void Keeper::setStartValues(const DoubleVector& val) {
+  int i;
+  this->Update(val);
+  //JMB the optimisation only updates the best values of the variables that are optimised
+  for (i = 0; i < bestvalues.Size(); i++)
+    bestvalues[i] = val[i];
+}
+
+void Keeper::fixVariable(int pos, double value) {
+  if ((pos < 0) || (pos >= address.Nrow()))
+    handle.logMessage(LOGFAIL, "Error in keeper - received invalid variable to fix");
+
+  if (opt[pos]) {
+    opt[pos] = 0;
+    numoptvar--;
+  }
+  bestvalues[pos] = value;
+  this->Update(pos, value);
+}
+
 void Keeper::writeBestValues() {
   int i, j = 0;
   DoubleVector tmpvec(numoptvar, 0.0);
@@ -249,7 +379,7 @@ void Keeper::writeBestValues() {
   handle.logMessage(LOGINFO, tmpvec);
 }
 
-void Keeper::openPrintFile(const char* const filename) {
+void Keeper::openPrintFile(const char* const filename, int binary) {
   if (fileopen)
     handle.logMessage(LOGFAIL, "Error in keeper - cannot open output file");
   fileopen = 1;
@@ -258,6 +388,19 @@ void Keeper::openPrintFile(const char* const filename) {
   handle.Open(filename);
   outfile << "; ";
   RUNID.Print(outfile);
+  if (binary)
+    binout = new BinaryOutput(outfile, printblocksize);
+  lastflush = time(NULL);
+}
+
+void Keeper::flushPrintFile() {
+  if (!fileopen)
+    return;
+  if (binout != 0)
+    binout->Flush();
+  else
+    outfile.flush();
+  lastflush = time(NULL);
 }
 
 void Keeper::writeInitialInformation(const LikelihoodPtrVector& likevec) {
@@ -281,31 +424,86 @@ void Keeper::writeInitialInformation(const LikelihoodPtrVector& likevec) {
 }
 
 void Keeper::writeValues(const LikelihoodPtrVector& likevec, int prec) {
+  int i;
+  DoubleVector likes(likevec.Size(), 0.0);
+  for (i = 0; i < likevec.Size(); i++)
+    likes[i] = likevec[i]->getUnweightedLikelihood();
+  this->writeValues(likevec, values, likes, EcoSystem->getLikelihood(), prec);
+}
+
+void Keeper::writeValues(const LikelihoodPtrVector& likevec, const DoubleVector& val,
+  const DoubleVector& likes, double score, int prec) {
+
   if (!fileopen)
     handle.logMessage(LOGFAIL, "Error in keeper - cannot write to output file");
 
-  //JMB - print the number of function evaluations at the start of the line
-  outfile << EcoSystem->getFuncEval() << TAB;
+  if (binout != 0) {
+    this->writeBinaryValues(likevec, val, likes, score, prec);
 
-  int i, p, w;
-  p = prec;
-  if (prec == 0)
-    p = printprecision;
-  w = p + 4;
-  for (i = 0; i < values.Size(); i++)
-    outfile << setw(w) << setprecision(p) << values[i] << sep;
+  } else {
+    //JMB - print the number of function evaluations at the start of the line
+    outfile << EcoSystem->getFuncEval() << TAB;
+
+    int i, p, w;
+    p = prec;
+    if (prec == 0)
+      p = printprecision;
+    w = p + 4;
+    for (i = 0; i < val.Size(); i++)
+      outfile << setw(w) << setprecision(p) << val[i] << sep;
+
+    if (prec == 0)
+      p = smallprecision;
+    w = p + 4;
+    outfile << TAB << TAB;
+    for (i = 0; i < likes.Size(); i++)
+      outfile << setw(w) << setprecision(p) << likes[i] << sep;
+
+    if (prec == 0)
+      p = fullprecision;
+    w = p + 4;
+    outfile << TAB << TAB << setw(w) << setprecision(p) << score << '\n';
+  }
 
-  if (prec == 0)
-    p = smallprecision;
-  w = p + 4;
-  outfile << TAB << TAB;
-  for (i = 0; i < likevec.Size(); i++)
-    outfile << setw(w) << setprecision(p) << likevec[i]->getUnweightedLikelihood() << sep;
+  //JMB - dont flush the output file for every line, since this is slow
+  if (difftime(time(NULL), lastflush) >= printflushtime)
+    this->flushPrintFile();
+}
+
+void Keeper::writeBinaryValues(const LikelihoodPtrVector& likevec, const DoubleVector& val,
+  const DoubleVector& likes, double score, int prec) {
+
+  int i, p;
+  if (binout->numColumns() == 0) {
+    //first time this is called, so set up the columns to match the text output
+    //JMB the text output has no width for funceval, and tabs between the blocks of columns
+    binout->addColumn("funceval", INTCOLUMN, 0, 0);
+    binout->setSeparator("\t");
+    p = prec;
+    if (prec == 0)
+      p = printprecision;
+    for (i = 0; i < val.Size(); i++)
+      binout->addColumn(switches[i].getName(), DOUBLECOLUMN, p + 4, p);
+    binout->setSeparator(" \t\t");
+
+    if (prec == 0)
+      p = smallprecision;
+    for (i = 0; i < likevec.Size(); i++)
+      binout->addColumn(likevec[i]->getName(), DOUBLECOLUMN, p + 4, p);
+    //JMB with no likelihood components both blocks of tabs follow the last parameter
+    binout->setSeparator(likevec.Size() == 0 ? " \t\t\t\t" : " \t\t");
+
+    if (prec == 0)
+      p = fullprecision;
+    binout->addColumn("likelihood", DOUBLECOLUMN, p + 4, p);
+  }
 
-  if (prec == 0)
-    p = fullprecision;
-  w = p + 4;
-  outfile << TAB << TAB << setw(w) << setprecision(p) << EcoSystem->getLikelihood() << endl;
+  binout->storeInt(EcoSystem->getFuncEval());
+  for (i = 0; i < val.Size(); i++)
+    binout->storeDouble(val[i]);
+  for (i = 0; i < likes.Size(); i++)
+    binout->storeDouble(likes[i]);
+  binout->storeDouble(score);
 }
 
 void Keeper::Update(const StochasticData* const Stoch) {
@@ -320,33 +518,32 @@ void Keeper::Update(const StochasticData* const Stoch) {
     IntVector match(Stoch->numVariables(), 0);
     IntVector found(switches.Size(), 0);
     for (i = 0; i < Stoch->numVariables(); i++) {
-      for (j = 0; j < switches.Size(); j++) {
-        if (Stoch->getSwitch(i) == switches[j]) {
-          values[j] = Stoch->getValue(i);
-          bestvalues[j] = Stoch->getValue(i);
-
-          if (!boundsgiven) {
-            //JMB we are going to optimise all variables
-            opt[j] = 1;
-          } else {
-            lowerbds[j] = Stoch->getLowerBound(i);
-            upperbds[j] = Stoch->getUpperBound(i);
-            opt[j] = Stoch->getOptFlag(i);
-            if (opt[j])
-              numoptvar++;
-          }
-
-          if (isZero(initialvalues[j])) {
-            if (opt[j])
-              handle.logMessage(LOGWARN, "Warning in keeper - cannot scale switch with initial value zero", switches[j].getName());
-
-            scaledvalues[j] = values[j];
-          } else
-            scaledvalues[j] = values[j] / initialvalues[j];
-
-          match[i]++;
-          found[j]++;
+      j = this->findSwitch(Stoch->getSwitch(i));
+      if (j != -1) {
+        values[j] = Stoch->getValue(i);
+        bestvalues[j] = Stoch->getValue(i);
+
+        if (!boundsgiven) {
+          //JMB we are going to optimise all variables
+          opt[j] = 1;
+        } else {
+          lowerbds[j] = Stoch->getLowerBound(i);
+          upperbds[j] = Stoch->getUpperBound(i);
+          opt[j] = Stoch->getOptFlag(i);
+          if (opt[j])
+            numoptvar++;
         }
+
+        if (isZero(initialvalues[j])) {
+          if (opt[j])
+            handle.logMessage(LOGWARN, "Warning in keeper - cannot scale switch with initial value zero", switches[j].getName());
+
+          scaledvalues[j] = values[j];
+        } else
+          scaledvalues[j] = values[j] / initialvalues[j];
+
+        match[i]++;
+        found[j]++;
       }
     }
 
@@ -0,0 +1,299 @@
+#include "errorhandler.h"
+#include "optinfo.h"
+#include "mathfunc.h"
+#include "doublematrix.h"
+#include "ecosystem.h"
+#include "gadget.h"
+#include "global.h"
+
+/* JMB this is a limited memory version of the BFGS algorithm that keeps */
+/* the parameters within the bounds.  The search direction is calculated */
+/* from the last lbfgsmem changes to the point and the gradient, rather  */
+/* than from a dense approximation to the inverse Hessian matrix         */
+
+extern Ecosystem* EcoSystem;
+
+/* calculate the gradient of a function at a given point                    */
+/* based on the forward difference gradient approximation (A5.6.3 FDGRAD)   */
+/* Numerical Methods for Unconstrained Optimization and Nonlinear Equations */
+/* by J E Dennis and Robert B Schnabel, published by SIAM, 1996             */
+void OptInfoLBFGS::gradient(DoubleVector& point, double pointvalue, DoubleVector& newgrad, const DoubleVector& upperb) {
+
+  int i, j;
+  int nvars = point.Size();
+  DoubleVector tmpacc(nvars, 0.0);
+  DoubleVector ftmp(nvars, 0.0);
+  DoubleMatrix gtmp(nvars, nvars, 0.0);
+
+  for (i = 0; i < nvars; i++) {
+    for (j = 0; j < nvars; j++)
+      gtmp[i][j] = point[j];
+
+    tmpacc[i] = gradacc * max(fabs(point[i]), 1.0);
+    //JMB use a backward difference if the forward difference would be outside the bounds
+    if ((point[i] + tmpacc[i]) > upperb[i])
+      tmpacc[i] = 0.0 - tmpacc[i];
+    gtmp[i][i] += tmpacc[i];
+  }
+
+  //JMB the points are independent, so they can be calculated in parallel
+  EcoSystem->SimulateAndUpdate(gtmp, ftmp);
+  for (i = 0; i < nvars; i++)
+    newgrad[i] = (ftmp[i] - pointvalue) / tmpacc[i];
+}
+
+/* calculate the search direction using the two-loop recursion, given by */
+/* Jorge Nocedal and Stephen J Wright, ''Numerical Optimization''        */
+/* (algorithm 7.4) published by Springer, only using the free parameters */
+void OptInfoLBFGS::calcSearch(const DoubleVector& grad, const IntVector& isfree, DoubleVector& search,
+  const DoubleMatrix& s, const DoubleMatrix& y, const DoubleVector& rho, int numstored, int last) {
+
+  int i, j, k;
+  double tmp, sy, yy;
+  int nvars = grad.Size();
+  DoubleVector alpha(rho.Size(), 0.0);
+
+  for (i = 0; i < nvars; i++)
+    search[i] = (isfree[i] ? grad[i] : 0.0);
+
+  k = last;
+  for (j = 0; j < numstored; j++) {
+    tmp = 0.0;
+    for (i = 0; i < nvars; i++)
+      if (isfree[i])
+        tmp += s[k][i] * search[i];
+    alpha[k] = rho[k] * tmp;
+    for (i = 0; i < nvars; i++)
+      if (isfree[i])
+        search[i] -= alpha[k] * y[k][i];
+    k = (k == 0 ? rho.Size() - 1 : k - 1);
+  }
+
+  //JMB scale the initial approximation to the inverse Hessian matrix using the most recent change
+  if (numstored > 0) {
+    sy = yy = 0.0;
+    for (i = 0; i < nvars; i++) {
+      sy += s[last][i] * y[last][i];
+      yy += y[last][i] * y[last][i];
+    }
+    if (!(isZero(yy)))
+      for (i = 0; i < nvars; i++)
+        search[i] *= (sy / yy);
+  }
+
+  for (j = 0; j < numstored; j++) {
+    k = (k == rho.Size() - 1 ? 0 : k + 1);
+    tmp = 0.0;
+    for (i = 0; i < nvars; i++)
+      if (isfree[i])
+        tmp += y[k][i] * search[i];
+    tmp *= rho[k];
+    for (i = 0; i < nvars; i++)
+      if (isfree[i])
+        search[i] += s[k][i] * (alpha[k] - tmp);
+  }
+
+  for (i = 0; i < nvars; i++)
+    search[i] = 0.0 - search[i];
+}
+
+void OptInfoLBFGS::OptimiseLikelihood() {
+
+  double newf, tmpf, betan, searchgrad, normgrad, sy, yy, tmp;
+  int i, k, offset, armijo, resetgrad, numstored, last;
+
+  handle.logMessage(LOGINFO, "\nStarting L-BFGS-B optimisation algorithm\n");
+  int nvars = EcoSystem->numOptVariables();
+  DoubleVector x(nvars);
+  DoubleVector trialx(nvars);
+  DoubleVector bestx(nvars);
+  DoubleVector init(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector grad(nvars, 0.0);
+  DoubleVector newgrad(nvars, 0.0);
+  DoubleVector search(nvars, 0.0);
+  DoubleVector rho(lbfgsmem, 0.0);
+  DoubleMatrix s(lbfgsmem, nvars, 0.0);
+  DoubleMatrix y(lbfgsmem, nvars, 0.0);
+  IntVector isfree(nvars, 1);
+
+  EcoSystem->scaleVariables();  //JMB need to scale variables
+  EcoSystem->getOptScaledValues(x);
+  EcoSystem->getOptInitialValues(init);
+  EcoSystem->getOptLowerBounds(lowerb);
+  EcoSystem->getOptUpperBounds(upperb);
+
+  for (i = 0; i < nvars; i++) {
+    // Scaling the bounds, because the parameters are scaled
+    lowerb[i] = lowerb[i] / init[i];
+    upperb[i] = upperb[i] / init[i];
+    if (lowerb[i] > upperb[i]) {
+      tmp = lowerb[i];
+      lowerb[i] = upperb[i];
+      upperb[i] = tmp;
+    }
+
+    //JMB make sure that the starting point is within the bounds
+    if (x[i] < lowerb[i])
+      x[i] = lowerb[i];
+    else if (x[i] > upperb[i])
+      x[i] = upperb[i];
+    bestx[i] = x[i];
+  }
+
+  newf = EcoSystem->SimulateAndUpdate(x);
+  if (newf != newf) { // check for NaN
+    handle.logMessage(LOGINFO, "Error starting L-BFGS-B optimisation with f(x) = infinity");
+    converge = -1;
+    iters = 1;
+    return;
+  }
+
+  this->gradient(x, newf, grad, upperb);
+  offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
+  resetgrad = 0;
+  numstored = 0;
+  last = lbfgsmem - 1;
+
+  while (1) {
+    iters = EcoSystem->getFuncEval() - offset;
+    if (isZero(newf)) {
+      handle.logMessage(LOGINFO, "Error in L-BFGS-B optimisation after", iters, "function evaluations, f(x) = 0");
+      converge = -1;
+      return;
+    }
+
+    // terminate the algorithm if too many function evaluations occur
+    if (iters > lbfgsiter) {
+      handle.logMessage(LOGINFO, "\nStopping L-BFGS-B optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+      handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nL-BFGS-B finished with a likelihood score of", score);
+      return;
+    }
+
+    if (resetgrad) {
+      // terminate the algorithm if the gradient accuracy required has got too small
+      if (gradacc < gradeps) {
+        handle.logMessage(LOGINFO, "\nStopping L-BFGS-B optimisation algorithm\n");
+        handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+        handle.logMessage(LOGINFO, "The optimisation stopped because the accuracy required for the gradient");
+        handle.logMessage(LOGINFO, "calculation is too small and NOT because an optimum was found for this run");
+
+        converge = 2;
+        score = EcoSystem->SimulateAndUpdate(bestx);
+        handle.logMessage(LOGINFO, "\nL-BFGS-B finished with a likelihood score of", score);
+        return;
+      }
+
+      resetgrad = 0;
+      // make the step size when calculating the gradient smaller
+      gradacc *= gradstep;
+      handle.logMessage(LOGINFO, "Warning in L-BFGS-B - resetting search algorithm after", iters, "function evaluations");
+      numstored = 0;
+      this->gradient(x, newf, grad, upperb);
+    }
+
+    //JMB parameters at a bound that the gradient would move outside the bounds are held fixed
+    normgrad = 0.0;
+    for (i = 0; i < nvars; i++) {
+      isfree[i] = 1;
+      if ((x[i] < lowerb[i] || isEqual(x[i], lowerb[i])) && (grad[i] > 0.0))
+        isfree[i] = 0;
+      if ((x[i] > upperb[i] || isEqual(x[i], upperb[i])) && (grad[i] < 0.0))
+        isfree[i] = 0;
+      if (isfree[i])
+        normgrad += grad[i] * grad[i];
+    }
+    normgrad = sqrt(normgrad);
+
+    // terminate the algorithm if the convergence criteria has been met
+    if ((normgrad / (1.0 + newf)) < lbfgseps) {
+      handle.logMessage(LOGINFO, "\nStopping L-BFGS-B optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The optimisation stopped because an optimum was found for this run");
+
+      converge = 1;
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nL-BFGS-B finished with a likelihood score of", score);
+      return;
+    }
+
+    this->calcSearch(grad, isfree, search, s, y, rho, numstored, last);
+    searchgrad = 0.0;
+    for (i = 0; i < nvars; i++)
+      searchgrad += (grad[i] * search[i]);
+
+    //JMB if this isnt a descent direction then use the steepest descent direction
+    if ((searchgrad > 0.0) || (isZero(searchgrad))) {
+      numstored = 0;
+      this->calcSearch(grad, isfree, search, s, y, rho, numstored, last);
+    }
+
+    // do armijo calculation along the search direction projected onto the bounds
+    armijo = 0;
+    betan = step;
+    while ((armijo == 0) && (betan > rathersmall)) {
+      searchgrad = 0.0;
+      for (i = 0; i < nvars; i++) {
+        trialx[i] = x[i] + (betan * search[i]);
+        if (trialx[i] < lowerb[i])
+          trialx[i] = lowerb[i];
+        else if (trialx[i] > upperb[i])
+          trialx[i] = upperb[i];
+        searchgrad += grad[i] * (trialx[i] - x[i]);
+      }
+
+      if (searchgrad < 0.0) {
+        tmpf = EcoSystem->SimulateAndUpdate(trialx, newf);
+        if ((newf > tmpf) && ((newf - tmpf) > (0.0 - sigma * searchgrad)))
+          armijo = 1;
+      }
+      if (!armijo)
+        betan *= beta;
+    }
+
+    if (!armijo) {
+      resetgrad = 1;
+      continue;
+    }
+
+    this->gradient(trialx, tmpf, newgrad, upperb);
+
+    //JMB only store the changes if the curvature condition is met
+    sy = yy = 0.0;
+    for (i = 0; i < nvars; i++) {
+      sy += (trialx[i] - x[i]) * (newgrad[i] - grad[i]);
+      yy += (newgrad[i] - grad[i]) * (newgrad[i] - grad[i]);
+    }
+    if ((sy > verysmall) && (sy > rathersmall * yy)) {
+      k = (last == lbfgsmem - 1 ? 0 : last + 1);
+      for (i = 0; i < nvars; i++) {
+        s[k][i] = trialx[i] - x[i];
+        y[k][i] = newgrad[i] - grad[i];
+      }
+      rho[k] = 1.0 / sy;
+      last = k;
+      if (numstored < lbfgsmem)
+        numstored++;
+    }
+
+    newf = tmpf;
+    for (i = 0; i < nvars; i++) {
+      x[i] = trialx[i];
+      grad[i] = newgrad[i];
+      bestx[i] = x[i];
+      trialx[i] = x[i] * init[i];
+    }
+
+    iters = EcoSystem->getFuncEval() - offset;
+    EcoSystem->storeVariables(newf, trialx);
+    handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+    handle.logMessage(LOGINFO, "The likelihood score is", newf, "at the point");
+    EcoSystem->writeBestValues();
+  }
+}
@@ -197,6 +197,18 @@ void LengthGroupDivision::Print(ofstream& outfile) const {
   outfile << maxlen << endl;
 }
 
+int LengthGroupDivision::isSame(const LengthGroupDivision* const lgrpdiv) const {
+  int i;
+  if (size != lgrpdiv->size)
+    return 0;
+  for (i = 0; i < size; i++)
+    if (!(isEqual(minlength[i], lgrpdiv->minlength[i])) || !(isEqual(meanlength[i], lgrpdiv->meanlength[i])))
+      return 0;
+  if (!(isEqual(maxlen, lgrpdiv->maxlen)))
+    return 0;
+  return 1;
+}
+
 void LengthGroupDivision::printError() const {
   handle.logMessage(LOGWARN, "Minimum length of length group division is", this->minLength());
   handle.logMessage(LOGWARN, "Maximum length of length group division is", this->maxLength());
@@ -0,0 +1,311 @@
+#include "likelihoodprofile.h"
+#include "localworkerpool.h"
+#include "errorhandler.h"
+#include "ecosystem.h"
+#include "runid.h"
+#include "gadget.h"
+#include "global.h"
+
+extern Ecosystem* EcoSystem;
+
+LikelihoodProfile::LikelihoodProfile(CommentStream& infile) {
+
+  int i, j, pos;
+  double lo, hi, step;
+  Parameter sw;
+
+  numvar = EcoSystem->numVariables();
+  numlike = EcoSystem->getModelLikelihoodVector().Size();
+  ParameterVector modelswitches(numvar);
+  DoubleVector values(numvar, 0.0);
+  EcoSystem->getSwitches(modelswitches);
+  EcoSystem->getCurrentValues(values);
+
+  //each line contains the name of the switch, the lowest and highest values and the number of values
+  infile >> ws;
+  while (!infile.eof()) {
+    infile >> sw >> lo >> hi >> i >> ws;
+    pos = -1;
+    for (j = 0; j < numvar; j++)
+      if (modelswitches[j] == sw)
+        pos = j;
+    if (pos == -1)
+      handle.logFileMessage(LOGFAIL, "unrecognised switch", sw.getName());
+    for (j = 0; j < switchpos.Size(); j++)
+      if (switchpos[j] == pos)
+        handle.logFileMessage(LOGFAIL, "repeated switch", sw.getName());
+    if (i < 1)
+      handle.logFileMessage(LOGFAIL, "number of values must be positive", i);
+    if (hi < lo)
+      handle.logFileMessage(LOGFAIL, "highest value is less than lowest value for switch", sw.getName());
+
+    switches.resize(sw);
+    switchpos.resize(1, pos);
+    lower.resize(1, lo);
+    upper.resize(1, hi);
+    numvalues.resize(1, i);
+  }
+
+  if (switches.Size() == 0)
+    handle.logFileMessage(LOGFAIL, "\nError in likelihood profile - failed to read switches");
+  if (switches.Size() > 2)
+    handle.logFileMessage(LOGFAIL, "\nError in likelihood profile - can only calculate the profile for one or two switches");
+
+  numpoints = 1;
+  for (i = 0; i < numvalues.Size(); i++)
+    numpoints *= numvalues[i];
+  handle.logMessage(LOGMESSAGE, "Read likelihood profile file - number of grid points", numpoints);
+
+  //JMB start from the grid point that is closest to the initial values of the switches
+  startpoint = 0;
+  for (i = 0; i < switches.Size(); i++) {
+    j = 0;
+    if (numvalues[i] > 1) {
+      step = (upper[i] - lower[i]) / (numvalues[i] - 1);
+      if (step > verysmall)
+        j = (int)floor(((values[switchpos[i]] - lower[i]) / step) + 0.5);
+      if (j < 0)
+        j = 0;
+      if (j >= numvalues[i])
+        j = numvalues[i] - 1;
+    }
+    startpoint = (startpoint * numvalues[i]) + j;
+  }
+
+  status.resize(numpoints, 0);
+  startfrom.resize(numpoints, -1);
+  results.AddRows(numpoints, numlike + 2, 0.0);
+  optvalues.AddRows(numpoints, numvar, 0.0);
+}
+
+LikelihoodProfile::~LikelihoodProfile() {
+}
+
+int LikelihoodProfile::getGridIndex(int sw, int point) const {
+  int i;
+  //JMB the grid points are ordered with the values of the last switch changing fastest
+  for (i = switches.Size() - 1; i > sw; i--)
+    point /= numvalues[i];
+  return point % numvalues[sw];
+}
+
+double LikelihoodProfile::getGridValue(int sw, int point) const {
+  if (numvalues[sw] == 1)
+    return lower[sw];
+  return lower[sw] + (upper[sw] - lower[sw]) * getGridIndex(sw, point) / (numvalues[sw] - 1);
+}
+
+int LikelihoodProfile::getDistance(int point) const {
+  int i, dist = 0;
+  for (i = 0; i < switches.Size(); i++)
+    dist += abs(this->getGridIndex(i, point) - this->getGridIndex(i, startpoint));
+  return dist;
+}
+
+int LikelihoodProfile::findNeighbour(int point) const {
+  int i, j, stride;
+
+  //JMB move one step towards the starting point, changing the value of the last switch first
+  stride = 1;
+  for (i = switches.Size() - 1; i >= 0; i--) {
+    j = this->getGridIndex(i, point) - this->getGridIndex(i, startpoint);
+    if (j > 0)
+      return point - stride;
+    if (j < 0)
+      return point + stride;
+    stride *= numvalues[i];
+  }
+  return -1;
+}
+
+void LikelihoodProfile::Optimise(int numworkers) {
+  int i, j, point, next, start, dist, bestdist, done, num;
+  int fromchild[2];
+  pid_t pid;
+
+  if (numworkers < 1)
+    numworkers = 1;
+  if (numworkers > numpoints)
+    numworkers = numpoints;
+
+  //each process is used for one grid point, and returns the number of function evaluations, the overall
+  //likelihood score, the scores from each likelihood component and the optimised values of the parameters
+  IntVector pids(numworkers, 0);
+  IntVector receivefd(numworkers, -1);
+  IntVector points(numworkers, -1);
+  DoubleVector receivedata(numlike + numvar + 2, 0.0);
+  struct pollfd* fds = new struct pollfd[numworkers];
+
+  handle.logMessage(LOGINFO, "\nCalculating the likelihood profile for", numpoints, "grid points");
+  //JMB the grid point processes get a copy of anything that is still buffered
+  cout.flush();
+  cerr.flush();
+
+  done = 0;
+  while (done < numpoints) {
+    //start the next grid point on any process that is free
+    for (i = 0; i < numworkers; i++) {
+      if (points[i] != -1)
+        continue;
+
+      //JMB choose the waiting grid point closest to the starting point once its neighbour has finished
+      next = -1;
+      bestdist = 0;
+      for (point = 0; point < numpoints; point++) {
+        j = this->findNeighbour(point);
+        if ((status[point] != 0) || ((j != -1) && (status[j] < 2)))
+          continue;
+        dist = this->getDistance(point);
+        if ((next == -1) || (dist < bestdist)) {
+          next = point;
+          bestdist = dist;
+        }
+      }
+      if (next == -1)
+        break;
+
+      //JMB if the optimisation failed for the neighbour then start from the initial values
+      start = this->findNeighbour(next);
+      if ((start != -1) && (status[start] != 2))
+        start = -1;
+
+      if (pipe(fromchild) != 0)
+        handle.logMessage(LOGFAIL, "Error in likelihood profile - failed to create pipe for grid point process");
+
+      pid = fork();
+      if (pid < 0)
+        handle.logMessage(LOGFAIL, "Error in likelihood profile - failed to create grid point process");
+
+      if (pid == 0) {
+        //this is the grid point process, so close the pipes used by the other grid points
+        for (j = 0; j < numworkers; j++)
+          if (points[j] != -1)
+            close(receivefd[j]);
+        close(fromchild[0]);
+        this->runPoint(next, start, fromchild[1]);
+      }
+
+      close(fromchild[1]);
+      pids[i] = (int)pid;
+      receivefd[i] = fromchild[0];
+      points[i] = next;
+      status[next] = 1;
+      startfrom[next] = start;
+      handle.logMessage(LOGMESSAGE, "Started optimising grid point", next + 1);
+    }
+
+    for (i = 0; i < numworkers; i++) {
+      fds[i].fd = receivefd[i];
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+    }
+
+    num = poll(fds, numworkers, -1);
+    if ((num < 0) && (errno == EINTR))
+      continue;  //JMB the user has interrupted gadget, so try again
+    if (num < 0)
+      handle.logMessage(LOGFAIL, "Error in likelihood profile - failed to wait for grid point processes");
+
+    for (i = 0; i < numworkers; i++) {
+      if ((points[i] == -1) || (fds[i].revents == 0))
+        continue;
+
+      point = points[i];
+      if (LocalWorkerPool::readData(receivefd[i], &receivedata[0], numlike + numvar + 2)) {
+        for (j = 0; j < numlike + 2; j++)
+          results[point][j] = receivedata[j];
+        for (j = 0; j < numvar; j++)
+          optvalues[point][j] = receivedata[j + numlike + 2];
+        status[point] = 2;
+        handle.logMessage(LOGINFO, "Finished optimising grid point", point + 1);
+      } else {
+        status[point] = 3;
+        handle.logMessage(LOGWARN, "Warning in likelihood profile - failed to optimise grid point", point + 1);
+      }
+
+      close(receivefd[i]);
+      waitpid((pid_t)pids[i], NULL, 0);
+      receivefd[i] = -1;
+      points[i] = -1;
+      done++;
+    }
+  }
+  delete[] fds;
+}
+
+void LikelihoodProfile::runPoint(int point, int start, int outfile) {
+  int i;
+  DoubleVector likes(numlike, 0.0);
+  DoubleVector values(numvar, 0.0);
+  DoubleVector outdata(numlike + numvar + 2, 0.0);
+
+  //JMB the main process deals with any interrupts from the user, and any logging
+  signal(SIGINT, SIG_IGN);
+  signal(SIGTSTP, SIG_IGN);
+  handle.setLogLevel(LOGFAIL);
+
+  //JMB start from the optimum found for the neighbouring grid point
+  if (start != -1)
+    EcoSystem->setStartValues(optvalues[start]);
+  for (i = 0; i < switches.Size(); i++)
+    EcoSystem->fixVariable(switchpos[i], this->getGridValue(i, point));
+
+  EcoSystem->Optimise();
+  outdata[0] = EcoSystem->getFuncEval();
+  outdata[1] = EcoSystem->getOptLikelihoods(likes);
+  EcoSystem->getBestValues(values);
+  for (i = 0; i < numlike; i++)
+    outdata[i + 2] = likes[i];
+  for (i = 0; i < numvar; i++)
+    outdata[i + numlike + 2] = values[i];
+
+  LocalWorkerPool::writeData(outfile, &outdata[0], numlike + numvar + 2);
+
+  //JMB use _exit so that the output buffers copied from the main process are not written
+  close(outfile);
+  _exit(EXIT_SUCCESS);
+}
+
+void LikelihoodProfile::writeProfile(const char* const filename, const LikelihoodPtrVector& likevec, int prec) {
+  int i, j, p;
+  ofstream outfile;
+  outfile.open(filename, ios::out);
+  handle.checkIfFailure(outfile, filename);
+  handle.Open(filename);
+
+  p = prec;
+  if (prec == 0)
+    p = largeprecision;
+
+  RUNID.Print(outfile);
+  outfile << "; Likelihood profile with the other parameters optimised at each grid point\n"
+    << "; -- data --\n;";
+  for (i = 0; i < switches.Size(); i++)
+    outfile << sep << switches[i].getName();
+  outfile << " start evaluations score";
+  for (i = 0; i < likevec.Size(); i++)
+    outfile << sep << likevec[i]->getName();
+  outfile << endl;
+
+  for (i = 0; i < numpoints; i++) {
+    for (j = 0; j < switches.Size(); j++) {
+      if (j > 0)
+        outfile << sep;
+      outfile << setprecision(p) << this->getGridValue(j, i);
+    }
+    outfile << sep << startfrom[i] + 1;
+
+    if (status[i] != 2) {
+      outfile << sep << "failed" << endl;
+      continue;
+    }
+
+    outfile << sep << (int)results[i][0] << sep << setprecision(largeprecision) << results[i][1];
+    for (j = 0; j < numlike; j++)
+      outfile << sep << setprecision(largeprecision) << results[i][j + 2];
+    outfile << endl;
+  }
+  handle.Close();
+  outfile.close();
+  outfile.clear();
+}
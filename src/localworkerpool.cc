@@ -0,0 +1,186 @@
+#include "localworkerpool.h"
+#include "errorhandler.h"
+#include "ecosystem.h"
+#include "gadget.h"
+#include "global.h"
+
+extern Ecosystem* EcoSystem;
+
+LocalWorkerPool::LocalWorkerPool(int workers, int nvar, int nlike)
+  : WorkerPool(workers, nvar, nlike) {
+
+  int i, j;
+  int tochild[2], fromchild[2];
+  pid_t pid;
+
+  //each point is sent as the id and the values, and returned as the id,
+  //the overall likelihood score and the scores from each likelihood component
+  senddata.resize(numvar + 1, 0.0);
+  receivedata.resize(numlike + 2, 0.0);
+
+  //JMB the worker processes get a copy of anything that is still buffered
+  cout.flush();
+  cerr.flush();
+  //JMB a worker that has stopped is reported, rather than killing the model
+  signal(SIGPIPE, SIG_IGN);
+
+  for (i = 0; i < numworkers; i++) {
+    if ((pipe(tochild) != 0) || (pipe(fromchild) != 0))
+      handle.logMessage(LOGFAIL, "Error in workerpool - failed to create pipes for worker process");
+
+    pid = fork();
+    if (pid < 0)
+      handle.logMessage(LOGFAIL, "Error in workerpool - failed to create worker process");
+
+    if (pid == 0) {
+      //this is the worker process, so close the pipes used by the other workers
+      for (j = 0; j < i; j++) {
+        close(sendfd[j]);
+        close(receivefd[j]);
+      }
+      close(tochild[1]);
+      close(fromchild[0]);
+      this->runWorker(tochild[0], fromchild[1]);
+    }
+
+    close(tochild[0]);
+    close(fromchild[1]);
+    pids.resize(1, (int)pid);
+    sendfd.resize(1, tochild[1]);
+    receivefd.resize(1, fromchild[0]);
+  }
+}
+
+LocalWorkerPool::~LocalWorkerPool() {
+  int i;
+  //JMB the workers will stop when the pipe they read from has been closed
+  for (i = 0; i < pids.Size(); i++)
+    close(sendfd[i]);
+  for (i = 0; i < pids.Size(); i++) {
+    close(receivefd[i]);
+    waitpid((pid_t)pids[i], NULL, 0);
+  }
+}
+
+void LocalWorkerPool::runWorker(int infile, int outfile) {
+  int i;
+  DoubleVector point(numvar, 0.0);
+  DoubleVector likes(numlike, 0.0);
+  DoubleVector indata(numvar + 1, 0.0);
+  DoubleVector outdata(numlike + 2, 0.0);
+
+  //JMB the main process deals with any interrupts from the user, and any logging
+  signal(SIGINT, SIG_IGN);
+  signal(SIGTSTP, SIG_IGN);
+  handle.setLogLevel(LOGFAIL);
+
+  while (this->readData(infile, &indata[0], numvar + 1)) {
+    for (i = 0; i < numvar; i++)
+      point[i] = indata[i + 1];
+
+    outdata[0] = indata[0];
+    outdata[1] = EcoSystem->SimulateValues(point, likes);
+    for (i = 0; i < numlike; i++)
+      outdata[i + 2] = likes[i];
+
+    if (!this->writeData(outfile, &outdata[0], numlike + 2))
+      break;
+  }
+
+  //JMB use _exit so that the output buffers copied from the main process are not written
+  close(infile);
+  close(outfile);
+  _exit(EXIT_SUCCESS);
+}
+
+void LocalWorkerPool::sendPoint(int worker, int id, const DoubleVector& point) {
+  int i;
+  senddata[0] = id;
+  for (i = 0; i < numvar; i++)
+    senddata[i + 1] = point[i];
+  if (!this->writeData(sendfd[worker], &senddata[0], numvar + 1))
+    handle.logMessage(LOGFAIL, "Error in workerpool - failed to send data to worker process");
+}
+
+void LocalWorkerPool::evaluatePoints(const DoubleMatrix& points, DoubleMatrix& results) {
+  int i, j, id, next, done, num;
+  IntVector busy(numworkers, 0);
+  struct pollfd* fds = new struct pollfd[numworkers];
+
+  //start by sending one point to each worker
+  next = 0;
+  for (i = 0; ((i < numworkers) && (next < points.Nrow())); i++) {
+    this->sendPoint(i, next, points[next]);
+    busy[i] = 1;
+    next++;
+  }
+
+  done = 0;
+  while (done < points.Nrow()) {
+    for (i = 0; i < numworkers; i++) {
+      fds[i].fd = receivefd[i];
+      fds[i].events = (busy[i] ? POLLIN : 0);
+      fds[i].revents = 0;
+    }
+
+    num = poll(fds, numworkers, -1);
+    if ((num < 0) && (errno == EINTR))
+      continue;  //JMB the user has interrupted gadget, so try again
+    if (num < 0)
+      handle.logMessage(LOGFAIL, "Error in workerpool - failed to wait for worker processes");
+
+    for (i = 0; i < numworkers; i++) {
+      if ((!busy[i]) || (fds[i].revents == 0))
+        continue;
+
+      if (!this->readData(receivefd[i], &receivedata[0], numlike + 2))
+        handle.logMessage(LOGFAIL, "Error in workerpool - failed to receive data from worker process");
+
+      id = (int)receivedata[0];
+      for (j = 0; j <= numlike; j++)
+        results[id][j] = receivedata[j + 1];
+      done++;
+      busy[i] = 0;
+
+      //send the next point in the batch to the worker that has just finished
+      if (next < points.Nrow()) {
+        this->sendPoint(i, next, points[next]);
+        busy[i] = 1;
+        next++;
+      }
+    }
+  }
+  delete[] fds;
+}
+
+int LocalWorkerPool::writeData(int fd, const double* data, int num) {
+  const char* buf = (const char*)data;
+  int len = num * sizeof(double);
+  int count;
+  while (len > 0) {
+    count = write(fd, buf, len);
+    if ((count < 0) && (errno == EINTR))
+      continue;
+    if (count <= 0)
+      return 0;
+    buf += count;
+    len -= count;
+  }
+  return 1;
+}
+
+int LocalWorkerPool::readData(int fd, double* data, int num) {
+  char* buf = (char*)data;
+  int len = num * sizeof(double);
+  int count;
+  while (len > 0) {
+    count = read(fd, buf, len);
+    if ((count < 0) && (errno == EINTR))
+      continue;
+    if (count <= 0)
+      return 0;
+    buf += count;
+    len -= count;
+  }
+  return 1;
+}
@@ -18,6 +18,8 @@ void MainInfo::showUsage() {
     << " -l                           perform a likelihood (optimising) model run\n"
     << " -s                           perform a single (simulation) model run\n"
     << " -n                           perform a network run (using paramin)\n"
+    << " -netlikelihoods              send the likelihood component scores in a network run\n"
+    << " -parallel <number>           use <number> processes for a likelihood run\n"
     << " -v --version                 display version information and exit\n"
     << " -h --help                    display this help screen and exit\n"
     << "\nOptions for specifying the input to Gadget models:\n"
@@ -31,19 +33,31 @@ void MainInfo::showUsage() {
     << "                              (default filename is 'params.out')\n"
     << " -o <filename>                print likelihood output to <filename>\n"
     << " -print <number>              print -o output every <number> iterations\n"
+    << " -printbinary                 print -o output in a binary format\n"
     << " -precision <number>          set the precision to <number> in output files\n"
     << "\nOptions for debugging Gadget models:\n"
     << " -log <filename>              print logging information to <filename>\n"
     << " -printinitial <filename>     print initial model information to <filename>\n"
     << " -printfinal <filename>       print final model information to <filename>\n"
+    << "\nOptions for calculating the uncertainty of the optimised parameters:\n"
+    << " -hessian <filename>          print the Hessian matrix at the optimum to <filename>\n"
+    << " -hessianstep <number>        set the step size for the Hessian matrix to <number>\n"
+    << " -replicates <filename>       optimise the bootstrap or jackknife replicates in <filename>\n"
+    << " -likprofile <filename>       calculate the likelihood profile for the switches in <filename>\n"
+    << "\nOptions for measuring the performance of Gadget models:\n"
+    << " -profile <filename>          print the time spent on each phase to <filename>\n"
+    << " -profileevals                include the times for each simulation in the profile\n"
+    << " -profilecounters             include the hardware counters for each phase in the profile\n"
     << "\nFor more information see the Gadget web page at http://www.hafro.is/gadget\n\n";
   exit(EXIT_SUCCESS);
 }
 
 MainInfo::MainInfo()
   : givenOptInfo(0), givenInitialParam(0), runoptimise(0),
-    runstochastic(0), runnetwork(0), runprint(1), forceprint(0),
-    printInitialInfo(0), printFinalInfo(0), printLogLevel(0), maxratio(0.95) {
+    runstochastic(0), runnetwork(0), netlikelihoods(0), runprint(1), forceprint(0),
+    printInitialInfo(0), printFinalInfo(0), printHessianInfo(0), runreplicates(0), runlikprofile(0),
+    runprofile(0),
+    profileevals(0), profilecounters(0), printLogLevel(0), maxratio(0.95), numworkers(0), hessianstep(1e-4) {
 
   char tmpname[10];
   strncpy(tmpname, "", 10);
@@ -53,7 +67,12 @@ MainInfo::MainInfo()
   strInitialParamFile = NULL;
   strPrintInitialFile = NULL;
   strPrintFinalFile = NULL;
+  strHessianFile = NULL;
+  strReplicateFile = NULL;
+  strLikProfileFile = NULL;
+  strProfileFile = NULL;
   strMainGadgetFile = NULL;
+  strProgramName = NULL;
   setMainGadgetFile(tmpname);
 }
 
@@ -74,14 +93,35 @@ MainInfo::~MainInfo() {
     delete[] strPrintFinalFile;
     strPrintFinalFile = NULL;
   }
+  if (strHessianFile != NULL) {
+    delete[] strHessianFile;
+    strHessianFile = NULL;
+  }
+  if (strReplicateFile != NULL) {
+    delete[] strReplicateFile;
+    strReplicateFile = NULL;
+  }
+  if (strLikProfileFile != NULL) {
+    delete[] strLikProfileFile;
+    strLikProfileFile = NULL;
+  }
+  if (strProfileFile != NULL) {
+    delete[] strProfileFile;
+    strProfileFile = NULL;
+  }
   if (strMainGadgetFile != NULL) {
     delete[] strMainGadgetFile;
     strMainGadgetFile = NULL;
   }
+  if (strProgramName != NULL) {
+    delete[] strProgramName;
+    strProgramName = NULL;
+  }
 }
 
 void MainInfo::read(int aNumber, char* const aVector[]) {
 
+  this->setProgramName(aVector[0]);
   if (aNumber == 1) {
     handle.logMessage(LOGWARN, "Warning - no command line options specified, using default values");
     return;
@@ -102,6 +142,12 @@ void MainInfo::read(int aNumber, char* const aVector[]) {
     } else if (strcasecmp(aVector[k], "-s") == 0) {
       runstochastic = 1;
 
+    } else if (strcasecmp(aVector[k], "-parallel") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      numworkers = atoi(aVector[k]);
+
     } else if (strcasecmp(aVector[k], "-m") == 0) {
       ifstream infile;
       CommentStream incomment(infile);
@@ -152,6 +198,42 @@ void MainInfo::read(int aNumber, char* const aVector[]) {
       k++;
       this->setPrintFinalFile(aVector[k]);
 
+    } else if (strcasecmp(aVector[k], "-hessian") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setHessianFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-hessianstep") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      hessianstep = atof(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-replicates") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setReplicateFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-likprofile") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setLikelihoodProfileFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-profile") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setProfileFile(aVector[k]);
+
+    } else if (strcasecmp(aVector[k], "-profileevals") == 0) {
+      profileevals = 1;
+
+    } else if (strcasecmp(aVector[k], "-profilecounters") == 0) {
+      profilecounters = 1;
+
     } else if (strcasecmp(aVector[k], "-main") == 0) {
       if (k == aNumber - 1)
         this->showCorrectUsage(aVector[k]);
@@ -179,6 +261,9 @@ void MainInfo::read(int aNumber, char* const aVector[]) {
       k++;
       printinfo.setPrintIteration(atoi(aVector[k]));
 
+    } else if (strcasecmp(aVector[k], "-printbinary") == 0) {
+      printinfo.setBinaryOutput(1);
+
     } else if (strcasecmp(aVector[k], "-precision") == 0) {
       if (k == aNumber - 1)
         this->showCorrectUsage(aVector[k]);
@@ -222,6 +307,9 @@ void MainInfo::read(int aNumber, char* const aVector[]) {
       k++;
       srand(atoi(aVector[k]));
 
+    } else if (strcasecmp(aVector[k], "-netlikelihoods") == 0) {
+      netlikelihoods = 1;
+
     } else if (strcasecmp(aVector[k], "-maxratio") == 0) {
       //JMB experimental setting of maximum ratio of stock consumed in one timestep
       if (k == aNumber - 1)
@@ -265,6 +353,22 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
       handle.logMessage(LOGINFO, "Warning - cannot print final model information");
       printFinalInfo = 0;
     }
+    if (printHessianInfo) {
+      handle.logMessage(LOGINFO, "Warning - cannot calculate the Hessian matrix");
+      printHessianInfo = 0;
+    }
+    if (runprofile) {
+      handle.logMessage(LOGINFO, "Warning - cannot profile the model simulation");
+      runprofile = 0;
+    }
+    if (runreplicates) {
+      handle.logMessage(LOGINFO, "Warning - cannot optimise the replicate model runs");
+      runreplicates = 0;
+    }
+    if (runlikprofile) {
+      handle.logMessage(LOGINFO, "Warning - cannot calculate the likelihood profile");
+      runlikprofile = 0;
+    }
   }
 
   //JMB check to see if we can actually open required files ...
@@ -288,6 +392,18 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
     tmpin.close();
     tmpin.clear();
   }
+  if (runreplicates) {
+    tmpin.open(strReplicateFile, ios::in);
+    handle.checkIfFailure(tmpin, strReplicateFile);
+    tmpin.close();
+    tmpin.clear();
+  }
+  if (runlikprofile) {
+    tmpin.open(strLikProfileFile, ios::in);
+    handle.checkIfFailure(tmpin, strLikProfileFile);
+    tmpin.close();
+    tmpin.clear();
+  }
   ofstream tmpout;
   if (chdir(workingdir) != 0)
     handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
@@ -303,8 +419,30 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
     tmpout.close();
     tmpout.clear();
   }
+  if (printHessianInfo) {
+    tmpout.open(strHessianFile, ios::out);
+    handle.checkIfFailure(tmpout, strHessianFile);
+    tmpout.close();
+    tmpout.clear();
+  }
+  if (runprofile) {
+    tmpout.open(strProfileFile, ios::out);
+    handle.checkIfFailure(tmpout, strProfileFile);
+    tmpout.close();
+    tmpout.clear();
+  }
   printinfo.checkPrintInfo(runnetwork);
 
+  //JMB check the number of processes for a parallel likelihood run
+  if (numworkers < 0) {
+    handle.logMessage(LOGWARN, "Warning - number of processes for a parallel run less than zero", numworkers);
+    numworkers = 0;
+  }
+  if ((numworkers > 1) && (runnetwork)) {
+    handle.logMessage(LOGWARN, "Warning - Gadget cannot perform a parallel run in network mode");
+    numworkers = 0;
+  }
+
   //JMB check the value of maxratio
   if ((maxratio < rathersmall) || (maxratio > 1.0)) {
     handle.logMessage(LOGWARN, "Warning - value of maxratio outside bounds", maxratio);
@@ -326,6 +464,55 @@ void MainInfo::checkUsage(const char* const inputdir, const char* const workingd
     runstochastic = 1;
   }
 
+  if ((numworkers > 1) && (!runoptimise))
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only use more than one process for a likelihood run");
+
+  //JMB check the options for the Hessian matrix
+  if ((printHessianInfo) && (!runoptimise)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only calculate the Hessian matrix for a likelihood run");
+    printHessianInfo = 0;
+  }
+  if ((hessianstep < rathersmall) || (hessianstep > 0.1)) {
+    handle.logMessage(LOGWARN, "Warning - value of hessianstep outside bounds", hessianstep);
+    hessianstep = 1e-4;
+  }
+
+  //JMB check the options for the replicate model runs and the likelihood profile
+  if ((runreplicates) && (!runoptimise)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only optimise the replicate model runs for a likelihood run");
+    runreplicates = 0;
+  }
+  if ((runlikprofile) && (!runoptimise)) {
+    handle.logMessage(LOGWARN, "\nWarning - Gadget can only calculate the likelihood profile for a likelihood run");
+    runlikprofile = 0;
+  }
+  if ((runlikprofile) && (runreplicates)) {
+    handle.logMessage(LOGWARN, "Warning - cannot calculate the likelihood profile for the replicate model runs");
+    runlikprofile = 0;
+  }
+  if ((runreplicates) || (runlikprofile)) {
+    if (printHessianInfo) {
+      handle.logMessage(LOGWARN, "Warning - cannot calculate the Hessian matrix for the replicate or likelihood profile model runs");
+      printHessianInfo = 0;
+    }
+    if (printFinalInfo) {
+      handle.logMessage(LOGWARN, "Warning - cannot print final model information for the replicate or likelihood profile model runs");
+      printFinalInfo = 0;
+    }
+    if (printinfo.getPrint()) {
+      handle.logMessage(LOGWARN, "Warning - cannot print the parameter values for the replicate or likelihood profile model runs");
+      printinfo.setPrint(0);
+    }
+  }
+
+  //JMB check the options for the profile
+  if ((profileevals) && (!runprofile))
+    handle.logMessage(LOGWARN, "Warning - no profile file specified, ignoring -profileevals");
+  if ((profilecounters) && (!runprofile))
+    handle.logMessage(LOGWARN, "Warning - no profile file specified, ignoring -profilecounters");
+  if ((runprofile) && (((numworkers > 1) && (runoptimise)) || (runreplicates) || (runlikprofile)))
+    handle.logMessage(LOGWARN, "Warning - the profile will not include the simulations calculated by the worker processes");
+
   handle.setRunOptimise(runoptimise);
   if ((printLogLevel == 1) && (!runoptimise))
     handle.logMessage(LOGWARN, "\n** Gadget cannot disable warnings for a simulation run **");
@@ -380,6 +567,24 @@ void MainInfo::read(CommentStream& infile) {
     } else if (strcasecmp(text, "-printfinal") == 0) {
       infile >> text >> ws;
       this->setPrintFinalFile(text);
+    } else if (strcasecmp(text, "-hessian") == 0) {
+      infile >> text >> ws;
+      this->setHessianFile(text);
+    } else if (strcasecmp(text, "-hessianstep") == 0) {
+      infile >> hessianstep >> ws;
+    } else if (strcasecmp(text, "-replicates") == 0) {
+      infile >> text >> ws;
+      this->setReplicateFile(text);
+    } else if (strcasecmp(text, "-likprofile") == 0) {
+      infile >> text >> ws;
+      this->setLikelihoodProfileFile(text);
+    } else if (strcasecmp(text, "-profile") == 0) {
+      infile >> text >> ws;
+      this->setProfileFile(text);
+    } else if (strcasecmp(text, "-profileevals") == 0) {
+      profileevals = 1;
+    } else if (strcasecmp(text, "-profilecounters") == 0) {
+      profilecounters = 1;
     } else if (strcasecmp(text, "-opt") == 0) {
       infile >> text >> ws;
       this->setOptInfoFile(text);
@@ -390,6 +595,8 @@ void MainInfo::read(CommentStream& infile) {
     } else if ((strcasecmp(text, "-print") == 0) || (strcasecmp(text, "-print1") == 0)) {
       infile >> dummy >> ws;
       printinfo.setPrintIteration(dummy);
+    } else if (strcasecmp(text, "-printbinary") == 0) {
+      printinfo.setBinaryOutput(1);
     } else if (strcasecmp(text, "-precision") == 0) {
       infile >> dummy >> ws;
       printinfo.setPrecision(dummy);
@@ -406,6 +613,10 @@ void MainInfo::read(CommentStream& infile) {
       srand(dummy);
     } else if (strcasecmp(text, "-maxratio") == 0) {
       infile >> maxratio >> ws;
+    } else if (strcasecmp(text, "-netlikelihoods") == 0) {
+      netlikelihoods = 1;
+    } else if (strcasecmp(text, "-parallel") == 0) {
+      infile >> numworkers >> ws;
     } else if (strcasecmp(text, "-printlikesummary") == 0) {
       handle.logMessage(LOGWARN, "The -printlikesummary switch is no longer supported\nSpecify a likelihoodsummaryprinter class in the model print file instead");
     } else if (strcasecmp(text, "-printlikelihood") == 0) {
@@ -437,6 +648,46 @@ void MainInfo::setPrintFinalFile(char* filename) {
   printFinalInfo = 1;
 }
 
+void MainInfo::setHessianFile(char* filename) {
+  if (strHessianFile != NULL) {
+    delete[] strHessianFile;
+    strHessianFile = NULL;
+  }
+  strHessianFile = new char[strlen(filename) + 1];
+  strcpy(strHessianFile, filename);
+  printHessianInfo = 1;
+}
+
+void MainInfo::setReplicateFile(char* filename) {
+  if (strReplicateFile != NULL) {
+    delete[] strReplicateFile;
+    strReplicateFile = NULL;
+  }
+  strReplicateFile = new char[strlen(filename) + 1];
+  strcpy(strReplicateFile, filename);
+  runreplicates = 1;
+}
+
+void MainInfo::setLikelihoodProfileFile(char* filename) {
+  if (strLikProfileFile != NULL) {
+    delete[] strLikProfileFile;
+    strLikProfileFile = NULL;
+  }
+  strLikProfileFile = new char[strlen(filename) + 1];
+  strcpy(strLikProfileFile, filename);
+  runlikprofile = 1;
+}
+
+void MainInfo::setProfileFile(char* filename) {
+  if (strProfileFile != NULL) {
+    delete[] strProfileFile;
+    strProfileFile = NULL;
+  }
+  strProfileFile = new char[strlen(filename) + 1];
+  strcpy(strProfileFile, filename);
+  runprofile = 1;
+}
+
 void MainInfo::setMainGadgetFile(char* filename) {
   if (strMainGadgetFile != NULL) {
     delete[] strMainGadgetFile;
@@ -446,6 +697,15 @@ void MainInfo::setMainGadgetFile(char* filename) {
   strcpy(strMainGadgetFile, filename);
 }
 
+void MainInfo::setProgramName(const char* filename) {
+  if (strProgramName != NULL) {
+    delete[] strProgramName;
+    strProgramName = NULL;
+  }
+  strProgramName = new char[strlen(filename) + 1];
+  strcpy(strProgramName, filename);
+}
+
 void MainInfo::setInitialParamFile(char* filename) {
   if (strInitialParamFile != NULL) {
     delete[] strInitialParamFile;
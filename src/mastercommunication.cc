@@ -0,0 +1,145 @@
+#include "mastercommunication.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+MasterCommunication::MasterCommunication(int workers, int nlike, const MainInfo& main, const Keeper* const keeper)
+  : WorkerPool(workers, keeper->numVariables(), nlike) {
+
+  int i, j;
+  char name[MaxStrLength];
+  char ratio[MaxStrLength];
+  char workingdir[LongString];
+  char* args[7];
+  int* errcodes = new int[numworkers];
+  MPI_Info info;
+  MPI_Status status;
+
+  batch = 0;
+  pvmConst = new PVMConstants();
+  //each point is sent as the tag, the id and the values, and returned as one message with the tag, the id,
+  //the slave and the overall likelihood score, and then a second message with the tag, the id and the scores
+  //from each likelihood component (the slaves are started with -netlikelihoods so that this is sent)
+  senddata.resize(numvar + 2, 0.0);
+  receivedata.resize(numlike + 4, 0.0);
+  receivelikes.resize(numlike + 2, 0.0);
+
+  //JMB start the slaves in network mode on the same model, in the current directory
+  strncpy(ratio, "", MaxStrLength);
+  sprintf(ratio, "%.15g", main.getMaxRatio());
+  args[0] = (char*)"-n";
+  args[1] = (char*)"-netlikelihoods";
+  args[2] = (char*)"-main";
+  args[3] = main.getMainGadgetFile();
+  args[4] = (char*)"-maxratio";
+  args[5] = ratio;
+  args[6] = NULL;
+  if (getcwd(workingdir, LongString) == NULL)
+    handle.logMessage(LOGFAIL, "Error in mastercommunication - failed to get current working directory");
+
+  MPI_Init(NULL, NULL);
+  MPI_Info_create(&info);
+  MPI_Info_set(info, (char*)"wdir", workingdir);
+  MPI_Comm_spawn(main.getProgramName(), args, numworkers, info, 0, MPI_COMM_SELF, &slavecomm, errcodes);
+  MPI_Info_free(&info);
+  for (i = 0; i < numworkers; i++)
+    if (errcodes[i] != MPI_SUCCESS)
+      handle.logMessage(LOGFAIL, "Error in mastercommunication - failed to start slave process", i);
+  delete[] errcodes;
+
+  ParameterVector switches(numvar);
+  DoubleVector values(numvar, 0.0);
+  DoubleVector lowerbound(numvar, 0.0);
+  DoubleVector upperbound(numvar, 0.0);
+  keeper->getSwitches(switches);
+  keeper->getCurrentValues(values);
+  keeper->getLowerBounds(lowerbound);
+  keeper->getUpperBounds(upperbound);
+
+  //send the start information to each slave, in the order expected by StochasticData
+  for (i = 0; i < numworkers; i++) {
+    MPI_Send(&numvar, 1, MPI_INT, i, pvmConst->getStartTag(), slavecomm);
+    MPI_Send(&i, 1, MPI_INT, i, pvmConst->getStartTag(), slavecomm);
+    for (j = 0; j < numvar; j++) {
+      strncpy(name, "", MaxStrLength);
+      strncpy(name, switches[j].getName(), MaxStrLength - 1);
+      MPI_Send(name, MaxStrLength, MPI_BYTE, i, pvmConst->getMasterSendStringTag(), slavecomm);
+    }
+    MPI_Send(&lowerbound[0], numvar, MPI_DOUBLE, i, pvmConst->getMasterSendBoundTag(), slavecomm);
+    MPI_Send(&upperbound[0], numvar, MPI_DOUBLE, i, pvmConst->getMasterSendBoundTag(), slavecomm);
+  }
+
+  //JMB the slaves check that the first point is within the bounds, so the first
+  //point sent is the current point, and the results from this point are ignored
+  for (i = 0; i < numworkers; i++)
+    this->sendPoint(i, 0, values);
+  for (i = 0; i < numworkers; i++)
+    this->receiveResult(status);
+}
+
+MasterCommunication::~MasterCommunication() {
+  int i, stop = 0;
+  for (i = 0; i < numworkers; i++)
+    MPI_Send(&stop, 1, MPI_INT, i, pvmConst->getStopTag(), slavecomm);
+  delete pvmConst;
+  MPI_Finalize();
+}
+
+void MasterCommunication::sendPoint(int slave, int id, const DoubleVector& point) {
+  int i;
+  senddata[0] = batch;
+  senddata[1] = id;
+  for (i = 0; i < numvar; i++)
+    senddata[i + 2] = point[i];
+  MPI_Send(&senddata[0], numvar + 2, MPI_DOUBLE, slave, pvmConst->getMasterSendPackedTag(), slavecomm);
+}
+
+void MasterCommunication::receiveResult(MPI_Status& status) {
+  int i;
+  MPI_Status likestatus;
+  MPI_Recv(&receivedata[0], 4, MPI_DOUBLE, MPI_ANY_SOURCE,
+    pvmConst->getMasterReceivePackedTag(), slavecomm, &status);
+
+  //JMB the slave sends the scores from each likelihood component straight after the packed result
+  if (numlike > 0) {
+    MPI_Recv(&receivelikes[0], numlike + 2, MPI_DOUBLE, status.MPI_SOURCE,
+      pvmConst->getMasterReceiveLikelihoodTag(), slavecomm, &likestatus);
+    if (((int)receivelikes[0] != (int)receivedata[0]) || ((int)receivelikes[1] != (int)receivedata[1]))
+      handle.logMessage(LOGFAIL, "Error in mastercommunication - likelihood scores dont match the result from slave", status.MPI_SOURCE);
+    for (i = 0; i < numlike; i++)
+      receivedata[i + 4] = receivelikes[i + 2];
+  }
+}
+
+void MasterCommunication::evaluatePoints(const DoubleMatrix& points, DoubleMatrix& results) {
+  int i, j, k, id, next, done;
+  MPI_Status status;
+
+  //JMB each batch has a different tag, so any results from a previous batch are ignored
+  batch++;
+  next = 0;
+  for (k = 0; k < masterQueueLength; k++) {
+    for (i = 0; ((i < numworkers) && (next < points.Nrow())); i++) {
+      this->sendPoint(i, next, points[next]);
+      next++;
+    }
+  }
+
+  done = 0;
+  while (done < points.Nrow()) {
+    this->receiveResult(status);
+    if ((int)receivedata[0] != batch)
+      continue;
+
+    id = (int)receivedata[1];
+    for (j = 0; j <= numlike; j++)
+      results[id][j] = receivedata[j + 3];
+    done++;
+
+    //send the next point in the batch to the slave that has just finished
+    if (next < points.Nrow()) {
+      this->sendPoint(status.MPI_SOURCE, next, points[next]);
+      next++;
+    }
+  }
+}
@@ -197,11 +197,8 @@ void MigrationProportion::printLikelihood(ofstream& outfile, const TimeClass* co
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in migrationproportion - invalid timestep");
 
@@ -259,11 +256,7 @@ void MigrationProportion::addLikelihood(const TimeClass* const TimeInfo) {
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "Calculating likelihood score for migrationproportion component", this->getName());
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in migrationproportion - invalid timestep");
 
@@ -4,37 +4,51 @@
 #include "gadget.h"
 #include "global.h"
 
+double Multinomial::calcDataTerm(const DoubleVector& data) const {
+  int i;
+  double sumdata, sumlog;
+
+  sumdata = sumlog = 0.0;
+  for (i = 0; i < data.Size(); i++) {
+    sumdata += data[i];
+    sumlog += logFactorial(data[i]);
+  }
+  sumlog -= logFactorial(sumdata);
+  return sumlog;
+}
+
 double Multinomial::calcLogLikelihood(const DoubleVector& data, const DoubleVector& dist) {
+  return this->calcLogLikelihood(data, dist, this->calcDataTerm(data));
+}
+
+double Multinomial::calcLogLikelihood(const DoubleVector& data, const DoubleVector& dist, double dataterm) {
 
   int i;
   double minp = 1.0 / (dist.Size() * bigvalue);
-  double sumdist, sumdata, sumlog, likely, tmp;
+  double sumdist, likely, tmp;
 
   if (data.Size() != dist.Size())
     handle.logMessage(LOGFAIL, "Error in multinomial - vectors not the same size");
 
-  sumdist = sumdata = sumlog = likely = 0.0;
-  for (i = 0; i < data.Size(); i++) {
+  sumdist = likely = 0.0;
+  for (i = 0; i < dist.Size(); i++)
     sumdist += dist[i];
-    sumdata += data[i];
-    sumlog += logFactorial(data[i]);
-  }
 
   if (isZero(sumdist))
     return 0.0;
 
+  //JMB the terms for any zero data values are skipped, since they dont contribute to the score
   tmp = 1.0 / sumdist;
   for (i = 0; i < data.Size(); i++) {
     if (isZero(data[i]))
-      likely += 0.0;
+      continue;
     else if (((dist[i] * tmp) > minp) || (isEqual((dist[i] * tmp), minp)))
       likely -= data[i] * log(dist[i] * tmp);
     else
       likely -= data[i] * log(minp);
   }
 
-  sumlog -= logFactorial(sumdata);
-  tmp = 2.0 * (likely + sumlog);
+  tmp = 2.0 * (likely + dataterm);
   if (tmp < 0.0)
     handle.logMessage(LOGWARN, "Warning in multinomial - negative total", tmp);
 
@@ -0,0 +1,78 @@
+#include "observationstore.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+ObservationStore::ObservationStore() {
+  used = 0;
+  totalsize = 0;
+  references = 1;
+  frozen = 0;
+}
+
+ObservationStore::~ObservationStore() {
+  int i;
+  for (i = 0; i < blocks.Size(); i++)
+    munmap(blocks[i], blocksize[i] * sizeof(double));
+}
+
+double* ObservationStore::allocate(int num) {
+  int i, size, page;
+  char* block;
+  double* ptr;
+
+  if (frozen)
+    handle.logMessage(LOGFAIL, "Error in observationstore - cannot add data to read-only store");
+
+  i = blocks.Size() - 1;
+  if ((i < 0) || (used + num > blocksize[i])) {
+    //JMB round the size of the new block up to a whole number of pages
+    size = (num > obsStoreBlockSize ? num : obsStoreBlockSize);
+    page = sysconf(_SC_PAGESIZE) / sizeof(double);
+    if (page > 0)
+      size = ((size + page - 1) / page) * page;
+
+    block = (char*)mmap(NULL, size * sizeof(double), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block == (char*)MAP_FAILED)
+      handle.logMessage(LOGFAIL, "Error in observationstore - failed to allocate memory for observation data");
+    blocks.resize(block);
+    blocksize.resize(1, size);
+    used = 0;
+    i++;
+  }
+
+  ptr = (double*)blocks[i] + used;
+  used += num;
+  totalsize += num;
+  return ptr;
+}
+
+void ObservationStore::storeMatrix(DoubleMatrix& matrix) {
+  int i;
+  for (i = 0; i < matrix.Nrow(); i++)
+    if ((matrix[i].Size() > 0) && (!matrix[i].isShared()))
+      matrix[i].moveToStore(this->allocate(matrix[i].Size()));
+}
+
+void ObservationStore::storeMatrices(DoubleMatrixPtrVector& matrices) {
+  int i;
+  for (i = 0; i < matrices.Size(); i++)
+    this->storeMatrix(*matrices[i]);
+}
+
+void ObservationStore::storeMatrices(DoubleMatrixPtrMatrix& matrices) {
+  int i;
+  for (i = 0; i < matrices.Nrow(); i++)
+    this->storeMatrices(matrices[i]);
+}
+
+void ObservationStore::Freeze() {
+  int i;
+  if (frozen)
+    return;
+
+  for (i = 0; i < blocks.Size(); i++)
+    if (mprotect(blocks[i], blocksize[i] * sizeof(double), PROT_READ) != 0)
+      handle.logMessage(LOGWARN, "Warning in observationstore - failed to make observation data read-only");
+  frozen = 1;
+}
@@ -0,0 +1,69 @@
+#include "optinfo.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+OptInfoBOBYQA::OptInfoBOBYQA()
+  : OptInfo(), bobyqaiter(10000), bobyqaeps(1e-6), rhobeg(0.1) {
+  type = OPTBOBYQA;
+  handle.logMessage(LOGMESSAGE, "Initialising BOBYQA optimisation algorithm");
+}
+
+void OptInfoBOBYQA::read(CommentStream& infile, char* text) {
+  handle.logMessage(LOGMESSAGE, "Reading BOBYQA optimisation parameters");
+
+  int count = 0;
+  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]")
+      && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[lbfgs]") && strcasecmp(text, "[cmaes]")
+      && strcasecmp(text, "[bobyqa]")) {
+    infile >> ws;
+    if (strcasecmp(text, "seed") == 0) {
+      int seed = 0;
+      infile >> seed >> ws;
+      handle.logMessage(LOGMESSAGE, "Initialising random number generator with", seed);
+      srand(seed);
+
+    } else if ((strcasecmp(text, "bobyqaiter") == 0) || (strcasecmp(text, "maxiter") == 0)) {
+      infile >> bobyqaiter;
+      count++;
+
+    } else if (strcasecmp(text, "bobyqaeps") == 0) {
+      infile >> bobyqaeps;
+      count++;
+
+    } else if (strcasecmp(text, "rhobeg") == 0) {
+      infile >> rhobeg;
+      count++;
+
+    } else {
+      handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
+      infile >> text;  //read and ignore the next entry
+    }
+    infile >> text;
+  }
+
+  if (count == 0)
+    handle.logMessage(LOGINFO, "Warning - no parameters specified for BOBYQA optimisation algorithm");
+
+  //check the values specified in the optinfo file ...
+  if ((rhobeg < verysmall) || (rhobeg > 1.0)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of rhobeg outside bounds", rhobeg);
+    rhobeg = 0.1;
+  }
+  if ((bobyqaeps < verysmall) || (bobyqaeps > rhobeg)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of bobyqaeps outside bounds", bobyqaeps);
+    bobyqaeps = min(1e-6, rhobeg);
+  }
+}
+
+void OptInfoBOBYQA::Print(ofstream& outfile, int prec) {
+  outfile << "; BOBYQA algorithm ran for " << iters
+    << " function evaluations\n; and stopped when the likelihood value was "
+    << setprecision(prec) << score;
+  if (converge == -1)
+    outfile << "\n; because an error occured during the optimisation\n";
+  else if (converge == 1)
+    outfile << "\n; because the convergence criteria were met\n";
+  else
+    outfile << "\n; because the maximum number of function evaluations was reached\n";
+}
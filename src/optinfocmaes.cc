@@ -0,0 +1,85 @@
+#include "optinfo.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+OptInfoCMAES::OptInfoCMAES()
+  : OptInfo(), cmaesiter(10000), cmaeseps(1e-6), sigma(0.3), lambda(0), restarts(4) {
+  type = OPTCMAES;
+  handle.logMessage(LOGMESSAGE, "Initialising CMA-ES optimisation algorithm");
+}
+
+void OptInfoCMAES::read(CommentStream& infile, char* text) {
+  handle.logMessage(LOGMESSAGE, "Reading CMA-ES optimisation parameters");
+
+  int count = 0;
+  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]")
+      && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[lbfgs]") && strcasecmp(text, "[cmaes]")
+      && strcasecmp(text, "[bobyqa]")) {
+    infile >> ws;
+    if (strcasecmp(text, "seed") == 0) {
+      int seed = 0;
+      infile >> seed >> ws;
+      handle.logMessage(LOGMESSAGE, "Initialising random number generator with", seed);
+      srand(seed);
+
+    } else if ((strcasecmp(text, "cmaesiter") == 0) || (strcasecmp(text, "maxiter") == 0)) {
+      infile >> cmaesiter;
+      count++;
+
+    } else if (strcasecmp(text, "cmaeseps") == 0) {
+      infile >> cmaeseps;
+      count++;
+
+    } else if (strcasecmp(text, "sigma") == 0) {
+      infile >> sigma;
+      count++;
+
+    } else if (strcasecmp(text, "lambda") == 0) {
+      infile >> lambda;
+      count++;
+
+    } else if (strcasecmp(text, "restarts") == 0) {
+      infile >> restarts;
+      count++;
+
+    } else {
+      handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
+      infile >> text;  //read and ignore the next entry
+    }
+    infile >> text;
+  }
+
+  if (count == 0)
+    handle.logMessage(LOGINFO, "Warning - no parameters specified for CMA-ES optimisation algorithm");
+
+  //check the values specified in the optinfo file ...
+  if (cmaeseps < verysmall) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of cmaeseps outside bounds", cmaeseps);
+    cmaeseps = 1e-6;
+  }
+  if ((sigma < rathersmall) || (sigma > 1.0)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of sigma outside bounds", sigma);
+    sigma = 0.3;
+  }
+  if ((lambda != 0) && (lambda < 4)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of lambda outside bounds", lambda);
+    lambda = 0;
+  }
+  if (restarts < 0) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of restarts outside bounds", restarts);
+    restarts = 4;
+  }
+}
+
+void OptInfoCMAES::Print(ofstream& outfile, int prec) {
+  outfile << "; CMA-ES algorithm ran for " << iters
+    << " function evaluations\n; and stopped when the likelihood value was "
+    << setprecision(prec) << score;
+  if (converge == -1)
+    outfile << "\n; because an error occured during the optimisation\n";
+  else if (converge == 1)
+    outfile << "\n; because the convergence criteria were met\n";
+  else
+    outfile << "\n; because the maximum number of function evaluations was reached\n";
+}
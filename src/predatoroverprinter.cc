@@ -90,6 +90,15 @@ PredatorOverPrinter::PredatorOverPrinter(CommentStream& infile, const TimeClass*
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in predatoroverprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in predatoroverprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -116,6 +125,14 @@ PredatorOverPrinter::PredatorOverPrinter(CommentStream& infile, const TimeClass*
     outfile << "\n; Printing the following information at the start of each timestep";
 
   outfile << "\n; year-step-area-length-overconsumption biomass\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", LABELCOLUMN, printwidth, 0, &areaindex);
+    binout->addColumn("length", LABELCOLUMN, printwidth, 0, &lenindex);
+    binout->addColumn("overconsumption biomass", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
@@ -187,6 +204,11 @@ void PredatorOverPrinter::Print(const TimeClass* const TimeInfo, int printtime)
   dptr = &aggregator->getSum();
   int a, len;
 
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < areas.Nrow(); a++) {
     for (len = 0; len < dptr->Ncol(a); len++) {
       outfile << setw(lowwidth) << TimeInfo->getYear() << sep
@@ -204,7 +226,27 @@ void PredatorOverPrinter::Print(const TimeClass* const TimeInfo, int printtime)
   outfile.flush();
 }
 
+void PredatorOverPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, len;
+  for (a = 0; a < areas.Nrow(); a++) {
+    for (len = 0; len < dptr->Ncol(a); len++) {
+      binout->storeInt(TimeInfo->getYear());
+      binout->storeInt(TimeInfo->getStep());
+      binout->storeInt(a);
+      binout->storeInt(len);
+
+      //JMB crude filter to remove the 'silly' values from the output
+      if ((*dptr)[a][len] < rathersmall)
+        binout->storeDouble(0.0);
+      else
+        binout->storeDouble((*dptr)[a][len]);
+    }
+  }
+}
+
 PredatorOverPrinter::~PredatorOverPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   delete predLgrpDiv;
@@ -109,6 +109,15 @@ PredatorPreyPrinter::PredatorPreyPrinter(CommentStream& infile, const TimeClass*
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in predatorpreyprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in predatorpreyprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -139,6 +148,17 @@ PredatorPreyPrinter::PredatorPreyPrinter(CommentStream& infile, const TimeClass*
     outfile << "\n; Printing the following information at the start of each timestep";
 
   outfile << "\n; year-step-area-age-length-number consumed-biomass consumed-mortality\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", LABELCOLUMN, printwidth, 0, &areaindex);
+    binout->addColumn("age", LABELCOLUMN, printwidth, 0, &ageindex);
+    binout->addColumn("length", LABELCOLUMN, printwidth, 0, &lenindex);
+    binout->addColumn("number consumed", DOUBLECOLUMN, width, precision);
+    binout->addColumn("biomass consumed", DOUBLECOLUMN, width, precision);
+    binout->addColumn("mortality", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
@@ -269,6 +289,11 @@ void PredatorPreyPrinter::Print(const TimeClass* const TimeInfo, int printtime)
   int a, age, len;
   aggregator->Sum(TimeInfo);
   alptr = &aggregator->getConsumption();
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < areas.Nrow(); a++) {
     dptr = aggregator->getMortality()[a];
     for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
@@ -294,7 +319,36 @@ void PredatorPreyPrinter::Print(const TimeClass* const TimeInfo, int printtime)
   outfile.flush();
 }
 
+void PredatorPreyPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, age, len;
+  for (a = 0; a < areas.Nrow(); a++) {
+    dptr = aggregator->getMortality()[a];
+    for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
+      for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
+        binout->storeInt(TimeInfo->getYear());
+        binout->storeInt(TimeInfo->getStep());
+        binout->storeInt(a);
+        binout->storeInt(age);
+        binout->storeInt(len);
+
+        //JMB crude filter to remove the 'silly' values from the output
+        if (((*alptr)[a][age][len].N < rathersmall) || ((*alptr)[a][age][len].W < 0.0)) {
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+        } else {
+          binout->storeDouble((*alptr)[a][age][len].N);
+          binout->storeDouble((*alptr)[a][age][len].N * (*alptr)[a][age][len].W);
+          binout->storeDouble((*dptr)[age][len]);
+        }
+      }
+    }
+  }
+}
+
 PredatorPreyPrinter::~PredatorPreyPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   delete LgrpDiv;
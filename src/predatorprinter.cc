@@ -126,6 +126,15 @@ PredatorPrinter::PredatorPrinter(CommentStream& infile, const TimeClass* const T
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in predatorprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in predatorprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -159,6 +168,17 @@ PredatorPrinter::PredatorPrinter(CommentStream& infile, const TimeClass* const T
   else
     outfile << "\n; year-step-area-pred length-prey length-number consumed\n";
 
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", LABELCOLUMN, printwidth, 0, &areaindex);
+    binout->addColumn("pred length", LABELCOLUMN, printwidth, 0, &predlenindex);
+    binout->addColumn("prey length", LABELCOLUMN, printwidth, 0, &preylenindex);
+    if (biomass)
+      binout->addColumn("biomass consumed", DOUBLECOLUMN, width, precision);
+    else
+      binout->addColumn("number consumed", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
@@ -278,6 +298,11 @@ void PredatorPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
     aggregator->NumberSum();
 
   int a, predl, preyl;
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < areas.Nrow(); a++) {
     dptr = aggregator->getSum()[a];
     for (predl = 0; predl < dptr->Nrow(); predl++) {
@@ -299,7 +324,31 @@ void PredatorPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   outfile.flush();
 }
 
+void PredatorPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, predl, preyl;
+  for (a = 0; a < areas.Nrow(); a++) {
+    dptr = aggregator->getSum()[a];
+    for (predl = 0; predl < dptr->Nrow(); predl++) {
+      for (preyl = 0; preyl < dptr->Ncol(predl); preyl++) {
+        binout->storeInt(TimeInfo->getYear());
+        binout->storeInt(TimeInfo->getStep());
+        binout->storeInt(a);
+        binout->storeInt(predl);
+        binout->storeInt(preyl);
+
+        //JMB crude filter to remove the 'silly' values from the output
+        if ((*dptr)[predl][preyl] < rathersmall)
+          binout->storeDouble(0.0);
+        else
+          binout->storeDouble((*dptr)[predl][preyl]);
+      }
+    }
+  }
+}
+
 PredatorPrinter::~PredatorPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   delete predLgrpDiv;
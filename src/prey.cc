@@ -167,6 +167,17 @@ void Prey::addBiomassConsumption(int area, const DoubleVector& predcons) {
     cons[inarea][i] += predcons[i];
 }
 
+//adds the consumption by biomass for all the length groups of the predator
+void Prey::addBiomassConsumption(int area, const DoubleMatrix& predcons) {
+  int i, j, inarea = this->areaNum(area);
+  for (j = 0; j < predcons.Nrow(); j++) {
+    if (predcons.Ncol(j) != cons[inarea].Size())
+      handle.logMessage(LOGFAIL, "Error in consumption - cannot add different size vectors");
+    for (i = 0; i < predcons.Ncol(j); i++)
+      cons[inarea][i] += predcons[j][i];
+  }
+}
+
 //adds the consumption by numbers
 void Prey::addNumbersConsumption(int area, const DoubleVector& predcons) {
   int i, inarea = this->areaNum(area);
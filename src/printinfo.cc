@@ -3,7 +3,7 @@
 #include "gadget.h"
 #include "global.h"
 
-PrintInfo::PrintInfo() : printiter(0), printoutput(0), givenPrecision(0) {
+PrintInfo::PrintInfo() : printiter(0), printoutput(0), givenPrecision(0), binaryoutput(0) {
 
   strOutputFile = NULL;
   strParamOutFile = NULL;
@@ -26,6 +26,7 @@ PrintInfo::PrintInfo(const PrintInfo& pi) {
   printoutput = pi.printoutput;
   givenPrecision = pi.givenPrecision;
   printiter = pi.printiter;
+  binaryoutput = pi.binaryoutput;
 }
 
 PrintInfo::~PrintInfo() {
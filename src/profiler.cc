@@ -0,0 +1,312 @@
+#include "profiler.h"
+#include "base.h"
+#include "likelihood.h"
+#include "errorhandler.h"
+#include "runid.h"
+#include "global.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#endif
+
+Profiler profile;
+
+/* the names of the phases, in the same order as the ProfilePhase enum */
+static const char* phaseNames[NUMPROFPHASES] = { "reset", "likelihoodreset", "tagging",
+  "print", "migrate", "calcnumbers", "calceat", "checkeat", "adjusteat", "reducepop",
+  "grow", "populationpart1", "populationpart2", "populationpart3", "populationpart4",
+  "populationpart5", "likelihood", "agepart1", "agepart2", "agepart3", "keeperupdate" };
+
+/* the names of the hardware counters, in the same order as the ProfileCounter enum */
+static const char* counterNames[NUMPROFCOUNTERS] = { "cycles", "instructions",
+  "cachemisses", "branchmisses" };
+
+Profiler::Profiler() : active(0), requested(0), printevals(0), counting(0), groupfd(-1),
+  numcounters(0), multiplexed(0), numsims(0), lasttime(0.0), simstart(0.0), simtime(0.0) {
+}
+
+Profiler::~Profiler() {
+  int i;
+  this->closeCounters();
+  for (i = 0; i < basenames.Size(); i++)
+    delete[] basenames[i];
+  for (i = 0; i < likenames.Size(); i++)
+    delete[] likenames[i];
+  for (i = 0; i < phasecounts.Size(); i++)
+    delete phasecounts[i];
+}
+
+void Profiler::Initialise(const char* filename, int evals, int counters) {
+  int i;
+  outfile.open(filename, ios::out);
+  handle.checkIfFailure(outfile, filename);
+  RUNID.Print(outfile);
+  if (counters) {
+    this->openCounters();
+    for (i = 0; i < NUMPROFCOUNTERS; i++)
+      if (counterfd[i] == -1)
+        outfile << "; Hardware counter " << counterNames[i] << " not available\n";
+  }
+  printevals = evals;
+  if (printevals) {
+    outfile << "; Time in seconds for each phase of each simulation\n; simulation"
+      << TAB << "total";
+    for (i = 0; i < NUMPROFPHASES; i++)
+      outfile << TAB << phaseNames[i];
+    outfile << endl;
+  }
+  requested = 1;
+}
+
+void Profiler::setObjects(const BaseClassPtrVector& basevec, const LikelihoodPtrVector& likevec) {
+  if ((!requested) || (active))
+    return;
+
+  int i, numobjects;
+  for (i = 0; i < basevec.Size(); i++) {
+    basenames.resize(new char[strlen(basevec[i]->getName()) + 1]);
+    strcpy(basenames[i], basevec[i]->getName());
+  }
+  for (i = 0; i < likevec.Size(); i++) {
+    likenames.resize(new char[strlen(likevec[i]->getName()) + 1]);
+    strcpy(likenames[i], likevec[i]->getName());
+  }
+
+  //JMB each phase has one entry for each stock or likelihood component, so some are unused
+  numobjects = max(1, max(basevec.Size(), likevec.Size()));
+  phasetimes.AddRows(NUMPROFPHASES, numobjects, 0.0);
+  lasttotals.resize(NUMPROFPHASES, 0.0);
+  if (counting)
+    for (i = 0; i < NUMPROFCOUNTERS; i++)
+      phasecounts.resize(new DoubleMatrix(NUMPROFPHASES, numobjects, 0.0));
+  active = 1;
+  handle.logMessage(LOGMESSAGE, "Started profiling the model simulation");
+}
+
+void Profiler::startSimulation() {
+  if (!active)
+    return;
+  simstart = getTime();
+  lasttime = simstart;
+  if (counting) {
+    this->readCounters(simstartcounts);
+    lastcounts = simstartcounts;
+  }
+}
+
+void Profiler::endSimulation() {
+  if (!active)
+    return;
+
+  int i, j;
+  double total, now = getTime();
+  simtime += now - simstart;
+  numsims++;
+  if (counting) {
+    this->readCounters(nowcounts);
+    for (i = 0; i < NUMPROFCOUNTERS; i++)
+      simcounts[i] += nowcounts[i] - simstartcounts[i];
+    lastcounts = nowcounts;
+  }
+
+  if (printevals) {
+    outfile << numsims << TAB << setprecision(smallprecision) << now - simstart;
+    for (i = 0; i < NUMPROFPHASES; i++) {
+      total = 0.0;
+      for (j = 0; j < phasetimes.Ncol(i); j++)
+        total += phasetimes[i][j];
+      outfile << TAB << total - lasttotals[i];
+      lasttotals[i] = total;
+    }
+    outfile << endl;
+  }
+  lasttime = now;
+}
+
+void Profiler::openCounters() {
+  int i;
+  counterfd.resize(NUMPROFCOUNTERS, -1);
+  counterpos.resize(NUMPROFCOUNTERS, -1);
+  lastcounts.resize(NUMPROFCOUNTERS, 0.0);
+  simstartcounts.resize(NUMPROFCOUNTERS, 0.0);
+  simcounts.resize(NUMPROFCOUNTERS, 0.0);
+  nowcounts.resize(NUMPROFCOUNTERS, 0.0);
+
+#ifdef __linux__
+  static const unsigned long long counterConfig[NUMPROFCOUNTERS] = { PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+  struct perf_event_attr attr;
+  for (i = 0; i < NUMPROFCOUNTERS; i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = counterConfig[i];
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    //JMB the first counter to open leads the group, and the group is enabled when all are open
+    attr.disabled = (groupfd == -1 ? 1 : 0);
+    counterfd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupfd, 0);
+    if (counterfd[i] == -1) {
+      handle.logMessage(LOGWARN, "Warning - failed to open hardware counter", counterNames[i]);
+    } else {
+      if (groupfd == -1)
+        groupfd = counterfd[i];
+      counterpos[i] = numcounters;
+      numcounters++;
+    }
+  }
+
+  if (groupfd != -1) {
+    ioctl(groupfd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(groupfd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    counting = 1;
+  }
+#endif
+
+  if (counting)
+    handle.logMessage(LOGMESSAGE, "Reading hardware counters for the profile, number of counters", numcounters);
+  else
+    handle.logMessage(LOGWARN, "Warning - hardware counters not available, only timing the phases");
+}
+
+void Profiler::closeCounters() {
+  int i;
+  counting = 0;
+  groupfd = -1;
+  for (i = 0; i < counterfd.Size(); i++) {
+    if (counterfd[i] != -1)
+      close(counterfd[i]);
+    counterfd[i] = -1;
+  }
+}
+
+void Profiler::readCounters(DoubleVector& counts) {
+#ifdef __linux__
+  int i;
+  //JMB the group is read as the number of counters, the time enabled, the time running and the values
+  unsigned long long data[NUMPROFCOUNTERS + 3];
+  if (read(groupfd, data, sizeof(data)) < (ssize_t)((numcounters + 3) * sizeof(unsigned long long))) {
+    handle.logMessage(LOGWARN, "Warning - failed to read hardware counters, stopped reading counters");
+    counting = 0;
+    return;
+  }
+  if (data[2] < data[1])
+    multiplexed = 1;
+  for (i = 0; i < NUMPROFCOUNTERS; i++)
+    if (counterpos[i] != -1)
+      counts[i] = (double)data[counterpos[i] + 3];
+#endif
+}
+
+void Profiler::addCounters(int phase, int id) {
+  int i;
+  this->readCounters(nowcounts);
+  for (i = 0; i < NUMPROFCOUNTERS; i++) {
+    (*phasecounts[i])[phase][id] += nowcounts[i] - lastcounts[i];
+    lastcounts[i] = nowcounts[i];
+  }
+}
+
+void Profiler::writeCounters(const DoubleVector& counts) {
+  if (phasecounts.Size() == 0)
+    return;
+
+  //JMB the miss rates are given per 1000 instructions
+  double ipc = (counts[PROFCYCLES] > verysmall ? counts[PROFINSTRUCTIONS] / counts[PROFCYCLES] : 0.0);
+  double scale = (counts[PROFINSTRUCTIONS] > verysmall ? 1000.0 / counts[PROFINSTRUCTIONS] : 0.0);
+  outfile << TAB << counts[PROFCYCLES] << TAB << counts[PROFINSTRUCTIONS] << TAB << ipc
+    << TAB << counts[PROFCACHEMISSES] << TAB << counts[PROFCACHEMISSES] * scale
+    << TAB << counts[PROFBRANCHMISSES] << TAB << counts[PROFBRANCHMISSES] * scale;
+}
+
+const char* Profiler::getObjectName(int phase, int id) const {
+  switch (phase) {
+    case PROFLIKERESET:
+    case PROFLIKELIHOOD:
+      return (id < likenames.Size() ? likenames[id] : 0);
+    case PROFTAGS:
+    case PROFPRINT:
+    case PROFKEEPER:
+      return (id == 0 ? "all" : 0);
+    default:
+      return (id < basenames.Size() ? basenames[id] : 0);
+  }
+}
+
+void Profiler::writeSummary() {
+  if (!requested)
+    return;
+  if (!active) {
+    //JMB the model was never initialised, so there is nothing to summarise
+    this->closeCounters();
+    outfile.close();
+    outfile.clear();
+    requested = 0;
+    return;
+  }
+
+  int i, j, k;
+  double total, phasetotal = 0.0;
+  double scale = (simtime > verysmall ? 100.0 / simtime : 0.0);
+  double persim = (numsims > 0 ? 1.0 / numsims : 0.0);
+  DoubleVector counts(NUMPROFCOUNTERS, 0.0);
+  DoubleVector othercounts(simcounts);
+
+  this->closeCounters();
+  if (multiplexed)
+    handle.logMessage(LOGWARN, "Warning - hardware counters were shared with other events, so the counts are incomplete");
+
+  outfile << "; Summary of the time spent on each phase of " << numsims << " simulations\n"
+    << "; phase\tname\tseconds\tpersimulation\tpercent";
+  if (phasecounts.Size() > 0)
+    outfile << "\tcycles\tinstructions\tipc\tcachemisses\tcachemissrate\tbranchmisses\tbranchmissrate";
+  outfile << endl;
+  outfile.precision(smallprecision);
+  for (i = 0; i < NUMPROFPHASES; i++) {
+    total = 0.0;
+    for (j = 0; j < phasetimes.Ncol(i); j++)
+      total += phasetimes[i][j];
+    for (k = 0; k < phasecounts.Size(); k++) {
+      counts[k] = 0.0;
+      for (j = 0; j < phasetimes.Ncol(i); j++)
+        counts[k] += (*phasecounts[k])[i][j];
+      if (i != PROFKEEPER)
+        othercounts[k] -= counts[k];
+    }
+    if (i != PROFKEEPER)
+      phasetotal += total;
+    outfile << phaseNames[i] << "\tall\t" << total << TAB << total * persim
+      << TAB << total * scale;
+    this->writeCounters(counts);
+    outfile << endl;
+  }
+  //JMB the keeper update is outside the simulation, so isnt included in this
+  outfile << "other\tall\t" << simtime - phasetotal << TAB << (simtime - phasetotal) * persim
+    << TAB << (simtime - phasetotal) * scale;
+  this->writeCounters(othercounts);
+  outfile << "\nsimulation\tall\t" << simtime << TAB << simtime * persim << TAB << 100;
+  this->writeCounters(simcounts);
+  outfile << endl;
+
+  for (i = 0; i < NUMPROFPHASES; i++) {
+    for (j = 0; j < phasetimes.Ncol(i); j++) {
+      if ((getObjectName(i, j) != 0) && (strcmp(getObjectName(i, j), "all") != 0)) {
+        outfile << phaseNames[i] << TAB << getObjectName(i, j) << TAB << phasetimes[i][j]
+          << TAB << phasetimes[i][j] * persim << TAB << phasetimes[i][j] * scale;
+        for (k = 0; k < phasecounts.Size(); k++)
+          counts[k] = (*phasecounts[k])[i][j];
+        this->writeCounters(counts);
+        outfile << endl;
+      }
+    }
+  }
+
+  outfile.close();
+  outfile.clear();
+  active = 0;
+  requested = 0;
+  handle.logMessage(LOGMESSAGE, "Written profile of the simulation, number of simulations", numsims);
+}
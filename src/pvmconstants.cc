@@ -9,6 +9,9 @@ PVMConstants::PVMConstants() {
   masterSendString = 5;
   masterReceiveData = 6;
   masterSendBound = 7;
+  masterSendPacked = 8;
+  masterReceivePacked = 9;
+  masterReceiveLikelihood = 10;
   dataEncode = 1;
 }
 
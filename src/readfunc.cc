@@ -160,7 +160,7 @@ void readAmounts(CommentStream& infile, const IntVector& tmpareas,
 }
 
 void readGrowthAmounts(CommentStream& infile, const TimeClass* const TimeInfo,
-  const AreaClass* const Area, FormulaMatrixPtrVector& amount,
+  const AreaClass* const Area, SparseFormulaMatrixPtrVector& amount,
   const CharPtrVector& lenindex, const IntVector& tmpareas) {
 
   int i, year, step, area;
@@ -210,8 +210,11 @@ void readGrowthAmounts(CommentStream& infile, const TimeClass* const TimeInfo,
       keepdata = 0;
 
     if (keepdata == 1) {
+      //JMB only keep a Formula for the entries that arent constant values
+      Formula tmpformula;
       count++;
-      infile >> (*amount[areaid])[timeid][lenid] >> ws;
+      infile >> tmpformula >> ws;
+      amount[areaid]->setFormula(timeid, lenid, tmpformula);
 
     } else { //data not required - skip rest of line
       reject++;
@@ -305,8 +305,14 @@ void Ecosystem::readOptimisation(CommentStream& infile) {
       optvec.resize(new OptInfoSimann());
     else if (strcasecmp(text, "[bfgs]") == 0)
       optvec.resize(new OptInfoBFGS());
+    else if (strcasecmp(text, "[lbfgs]") == 0)
+      optvec.resize(new OptInfoLBFGS());
+    else if (strcasecmp(text, "[cmaes]") == 0)
+      optvec.resize(new OptInfoCMAES());
+    else if (strcasecmp(text, "[bobyqa]") == 0)
+      optvec.resize(new OptInfoBOBYQA());
     else
-      handle.logFileUnexpected(LOGFAIL, "[hooke], [simann], or [bfgs]", text);
+      handle.logFileUnexpected(LOGFAIL, "[hooke], [simann], [bfgs], [lbfgs], [cmaes] or [bobyqa]", text);
 
     if (!infile.eof()) {
       infile >> text;
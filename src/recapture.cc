@@ -87,6 +87,7 @@ Recaptures::Recaptures(CommentStream& infile, const AreaClass* const Area,
   handle.Close();
   datafile.close();
   datafile.clear();
+  this->calcDataTerms();
 
   for (j = 0; j < tagnames.Size(); j++) {
     check = 0;
@@ -203,6 +204,21 @@ void Recaptures::readRecaptureData(CommentStream& infile,
   handle.logMessage(LOGMESSAGE, "Read recaptures data file - number of entries", count);
 }
 
+void Recaptures::calcDataTerms() {
+  int t, i, a, len;
+
+  //the observed data wont change, so the log factorials only need to be calculated once
+  for (t = 0; t < obsDistribution.Nrow(); t++) {
+    obsLogFactorial.resize();
+    for (i = 0; i < obsDistribution.Ncol(t); i++) {
+      obsLogFactorial[t].resize(new DoubleMatrix(obsDistribution[t][i]->Nrow(), obsDistribution[t][i]->Ncol(0), 0.0));
+      for (a = 0; a < obsDistribution[t][i]->Nrow(); a++)
+        for (len = 0; len < obsDistribution[t][i]->Ncol(a); len++)
+          (*obsLogFactorial[t][i])[a][len] = logFactorial((*obsDistribution[t][i])[a][len]);
+    }
+  }
+}
+
 Recaptures::~Recaptures() {
   int i, j;
   for (i = 0; i < fleetnames.Size(); i++)
@@ -216,6 +232,7 @@ Recaptures::~Recaptures() {
   for (i = 0; i < obsDistribution.Nrow(); i++) {
     for (j = 0; j < obsDistribution.Ncol(i); j++) {
       delete obsDistribution[i][j];
+      delete obsLogFactorial[i][j];
       delete modelDistribution[i][j];
     }
   }
@@ -234,9 +251,10 @@ Recaptures::~Recaptures() {
 void Recaptures::Reset(const Keeper* const keeper) {
   int i, j;
   Likelihood::Reset(keeper);
+  //JMB the modelled returns without observed returns are still indexed by modYears
   for (i = 0; i < newDistribution.Nrow(); i++)
     for (j = 0; j < newDistribution.Ncol(i); j++)
-      delete newDistribution[i][j];
+      (*newDistribution[i][j]).setToZero();
   for (i = 0; i < modelDistribution.Nrow(); i++)
     for (j = 0; j < modelDistribution.Ncol(i); j++)
       (*modelDistribution[i][j]).setToZero();
@@ -400,7 +418,7 @@ double Recaptures::calcLikPoisson(const TimeClass* const TimeInfo) {
           else if (x < verysmall)
             lik += verybig;
           else
-            lik -= -x + (n * log(x)) - logFactorial(n);
+            lik -= -x + (n * log(x)) - (*obsLogFactorial[t][timeid])[a][len];
 
         }
       }
@@ -110,6 +110,11 @@ RenewalData::RenewalData(CommentStream& infile, const IntVector& Areas,
   } else
     handle.logFileMessage(LOGFAIL, "unrecognised renewal data format", text);
 
+  //JMB store the renewal data by timestep so that it doesnt need to be searched on every timestep
+  renewalSchedule.AddRows(TimeInfo->numTotalSteps() + 1, 0, 0);
+  for (i = 0; i < renewalTime.Size(); i++)
+    renewalSchedule[renewalTime[i]].resize(1, i);
+
   keeper->clearLast();
 }
 
@@ -326,11 +331,13 @@ void RenewalData::readNumberData(CommentStream& infile, Keeper* const keeper,
         id = renewalTime.Size() - 1;
 
         renewalDistribution.resize(1, new AgeBandMatrix(age, poptmp));
-        renewalNumber.resize(new FormulaMatrix(maxage - minage + 1, numlen, 0.0));
+        renewalNumber.resize(new SparseFormulaMatrix(maxage - minage + 1, numlen, 0.0));
       }
 
       renewalDistribution[id][age][lengthid].N = 0.0;
-      infile >> (*renewalNumber[id])[age - minage][lengthid] >> ws;
+      Formula tmpformula;
+      infile >> tmpformula >> ws;
+      renewalNumber[id]->setFormula(age - minage, lengthid, tmpformula);
       infile >> renewalDistribution[id][age][lengthid].W >> ws;
       count++;
 
@@ -496,7 +503,7 @@ void RenewalData::Reset() {
       age = renewalAge[i];
       minage = renewalDistribution[i].minAge();
       for (l = renewalDistribution[i].minLength(age); l < renewalDistribution[i].maxLength(age); l++) {
-        renewalDistribution[i][age][l].N = (*renewalNumber[i])[age - minage][l];
+        renewalDistribution[i][age][l].N = renewalNumber[i]->getValue(age - minage, l);
         if (handle.getLogLevel() >= LOGWARN) {
           if (renewalDistribution[i][age][l].N < 0.0)
             handle.logMessage(LOGWARN, "Warning in renewal - negative number of recruits", renewalDistribution[i][age][l].N);
@@ -515,16 +522,19 @@ void RenewalData::Reset() {
 
 int RenewalData::isRenewalStepArea(int area, const TimeClass* const TimeInfo) {
   int i;
-  for (i = 0; i < renewalTime.Size(); i++)
-    if ((renewalTime[i] == TimeInfo->getTime()) && (renewalArea[i] == area))
+  const IntVector& renew = renewalSchedule[TimeInfo->getTime()];
+  for (i = 0; i < renew.Size(); i++)
+    if (renewalArea[renew[i]] == area)
       return 1;
   return 0;
 }
 
 void RenewalData::addRenewal(AgeBandMatrix& Alkeys, int area, const TimeClass* const TimeInfo) {
-  int i;
-  for (i = 0; i < renewalTime.Size(); i++) {
-    if ((renewalTime[i] == TimeInfo->getTime()) && (renewalArea[i] == area)) {
+  int i, j;
+  const IntVector& renew = renewalSchedule[TimeInfo->getTime()];
+  for (j = 0; j < renew.Size(); j++) {
+    i = renew[j];
+    if (renewalArea[i] == area) {
       index = i;
       if (readoption == 2)
         Alkeys.Add(renewalDistribution[i], *CI);
@@ -0,0 +1,225 @@
+#include "replicates.h"
+#include "localworkerpool.h"
+#include "errorhandler.h"
+#include "ecosystem.h"
+#include "runid.h"
+#include "gadget.h"
+#include "global.h"
+
+extern Ecosystem* EcoSystem;
+
+Replicates::Replicates(CommentStream& infile, const LikelihoodPtrVector& likevec) {
+
+  int i, j, seed;
+  char name[MaxStrLength];
+  char text[MaxStrLength];
+  char value[MaxStrLength];
+  strncpy(name, "", MaxStrLength);
+  strncpy(text, "", MaxStrLength);
+  strncpy(value, "", MaxStrLength);
+
+  numlike = likevec.Size();
+  //each line contains the name of the replicate, the type of replicate and the value
+  infile >> ws;
+  while (!infile.eof()) {
+    infile >> name >> text >> value >> ws;
+    for (i = 0; i < names.Size(); i++)
+      if (strcasecmp(names[i], name) == 0)
+        handle.logFileMessage(LOGFAIL, "repeated replicate", name);
+
+    if (strcasecmp(text, "jackknife") == 0) {
+      j = -1;
+      for (i = 0; i < likevec.Size(); i++)
+        if (strcasecmp(likevec[i]->getName(), value) == 0)
+          j = i;
+      if (j == -1)
+        handle.logFileMessage(LOGFAIL, "unrecognised likelihood component", value);
+      types.resize(1, JACKKNIFEREPLICATE);
+      values.resize(1, j);
+
+    } else if (strcasecmp(text, "bootstrap") == 0) {
+      seed = atoi(value);
+      if ((seed <= 0) || (strspn(value, "0123456789") != strlen(value)))
+        handle.logFileMessage(LOGFAIL, "bootstrap seed must be a positive integer", value);
+      types.resize(1, BOOTSTRAPREPLICATE);
+      values.resize(1, seed);
+
+    } else
+      handle.logFileUnexpected(LOGFAIL, "jackknife or bootstrap", text);
+
+    names.resize(new char[strlen(name) + 1]);
+    strcpy(names[names.Size() - 1], name);
+  }
+
+  if (names.Size() == 0)
+    handle.logFileMessage(LOGFAIL, "\nError in replicates - failed to read replicates");
+  handle.logMessage(LOGMESSAGE, "Read replicates file - number of replicates", names.Size());
+  results.AddRows(names.Size(), numlike + 2, 0.0);
+  finished.resize(names.Size(), 0);
+}
+
+Replicates::~Replicates() {
+  int i;
+  for (i = 0; i < names.Size(); i++)
+    delete[] names[i];
+}
+
+void Replicates::Optimise(int numworkers, const char* const filename, int prec) {
+  int i, j, rep, next, done, num;
+  int fromchild[2];
+  pid_t pid;
+
+  if (numworkers < 1)
+    numworkers = 1;
+  if (numworkers > names.Size())
+    numworkers = names.Size();
+
+  //each process is used for one replicate, and returns the number of function
+  //evaluations, the overall likelihood score and the scores from each likelihood component
+  IntVector pids(numworkers, 0);
+  IntVector receivefd(numworkers, -1);
+  IntVector running(numworkers, -1);
+  DoubleVector receivedata(numlike + 2, 0.0);
+  struct pollfd* fds = new struct pollfd[numworkers];
+
+  handle.logMessage(LOGINFO, "\nOptimising the replicates using", numworkers, "processes");
+  //JMB the replicate processes get a copy of anything that is still buffered
+  cout.flush();
+  cerr.flush();
+
+  next = 0;
+  done = 0;
+  while (done < names.Size()) {
+    //start the next replicate on any process that is free
+    for (i = 0; ((i < numworkers) && (next < names.Size())); i++) {
+      if (running[i] != -1)
+        continue;
+
+      if (pipe(fromchild) != 0)
+        handle.logMessage(LOGFAIL, "Error in replicates - failed to create pipe for replicate process");
+
+      pid = fork();
+      if (pid < 0)
+        handle.logMessage(LOGFAIL, "Error in replicates - failed to create replicate process");
+
+      if (pid == 0) {
+        //this is the replicate process, so close the pipes used by the other replicates
+        for (j = 0; j < numworkers; j++)
+          if (running[j] != -1)
+            close(receivefd[j]);
+        close(fromchild[0]);
+        this->runReplicate(next, fromchild[1], filename, prec);
+      }
+
+      close(fromchild[1]);
+      pids[i] = (int)pid;
+      receivefd[i] = fromchild[0];
+      running[i] = next;
+      handle.logMessage(LOGMESSAGE, "Started optimising replicate", names[next]);
+      next++;
+    }
+
+    for (i = 0; i < numworkers; i++) {
+      fds[i].fd = receivefd[i];
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+    }
+
+    num = poll(fds, numworkers, -1);
+    if ((num < 0) && (errno == EINTR))
+      continue;  //JMB the user has interrupted gadget, so try again
+    if (num < 0)
+      handle.logMessage(LOGFAIL, "Error in replicates - failed to wait for replicate processes");
+
+    for (i = 0; i < numworkers; i++) {
+      if ((running[i] == -1) || (fds[i].revents == 0))
+        continue;
+
+      rep = running[i];
+      if (LocalWorkerPool::readData(receivefd[i], &receivedata[0], numlike + 2)) {
+        for (j = 0; j < numlike + 2; j++)
+          results[rep][j] = receivedata[j];
+        finished[rep] = 1;
+        handle.logMessage(LOGINFO, "Finished optimising replicate", names[rep]);
+      } else
+        handle.logMessage(LOGWARN, "Warning in replicates - failed to optimise replicate", names[rep]);
+
+      close(receivefd[i]);
+      waitpid((pid_t)pids[i], NULL, 0);
+      receivefd[i] = -1;
+      running[i] = -1;
+      done++;
+    }
+  }
+  delete[] fds;
+}
+
+void Replicates::runReplicate(int rep, int outfile, const char* const filename, int prec) {
+  int i;
+  DoubleVector likes(numlike, 0.0);
+  DoubleVector outdata(numlike + 2, 0.0);
+  char* paramfile = new char[strlen(filename) + strlen(names[rep]) + 2];
+
+  //JMB the main process deals with any interrupts from the user, and any logging
+  signal(SIGINT, SIG_IGN);
+  signal(SIGTSTP, SIG_IGN);
+  handle.setLogLevel(LOGFAIL);
+
+  if (types[rep] == JACKKNIFEREPLICATE)
+    (EcoSystem->getModelLikelihoodVector())[values[rep]]->setWeight(0.0);
+  else
+    EcoSystem->resampleLikelihood(values[rep]);
+
+  EcoSystem->Optimise();
+  outdata[0] = EcoSystem->getFuncEval();
+  outdata[1] = EcoSystem->getOptLikelihoods(likes);
+  for (i = 0; i < numlike; i++)
+    outdata[i + 2] = likes[i];
+
+  strcpy(paramfile, filename);
+  strcat(paramfile, ".");
+  strcat(paramfile, names[rep]);
+  EcoSystem->writeParams(paramfile, prec);
+  delete[] paramfile;
+
+  LocalWorkerPool::writeData(outfile, &outdata[0], numlike + 2);
+
+  //JMB use _exit so that the output buffers copied from the main process are not written
+  close(outfile);
+  _exit(EXIT_SUCCESS);
+}
+
+void Replicates::writeSummary(const char* const filename, const LikelihoodPtrVector& likevec) {
+  int i, j;
+  ofstream outfile;
+  outfile.open(filename, ios::out);
+  handle.checkIfFailure(outfile, filename);
+  handle.Open(filename);
+  RUNID.Print(outfile);
+  outfile << "; Likelihood scores for the optimised bootstrap and jackknife replicates\n"
+    << "; -- data --\n; replicate type value evaluations score";
+  for (i = 0; i < likevec.Size(); i++)
+    outfile << sep << likevec[i]->getName();
+  outfile << endl;
+
+  for (i = 0; i < names.Size(); i++) {
+    outfile << names[i] << sep;
+    if (types[i] == JACKKNIFEREPLICATE)
+      outfile << "jackknife" << sep << likevec[values[i]]->getName();
+    else
+      outfile << "bootstrap" << sep << values[i];
+
+    if (!finished[i]) {
+      outfile << sep << "failed" << endl;
+      continue;
+    }
+
+    outfile << sep << (int)results[i][0] << sep << setprecision(largeprecision) << results[i][1];
+    for (j = 0; j < numlike; j++)
+      outfile << sep << setprecision(largeprecision) << results[i][j + 2];
+    outfile << endl;
+  }
+  handle.Close();
+  outfile.close();
+  outfile.clear();
+}
@@ -4,17 +4,18 @@
 #include "mathfunc.h"
 #include "errorhandler.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 SIByAcousticOnStep::SIByAcousticOnStep(CommentStream& infile, const IntMatrix& areas,
   const CharPtrVector& areaindex, const CharPtrVector& fleetindex,
   const TimeClass* const TimeInfo, const char* datafilename, const char* givenname, int bio)
-  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, fleetindex, givenname, bio, SIACOUSTIC) {
+  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, fleetindex, givenname, bio, SIACOUSTIC), aggregator(0) {
 }
 
 SIByAcousticOnStep::~SIByAcousticOnStep() {
   if (aggregator != 0)
-    delete aggregator;
+    aggcache.deleteAggregator(aggregator);
 }
 
 void SIByAcousticOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
@@ -46,7 +47,7 @@ void SIByAcousticOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVect
   for (i = 0; i < Ages.Ncol(); i++)
     Ages[0][i] = i + minage;
 
-  aggregator = new StockAggregator(Stocks, LgrpDiv, Areas, Ages);
+  aggregator = aggcache.getStockAggregator(Stocks, LgrpDiv, Areas, Ages);
 }
 
 void SIByAcousticOnStep::Sum(const TimeClass* const TimeInfo) {
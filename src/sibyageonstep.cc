@@ -4,19 +4,20 @@
 #include "mathfunc.h"
 #include "errorhandler.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 SIByAgeOnStep::SIByAgeOnStep(CommentStream& infile, const IntMatrix& areas,
   const IntMatrix& ages, const CharPtrVector& areaindex, const CharPtrVector& ageindex,
   const TimeClass* const TimeInfo, const char* datafilename, const char* givenname, int bio)
-  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, ageindex, givenname, bio, SIAGE) {
+  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, ageindex, givenname, bio, SIAGE), aggregator(0) {
 
   Ages = ages;
 }
 
 SIByAgeOnStep::~SIByAgeOnStep() {
   if (aggregator != 0)
-    delete aggregator;
+    aggcache.deleteAggregator(aggregator);
 }
 
 void SIByAgeOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
@@ -65,7 +66,7 @@ void SIByAgeOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& S
       handle.logMessage(LOGWARN, "Warning in surveyindex - maximum age greater than stock age");
   }
 
-  aggregator = new StockAggregator(Stocks, LgrpDiv, Areas, Ages);
+  aggregator = aggcache.getStockAggregator(Stocks, LgrpDiv, Areas, Ages);
 }
 
 void SIByAgeOnStep::Sum(const TimeClass* const TimeInfo) {
@@ -73,10 +74,7 @@ void SIByAgeOnStep::Sum(const TimeClass* const TimeInfo) {
     return;
 
   int a, i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveyindex - invalid timestep");
 
@@ -29,10 +29,7 @@ void SIByEffortOnStep::Sum(const TimeClass* const TimeInfo) {
     return;
 
   int a, i, j;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveyindex - invalid timestep");
 
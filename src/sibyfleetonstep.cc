@@ -4,13 +4,14 @@
 #include "mathfunc.h"
 #include "errorhandler.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 SIByFleetOnStep::SIByFleetOnStep(CommentStream& infile, const IntMatrix& areas,
   const DoubleVector& lengths, const CharPtrVector& areaindex,
   const CharPtrVector& lenindex, const TimeClass* const TimeInfo,
   const char* datafilename, const char* givenname, int bio)
-  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, lenindex, givenname, bio, SIFLEET) {
+  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, lenindex, givenname, bio, SIFLEET), aggregator(0) {
 
   LgrpDiv = new LengthGroupDivision(lengths);
   if (LgrpDiv->Error())
@@ -19,7 +20,7 @@ SIByFleetOnStep::SIByFleetOnStep(CommentStream& infile, const IntMatrix& areas,
 
 SIByFleetOnStep::~SIByFleetOnStep() {
   if (aggregator != 0)
-    delete aggregator;
+    aggcache.deleteAggregator(aggregator);
 }
 
 void SIByFleetOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
@@ -60,7 +61,7 @@ void SIByFleetOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector&
       handle.logMessage(LOGWARN, "Warning in surveyindex - maximum length group greater than stock length");
   }
 
-  aggregator = new FleetPreyAggregator(Fleets, Stocks, LgrpDiv, Areas, Ages, 0);
+  aggregator = aggcache.getFleetPreyAggregator(Fleets, Stocks, LgrpDiv, Areas, Ages, 0);
 }
 
 void SIByFleetOnStep::Sum(const TimeClass* const TimeInfo) {
@@ -68,10 +69,7 @@ void SIByFleetOnStep::Sum(const TimeClass* const TimeInfo) {
     return;
 
   int a, i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveyindex - invalid timestep");
 
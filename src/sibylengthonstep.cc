@@ -4,13 +4,14 @@
 #include "errorhandler.h"
 #include "mathfunc.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 SIByLengthOnStep::SIByLengthOnStep(CommentStream& infile, const IntMatrix& areas,
   const DoubleVector& lengths, const CharPtrVector& areaindex,
   const CharPtrVector& lenindex, const TimeClass* const TimeInfo,
   const char* datafilename, const char* givenname, int bio)
-  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, lenindex, givenname, bio, SILENGTH) {
+  : SIOnStep(infile, datafilename, areaindex, TimeInfo, areas, lenindex, givenname, bio, SILENGTH), aggregator(0) {
 
   LgrpDiv = new LengthGroupDivision(lengths);
   if (LgrpDiv->Error())
@@ -19,7 +20,7 @@ SIByLengthOnStep::SIByLengthOnStep(CommentStream& infile, const IntMatrix& areas
 
 SIByLengthOnStep::~SIByLengthOnStep() {
   if (aggregator != 0)
-    delete aggregator;
+    aggcache.deleteAggregator(aggregator);
 }
 
 void SIByLengthOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
@@ -58,7 +59,7 @@ void SIByLengthOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector
       handle.logMessage(LOGWARN, "Warning in surveyindex - maximum length group greater than stock length");
   }
 
-  aggregator = new StockAggregator(Stocks, LgrpDiv, Areas, Ages);
+  aggregator = aggcache.getStockAggregator(Stocks, LgrpDiv, Areas, Ages);
 }
 
 void SIByLengthOnStep::Sum(const TimeClass* const TimeInfo) {
@@ -66,10 +67,7 @@ void SIByLengthOnStep::Sum(const TimeClass* const TimeInfo) {
     return;
 
   int a, i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveyindex - invalid timestep");
 
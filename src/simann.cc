@@ -173,6 +173,7 @@
 #include "optinfo.h"
 #include "mathfunc.h"
 #include "doublevector.h"
+#include "doublematrix.h"
 #include "intvector.h"
 #include "errorhandler.h"
 #include "ecosystem.h"
@@ -190,7 +191,7 @@ void OptInfoSimann::OptimiseLikelihood() {
 
   double tmp, p, pp, ratio, nsdiv;
   double fopt, funcval, trialf;
-  int    a, i, j, k, l, offset, quit;
+  int    a, b, i, j, k, l, offset, quit, nbatch, accept;
   int    rchange, rcheck, rnumber;  //Used to randomise the order of the parameters
 
   handle.logMessage(LOGINFO, "\nStarting Simulated Annealing optimisation algorithm\n");
@@ -274,31 +275,40 @@ void OptInfoSimann::OptimiseLikelihood() {
       }
 
       for (j = 0; j < ns; j++) {
-        for (l = 0; l < nvars; l++) {
-          //Generate trialx, the trial value of x
-          for (i = 0; i < nvars; i++) {
-            if (i == param[l]) {
-              trialx[i] = x[i] + ((randomNumber() * 2.0) - 1.0) * vm[i];
-
-              //If trialx is out of bounds, try again until we find a point that is OK
-              if ((trialx[i] < lowerb[i]) || (trialx[i] > upperb[i])) {
-                //JMB - this used to just select a random point between the bounds
-                k = 0;
-                while ((trialx[i] < lowerb[i]) || (trialx[i] > upperb[i])) {
-                  trialx[i] = x[i] + ((randomNumber() * 2.0) - 1.0) * vm[i];
-                  k++;
-                  if (k > 10)  //we've had 10 tries to find a point neatly, so give up
-                    trialx[i] = lowerb[i] + (upperb[i] - lowerb[i]) * randomNumber();
+        l = 0;
+        while (l < nvars) {
+          //JMB generate a batch of trial points, each changing one parameter from x,
+          //so that the points can be calculated in parallel.  If one of these points
+          //is accepted then the rest of the batch is ignored, since they would have
+          //been generated from the old value of x
+          nbatch = min(EcoSystem->numWorkers(), nvars - l);
+          DoubleMatrix batchx(nbatch, nvars, 0.0);
+          DoubleVector batchf(nbatch, 0.0);
+          for (b = 0; b < nbatch; b++) {
+            //Generate trialx, the trial value of x
+            for (i = 0; i < nvars; i++) {
+              if (i == param[l + b]) {
+                batchx[b][i] = x[i] + ((randomNumber() * 2.0) - 1.0) * vm[i];
+
+                //If trialx is out of bounds, try again until we find a point that is OK
+                if ((batchx[b][i] < lowerb[i]) || (batchx[b][i] > upperb[i])) {
+                  //JMB - this used to just select a random point between the bounds
+                  k = 0;
+                  while ((batchx[b][i] < lowerb[i]) || (batchx[b][i] > upperb[i])) {
+                    batchx[b][i] = x[i] + ((randomNumber() * 2.0) - 1.0) * vm[i];
+                    k++;
+                    if (k > 10)  //we've had 10 tries to find a point neatly, so give up
+                      batchx[b][i] = lowerb[i] + (upperb[i] - lowerb[i]) * randomNumber();
+                  }
                 }
-              }
 
-            } else
-              trialx[i] = x[i];
+              } else
+                batchx[b][i] = x[i];
+            }
           }
 
-          //Evaluate the function with the trial point trialx and return as -trialf
-          trialf = EcoSystem->SimulateAndUpdate(trialx);
-          trialf = -trialf;
+          //Evaluate the function with the trial points
+          EcoSystem->SimulateAndUpdate(batchx, batchf);
 
           //If too many function evaluations occur, terminate the algorithm
           iters = EcoSystem->getFuncEval() - offset;
@@ -317,54 +327,68 @@ void OptInfoSimann::OptimiseLikelihood() {
             return;
           }
 
-          //Accept the new point if the new function value better
-          if ((trialf - funcval) > verysmall) {
+          for (b = 0; b < nbatch; b++) {
             for (i = 0; i < nvars; i++)
-              x[i] = trialx[i];
-            funcval = trialf;
-            nacc++;
-            nacp[param[l]]++;  //JMB - not sure about this ...
-
-          } else {
-            //Accept according to metropolis condition
-            p = expRep((trialf - funcval) / t);
-            pp = randomNumber();
-            if (pp < p) {
-              //Accept point
+              trialx[i] = batchx[b][i];
+            //the function is to be minimised so switch the sign of trialf
+            trialf = -batchf[b];
+            accept = 0;
+
+            //Accept the new point if the new function value better
+            if ((trialf - funcval) > verysmall) {
               for (i = 0; i < nvars; i++)
                 x[i] = trialx[i];
               funcval = trialf;
-              naccmet++;
-              nacp[param[l]]++;
+              nacc++;
+              nacp[param[l]]++;  //JMB - not sure about this ...
+              accept = 1;
+
             } else {
-              //Reject point
-              nrej++;
+              //Accept according to metropolis condition
+              p = expRep((trialf - funcval) / t);
+              pp = randomNumber();
+              if (pp < p) {
+                //Accept point
+                for (i = 0; i < nvars; i++)
+                  x[i] = trialx[i];
+                funcval = trialf;
+                naccmet++;
+                nacp[param[l]]++;
+                accept = 1;
+              } else {
+                //Reject point
+                nrej++;
+              }
             }
-          }
 
-          // JMB added check for really silly values
-          if (isZero(trialf)) {
-            handle.logMessage(LOGINFO, "Error in Simulated Annealing optimisation after", iters, "function evaluations, f(x) = 0");
-            converge = -1;
-            return;
-          }
-
-          //If greater than any other point, record as new optimum
-          if ((trialf > fopt) && (trialf == trialf)) {
-            for (i = 0; i < nvars; i++)
-              bestx[i] = trialx[i];
-            fopt = trialf;
+            // JMB added check for really silly values
+            if (isZero(trialf)) {
+              handle.logMessage(LOGINFO, "Error in Simulated Annealing optimisation after", iters, "function evaluations, f(x) = 0");
+              converge = -1;
+              return;
+            }
 
-            if (scale) {
+            //If greater than any other point, record as new optimum
+            if ((trialf > fopt) && (trialf == trialf)) {
               for (i = 0; i < nvars; i++)
-                scalex[i] = bestx[i] * init[i];
-              EcoSystem->storeVariables(-fopt, scalex);
-            } else
-              EcoSystem->storeVariables(-fopt, bestx);
-
-            handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
-            handle.logMessage(LOGINFO, "The likelihood score is", -fopt, "at the point");
-            EcoSystem->writeBestValues();
+                bestx[i] = trialx[i];
+              fopt = trialf;
+
+              if (scale) {
+                for (i = 0; i < nvars; i++)
+                  scalex[i] = bestx[i] * init[i];
+                EcoSystem->storeVariables(-fopt, scalex);
+              } else
+                EcoSystem->storeVariables(-fopt, bestx);
+
+              handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+              handle.logMessage(LOGINFO, "The likelihood score is", -fopt, "at the point");
+              EcoSystem->writeBestValues();
+            }
+
+            l++;
+            if (accept)
+              break;
           }
         }
       }
@@ -2,93 +2,140 @@
 #include "errorhandler.h"
 #include "gadget.h"
 #include "interruptinterface.h"
+#include "aggregatorcache.h"
+#include "profiler.h"
 #include "global.h"
 
 void Ecosystem::updatePredationOneArea(int area) {
   int i;
   // calculate the number of preys and predators in area.
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->calcNumbers(area, TimeInfo);
+      profile.addTime(PROFCALCNUMBERS, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->calcEat(area, Area, TimeInfo);
+      profile.addTime(PROFCALCEAT, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->checkEat(area, TimeInfo);
+      profile.addTime(PROFCHECKEAT, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->adjustEat(area, TimeInfo);
+      profile.addTime(PROFADJUSTEAT, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->reducePop(area, TimeInfo);
+      profile.addTime(PROFREDUCEPOP, i);
+    }
 }
 
 void Ecosystem::updatePopulationOneArea(int area) {
   int i;
   // under updates are movements to mature stock, renewal, spawning and straying.
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->Grow(area, Area, TimeInfo);
+      profile.addTime(PROFGROW, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updatePopulationPart1(area, TimeInfo);
+      profile.addTime(PROFPOPPART1, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updatePopulationPart2(area, TimeInfo);
+      profile.addTime(PROFPOPPART2, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updatePopulationPart3(area, TimeInfo);
+      profile.addTime(PROFPOPPART3, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updatePopulationPart4(area, TimeInfo);
+      profile.addTime(PROFPOPPART4, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updatePopulationPart5(area, TimeInfo);
+      profile.addTime(PROFPOPPART5, i);
+    }
 }
 
 void Ecosystem::updateAgesOneArea(int area) {
   int i;
   // age related update and movements between stocks.
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updateAgePart1(area, TimeInfo);
+      profile.addTime(PROFAGEPART1, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updateAgePart2(area, TimeInfo);
+      profile.addTime(PROFAGEPART2, i);
+    }
   for (i = 0; i < basevec.Size(); i++)
-    if (basevec[i]->isInArea(area))
+    if (basevec[i]->isInArea(area)) {
       basevec[i]->updateAgePart3(area, TimeInfo);
+      profile.addTime(PROFAGEPART3, i);
+    }
 }
 
 void Ecosystem::Simulate(int print) {
   int i, j, k;
+  double like;
 
   handle.logMessage(LOGMESSAGE, "");  //write blank line to log file
-  for (j = 0; j < likevec.Size(); j++)
+  restoremodel = 0;
+  profile.startSimulation();
+  for (j = 0; j < likevec.Size(); j++) {
     likevec[j]->Reset(keeper);
-  for (j = 0; j < likevec.Size(); j++)
+    profile.addTime(PROFLIKERESET, j);
+  }
+  for (j = 0; j < likevec.Size(); j++) {
     likevec[j]->addLikelihoodKeeper(TimeInfo, keeper);
+    profile.addTime(PROFLIKERESET, j);
+  }
 
   for (j = 0; j < tagvec.Size(); j++)
     tagvec[j]->Reset();
+  profile.addTime(PROFTAGS, 0);
 
   TimeInfo->Reset();
   for (i = 0; i < TimeInfo->numTotalSteps(); i++) {
-    for (j = 0; j < basevec.Size(); j++)
+    for (j = 0; j < basevec.Size(); j++) {
       basevec[j]->Reset(TimeInfo);
+      profile.addTime(PROFRESET, j);
+    }
 
     // add in any new tagging experiments
     tagvec.updateTags(TimeInfo);
+    profile.addTime(PROFTAGS, 0);
 
+    //JMB the model doesnt change while the printers are called, so the aggregators can be shared
+    aggcache.startSection();
     if (print)
-      for (j = 0; j < printvec.Size(); j++)
-        printvec[j]->Print(TimeInfo, 1);  //start of timestep, so printtime is 1
+      for (j = 0; j < startPrintSchedule[i].Size(); j++)
+        printvec[startPrintSchedule[i][j]]->Print(TimeInfo, 1);  //start of timestep, so printtime is 1
+    aggcache.endSection();
+    profile.addTime(PROFPRINT, 0);
 
     // migration between areas
     if (Area->numAreas() > 1)    //no migration if there is only one area
-      for (j = 0; j < basevec.Size(); j++)
+      for (j = 0; j < basevec.Size(); j++) {
         basevec[j]->Migrate(TimeInfo);
+        profile.addTime(PROFMIGRATE, j);
+      }
 
     // predation can be split into substeps
     for (k = 0; k < TimeInfo->numSubSteps(); k++) {
@@ -101,34 +148,46 @@ void Ecosystem::Simulate(int print) {
     for (j = 0; j < Area->numAreas(); j++)
       this->updatePopulationOneArea(j);
 
-    for (j = 0; j < likevec.Size(); j++)
-      likevec[j]->addLikelihood(TimeInfo);
+    //JMB the model doesnt change while the likelihood components and printers are called
+    aggcache.startSection();
+    for (j = 0; j < likeSchedule[i].Size(); j++) {
+      k = likeSchedule[i][j];
+      if (resample) {
+        like = likevec[k]->getUnweightedLikelihood();
+        likevec[k]->addLikelihood(TimeInfo);
+        likevec[k]->resampleLikelihood(like, resampleweights[k][i]);
+      } else
+        likevec[k]->addLikelihood(TimeInfo);
+      profile.addTime(PROFLIKELIHOOD, k);
+    }
 
     if (print)
-      for (j = 0; j < printvec.Size(); j++)
-        printvec[j]->Print(TimeInfo, 0);  //end of timestep, so printtime is 0
+      for (j = 0; j < endPrintSchedule[i].Size(); j++)
+        printvec[endPrintSchedule[i][j]]->Print(TimeInfo, 0);  //end of timestep, so printtime is 0
+    aggcache.endSection();
+    profile.addTime(PROFPRINT, 0);
+
+    //JMB stop the simulation if the likelihood score is already worse than the bound
+    //checkbound is only set when every component is cumulative, so the score cannot decrease
+    if (checkbound) {
+      likelihood = 0.0;
+      for (j = 0; j < likevec.Size(); j++)
+        likelihood += likevec[j]->getLikelihood();
+      if (likelihood > likebound) {
+        handle.logMessage(LOGMESSAGE, "\nStopping the simulation early on timestep", TimeInfo->getTime());
+        restoremodel = 2;
+        break;
+      }
+    }
 
     for (j = 0; j < Area->numAreas(); j++)
       this->updateAgesOneArea(j);
 
-#ifdef INTERRUPT_HANDLER
-    if (interrupted) {
-      InterruptInterface ui;
-      if (!ui.menu()) {
-        handle.logMessage(LOGMESSAGE, "\n** Gadget interrupted - quitting current simulation **");
-        char interruptfile[15];
-        strncpy(interruptfile, "", 15);
-        strcpy(interruptfile, "interrupt.out");
-        this->writeParams(interruptfile, 0);
-        handle.logMessage(LOGMESSAGE, "** Gadget interrupted - quitting current simulation **");
-        exit(EXIT_SUCCESS);
-      }
-      interrupted = 0;
-    }
-#endif
+    this->checkInterrupted();
 
     // remove any expired tagging experiments
     tagvec.deleteTags(TimeInfo);
+    profile.addTime(PROFTAGS, 0);
 
     // increase the time in the simulation
     TimeInfo->IncrementTime();
@@ -136,6 +195,8 @@ void Ecosystem::Simulate(int print) {
 
   // remove all the tagging experiments - they must have expired now
   tagvec.deleteAllTags();
+  profile.addTime(PROFTAGS, 0);
+  profile.endSimulation();
 
   likelihood = 0.0;
   for (j = 0; j < likevec.Size(); j++)
@@ -148,3 +209,25 @@ void Ecosystem::Simulate(int print) {
     handle.logMessage(LOGMESSAGE, "\nThe current overall likelihood score is", likelihood);
   }
 }
+
+void Ecosystem::checkInterrupted() {
+#ifdef INTERRUPT_HANDLER
+  if (interrupted) {
+    InterruptInterface ui;
+    if (!ui.menu()) {
+      handle.logMessage(LOGMESSAGE, "\n** Gadget interrupted - quitting current simulation **");
+      char interruptfile[15];
+      strncpy(interruptfile, "", 15);
+      strcpy(interruptfile, "interrupt.out");
+      this->writeParams(interruptfile, 0);
+      //JMB stop any parallel processes before quitting
+      if (workers != 0)
+        delete workers;
+      workers = 0;
+      handle.logMessage(LOGMESSAGE, "** Gadget interrupted - quitting current simulation **");
+      exit(EXIT_SUCCESS);
+    }
+    interrupted = 0;
+  }
+#endif
+}
@@ -279,10 +279,7 @@ void SIOnStep::printLikelihood(ofstream& outfile, const TimeClass* const TimeInf
 
   int a, i;
   if (AAT.atCurrentTime(TimeInfo)) {
-    timeindex = -1;
-    for (i = 0; i < Years.Size(); i++)
-      if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-        timeindex = i;
+    timeindex = AAT.getTimeIndex(TimeInfo);
     if (timeindex == -1)
       handle.logMessage(LOGFAIL, "Error in surveyindex - invalid timestep");
 
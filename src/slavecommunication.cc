@@ -13,6 +13,11 @@ SlaveCommunication::SlaveCommunication()
   	netDataVar = NULL;
   	tmout.tv_sec = MAXWAIT;
   	tmout.tv_usec = 0;
+  	packedMode = 0;
+  	packedData = NULL;
+  	stopMessage = 0;
+  	packedRequest[0] = MPI_REQUEST_NULL;
+  	packedRequest[1] = MPI_REQUEST_NULL;
 }
 
 SlaveCommunication::~SlaveCommunication() 
@@ -23,6 +28,8 @@ SlaveCommunication::~SlaveCommunication()
     	delete netDataVar;
     	netDataVar = NULL;
   	}
+  	if (packedData != NULL)
+    	delete[] packedData;
 }
 
 void SlaveCommunication::printErrorMsg(const char* errorMsg) 
@@ -105,10 +112,11 @@ int SlaveCommunication::startNetCommunication()
 
 void SlaveCommunication::stopNetCommunication() 
 {
+	this->cancelPacked();
 	MPI_Finalize();
 }
 
-int SlaveCommunication::sendToMaster(double res) 
+int SlaveCommunication::sendToMaster(double res, const DoubleVector& likes) 
 {
   	int info;
   	assert(netDataVar != NULL);
@@ -130,7 +138,10 @@ int SlaveCommunication::sendToMaster(double res)
     	sendData->result = res;
     	sendData->x_id = netDataVar->x_id;
     	sendData->tag = netDataVar->tag;
-    	info = send(sendData);
+    	if (packedMode)
+    		info = sendPacked(sendData, likes);
+    	else
+    		info = send(sendData);
     	delete sendData;
     	if (info > 0) 
 		{
@@ -169,6 +180,10 @@ int SlaveCommunication::receiveFromMaster()
 	MPI_Status status;
 	MPI_Comm parentcomm;
 	MPI_Comm_get_parent(&parentcomm);
+
+	//the next vector may already have been received
+	if (packedMode)
+		return this->receiveQueued();
     
 	// Hér er hægt að nota non-blocking probe til að komast eitthvað til móts við þetta timeout, hægt
 	// að láta það bíða í einhvern tíma og probe-a aftur... Hérna gæti verið góð pæling að útfæra bara
@@ -214,6 +229,17 @@ int SlaveCommunication::receiveFromMaster()
     		return 1;
     	}
     	return 0;
+    } 
+	else if (status.MPI_TAG == pvmConst->getMasterSendPackedTag()) 
+	{
+    	//There is an incoming message of packed NetDataVariables
+    	info = receivePacked();
+    	if (info > 0) 
+		{
+    		typeReceived = pvmConst->getMasterSendVarTag();
+    		return 1;
+    	}
+    	return 0;
     } 
 	else 
 	{
@@ -351,4 +377,120 @@ void SlaveCommunication::getBound(double* vec) {
   int i;
   for (i = 0; i < numVar; i++)
     vec[i] = netDataDouble[i];
-}
\ No newline at end of file
+}
+
+/* JMB the packed communication sends each vector from the master as a single */
+/* message of numVar + 2 doubles (the tag, the id and then the values).  The  */
+/* result is sent back to the master as a message of 4 doubles (the tag, the  */
+/* id, the identity of the slave and the result) with the packed result tag. */
+/* If the master has asked for the likelihood component scores, these are     */
+/* then sent as a second message (the tag, the id and then the unweighted     */
+/* score from each likelihood component) with the likelihood tag.  After the  */
+/* first packed vector has been received, the receive for the next vector is  */
+/* posted straight away, so the master can queue several vectors for each     */
+/* slave and the next vector is transferred while the current vector is       */
+/* calculated                                                                 */
+void SlaveCommunication::postPackedReceive() {
+  MPI_Comm parentcomm;
+  MPI_Comm_get_parent(&parentcomm);
+  MPI_Irecv(packedData, numVar + 2, MPI_DOUBLE, 0, pvmConst->getMasterSendPackedTag(), parentcomm, &packedRequest[0]);
+  if (packedRequest[1] == MPI_REQUEST_NULL)
+    MPI_Irecv(&stopMessage, 1, MPI_INT, 0, pvmConst->getStopTag(), parentcomm, &packedRequest[1]);
+}
+
+int SlaveCommunication::receivePacked() {
+  int i;
+  MPI_Status status;
+  MPI_Comm parentcomm;
+  MPI_Comm_get_parent(&parentcomm);
+  if (packedData == NULL)
+    packedData = new double[numVar + 2];
+
+  MPI_Recv(packedData, numVar + 2, MPI_DOUBLE, 0, pvmConst->getMasterSendPackedTag(), parentcomm, &status);
+  netDataVar->tag = (int)packedData[0];
+  netDataVar->x_id = (int)packedData[1];
+  for (i = 0; i < numVar; i++)
+    netDataVar->x[i] = packedData[i + 2];
+
+  packedMode = 1;
+  this->postPackedReceive();
+  return 1;
+}
+
+int SlaveCommunication::receiveQueued() {
+  int i, index, flag, waiting;
+  MPI_Status status;
+  MPI_Comm parentcomm;
+  MPI_Comm_get_parent(&parentcomm);
+
+  //JMB only the packed data and stop messages match the receives that have been posted,
+  //so check for any other message from the master rather than waiting for it forever
+  flag = 0;
+  while (!flag) {
+    MPI_Testany(2, packedRequest, &index, &flag, &status);
+    if (flag)
+      break;
+
+    MPI_Iprobe(0, MPI_ANY_TAG, parentcomm, &waiting, &status);
+    if ((waiting) && (status.MPI_TAG != pvmConst->getMasterSendPackedTag())
+        && (status.MPI_TAG != pvmConst->getStopTag())) {
+      cerr << "Error in slavecommunication - received unrecognised tag of type "
+        << status.MPI_TAG << " while waiting for packed data\n";
+      this->cancelPacked();
+      typeReceived = -1;
+      return 0;
+    }
+    usleep(100);
+  }
+  if (index == 1) {
+    //receive information from master to quit
+    this->cancelPacked();
+    typeReceived = pvmConst->getStopTag();
+    return 0;
+  }
+
+  netDataVar->tag = (int)packedData[0];
+  netDataVar->x_id = (int)packedData[1];
+  for (i = 0; i < numVar; i++)
+    netDataVar->x[i] = packedData[i + 2];
+
+  //JMB the vector has been copied so the buffer can be reused straight away
+  this->postPackedReceive();
+  typeReceived = pvmConst->getMasterSendVarTag();
+  return 1;
+}
+
+int SlaveCommunication::sendPacked(NetDataResult* sendData, const DoubleVector& likes) {
+  int i;
+  double data[4];
+  MPI_Comm parentcomm;
+  MPI_Comm_get_parent(&parentcomm);
+  data[0] = sendData->tag;
+  data[1] = sendData->x_id;
+  data[2] = sendData->who;
+  data[3] = sendData->result;
+  MPI_Send(data, 4, MPI_DOUBLE, 0, pvmConst->getMasterReceivePackedTag(), parentcomm);
+
+  //JMB the scores from each likelihood component are only sent if the master has asked for them,
+  //using a separate message so that the packed result is the same for any other master
+  if (likes.Size() > 0) {
+    DoubleVector likedata(likes.Size() + 2, 0.0);
+    likedata[0] = sendData->tag;
+    likedata[1] = sendData->x_id;
+    for (i = 0; i < likes.Size(); i++)
+      likedata[i + 2] = likes[i];
+    MPI_Send(&likedata[0], likedata.Size(), MPI_DOUBLE, 0, pvmConst->getMasterReceiveLikelihoodTag(), parentcomm);
+  }
+  return 1;
+}
+
+void SlaveCommunication::cancelPacked() {
+  int i;
+  for (i = 0; i < 2; i++) {
+    if (packedRequest[i] != MPI_REQUEST_NULL) {
+      MPI_Cancel(&packedRequest[i]);
+      MPI_Wait(&packedRequest[i], MPI_STATUS_IGNORE);
+    }
+  }
+  packedMode = 0;
+}
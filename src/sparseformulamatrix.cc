@@ -0,0 +1,81 @@
+#include "sparseformulamatrix.h"
+#include "gadget.h"
+
+SparseFormulaMatrix::SparseFormulaMatrix(int nr, int nc, double initial) {
+  int i;
+  nrow = (nr > 0 ? nr : 0);
+  ncol = (nc > 0 ? nc : 0);
+  formulas = 0;
+  if ((nrow * ncol) > 0) {
+    values = new double[nrow * ncol];
+    for (i = 0; i < nrow * ncol; i++)
+      values[i] = initial;
+  } else
+    values = 0;
+}
+
+SparseFormulaMatrix::~SparseFormulaMatrix() {
+  int i;
+  if (formulas != 0) {
+    for (i = 0; i < nrow * ncol; i++)
+      if (formulas[i] != 0)
+        delete formulas[i];
+    delete[] formulas;
+    formulas = 0;
+  }
+  if (values != 0) {
+    delete[] values;
+    values = 0;
+  }
+}
+
+Formula& SparseFormulaMatrix::getFormula(int row, int col) {
+  int i, pos;
+  pos = row * ncol + col;
+  if (formulas == 0) {
+    formulas = new Formula*[nrow * ncol];
+    for (i = 0; i < nrow * ncol; i++)
+      formulas[i] = 0;
+  }
+  if (formulas[pos] == 0)
+    formulas[pos] = new Formula(values[pos]);
+  return *formulas[pos];
+}
+
+void SparseFormulaMatrix::setFormula(int row, int col, const Formula& F) {
+  int pos = row * ncol + col;
+  if (F.getType() == CONSTANT) {
+    values[pos] = F;
+    if ((formulas != 0) && (formulas[pos] != 0)) {
+      delete formulas[pos];
+      formulas[pos] = 0;
+    }
+  } else
+    this->getFormula(row, col) = F;
+}
+
+void SparseFormulaMatrix::Inform(Keeper* keeper) {
+  if (formulas == 0)
+    return;
+
+  int i, count;
+  count = 0;
+  for (i = 0; i < nrow * ncol; i++) {
+    if (formulas[i] != 0) {
+      if ((*formulas[i]).getType() == CONSTANT) {
+        //JMB no need to keep a Formula for a constant value
+        values[i] = *formulas[i];
+        delete formulas[i];
+        formulas[i] = 0;
+      } else {
+        (*formulas[i]).Inform(keeper);
+        count++;
+      }
+    }
+  }
+
+  if (count == 0) {
+    delete[] formulas;
+    formulas = 0;
+  }
+}
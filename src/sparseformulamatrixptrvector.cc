@@ -0,0 +1,53 @@
+#include "sparseformulamatrixptrvector.h"
+#include "gadget.h"
+
+SparseFormulaMatrixPtrVector::SparseFormulaMatrixPtrVector(const SparseFormulaMatrixPtrVector& initial) {
+  size = initial.size;
+  int i;
+  if (size > 0) {
+    v = new SparseFormulaMatrix*[size];
+    for (i = 0; i < size; i++)
+      v[i] = initial.v[i];
+  } else
+    v = 0;
+}
+
+SparseFormulaMatrixPtrVector::~SparseFormulaMatrixPtrVector() {
+  if (v != 0) {
+    delete[] v;
+    v = 0;
+  }
+}
+
+void SparseFormulaMatrixPtrVector::resize(SparseFormulaMatrix* value) {
+  int i;
+  if (v == 0) {
+    v = new SparseFormulaMatrix*[1];
+  } else {
+    SparseFormulaMatrix** vnew = new SparseFormulaMatrix*[size + 1];
+    for (i = 0; i < size; i++)
+      vnew[i] = v[i];
+    delete[] v;
+    v = vnew;
+  }
+  v[size] = value;
+  size++;
+}
+
+void SparseFormulaMatrixPtrVector::Delete(int pos) {
+  int i;
+  if (size > 1) {
+    SparseFormulaMatrix** vnew = new SparseFormulaMatrix*[size - 1];
+    for (i = 0; i < pos; i++)
+      vnew[i] = v[i];
+    for (i = pos; i < size - 1; i++)
+      vnew[i] = v[i + 1];
+    delete[] v;
+    v = vnew;
+    size--;
+  } else {
+    delete[] v;
+    v = 0;
+    size = 0;
+  }
+}
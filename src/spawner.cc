@@ -181,6 +181,27 @@ SpawnData::SpawnData(CommentStream& infile, int maxage, const LengthGroupDivisio
     infile >> text >> ws;
     handle.logFileUnexpected(LOGFAIL, "<end of file>", text);
   }
+
+  //JMB store the timesteps and areas when the spawning takes place
+  int j, time, year, step;
+  spawnSchedule.AddRows(TimeInfo->numTotalSteps() + 1, Area->numAreas(), 0);
+  year = TimeInfo->getFirstYear();
+  step = TimeInfo->getFirstStep();
+  for (time = 1; time <= TimeInfo->numTotalSteps(); time++) {
+    if ((year >= spawnFirstYear) && (year <= spawnLastYear))
+      for (i = 0; i < spawnStep.Size(); i++)
+        if (spawnStep[i] == step)
+          for (j = 0; j < spawnArea.Size(); j++)
+            if (spawnArea[j] >= 0)
+              spawnSchedule[time][spawnArea[j]] = 1;
+
+    if (step == TimeInfo->numSteps()) {
+      step = 1;
+      year++;
+    } else
+      step++;
+  }
+
   handle.logMessage(LOGMESSAGE, "Read spawning data file");
   keeper->clearLast();
 }
@@ -328,9 +349,8 @@ void SpawnData::addSpawnStock(int area, const TimeClass* const TimeInfo) {
     tmp = 0.0;  //JMB dummy temperature of zero
     total = calcRecruitNumber(tmp, inarea) / sum;
     for (len = 0; len < spawnLgrpDiv->numLengthGroups(); len++) {
-      length = spawnLgrpDiv->meanLength(len);
       Storage[inarea][spawnAge][len].N *= total;
-      Storage[inarea][spawnAge][len].W = stockParameters[2] * pow(length, stockParameters[3]);
+      Storage[inarea][spawnAge][len].W = stockParameters[2] * pow(spawnLgrpDiv->meanLength(len), stockParameters[3]);
     }
 
     //add this to the spawned stocks
@@ -345,16 +365,7 @@ void SpawnData::addSpawnStock(int area, const TimeClass* const TimeInfo) {
 }
 
 int SpawnData::isSpawnStepArea(int area, const TimeClass* const TimeInfo) {
-  int i, j;
-
-  if ((TimeInfo->getYear() < spawnFirstYear) || (TimeInfo->getYear() > spawnLastYear))
-    return 0;
-
-  for (i = 0; i < spawnStep.Size(); i++)
-    for (j = 0; j < spawnArea.Size(); j++)
-      if ((spawnStep[i] == TimeInfo->getStep()) && (spawnArea[j] == area))
-        return 1;
-  return 0;
+  return spawnSchedule[TimeInfo->getTime()][area];
 }
 
 void SpawnData::Reset(const TimeClass* const TimeInfo) {
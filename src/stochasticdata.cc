@@ -20,6 +20,17 @@ StochasticData::StochasticData(const char* const filename) {
     handle.logMessage(LOGFAIL, "Error in stochasticdata - failed to read values");
 }
 
+#ifdef GADGET_NETWORK
+StochasticData::StochasticData() {
+  netrun = 1;
+  readInfo = NULL;
+  slave = new SlaveCommunication();
+  getdata = 0;
+  dataFromMaster = NULL;
+  this->readFromNetwork();
+}
+#endif
+
 StochasticData::StochasticData(const char* const filename, int p) {
   //netrun = 1;
   netrun = p;
@@ -167,8 +178,8 @@ void StochasticData::readNextLineFromNetwork() {
   }
 }
 
-void StochasticData::sendDataToNetwork(double score) {
-  int info = slave->sendToMaster(score);
+void StochasticData::sendDataToNetwork(double score, const DoubleVector& likes) {
+  int info = slave->sendToMaster(score, likes);
   if (info < 0) {
     slave->stopNetCommunication();
     handle.logMessage(LOGFAIL, "Error in stochasticdata - failed to send data to PVM master");
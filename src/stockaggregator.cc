@@ -1,16 +1,19 @@
 #include "stockaggregator.h"
 #include "conversionindex.h"
 #include "stock.h"
+#include "aggregatorcache.h"
 #include "mathfunc.h"
 #include "errorhandler.h"
 #include "gadget.h"
 #include "global.h"
 
 StockAggregator::StockAggregator(const StockPtrVector& Stocks,
-  const LengthGroupDivision* const LgrpDiv, const IntMatrix& Areas, const IntMatrix& Ages)
-  : stocks(Stocks), areas(Areas), ages(Ages), alptr(0) {
+  const LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas, const IntMatrix& Ages)
+  : stocks(Stocks), areas(Areas), ages(Ages), alptr(0), section(0) {
 
   int i;
+  //JMB store a copy of the length group division so that it can be compared later
+  LgrpDiv = new LengthGroupDivision(*Lgrpdiv);
   for (i = 0; i < stocks.Size(); i++) {
     CI.resize(new ConversionIndex(stocks[i]->getLengthGroupDiv(), LgrpDiv));
     if (CI[i]->Error())
@@ -29,6 +32,22 @@ StockAggregator::~StockAggregator() {
   int i;
   for (i = 0; i < CI.Size(); i++)
     delete CI[i];
+  delete LgrpDiv;
+}
+
+int StockAggregator::isSameAggregation(const StockPtrVector& Stocks,
+  const LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas, const IntMatrix& Ages) const {
+
+  int i;
+  if (stocks.Size() != Stocks.Size())
+    return 0;
+  //JMB the order of the stocks matters, since it changes the order of the sums
+  for (i = 0; i < stocks.Size(); i++)
+    if (stocks[i] != Stocks[i])
+      return 0;
+  if ((!LgrpDiv->isSame(Lgrpdiv)) || (!areas.isSame(Areas)) || (!ages.isSame(Ages)))
+    return 0;
+  return 1;
 }
 
 void StockAggregator::Print(ofstream& outfile) const {
@@ -52,6 +71,11 @@ void StockAggregator::Reset() {
 void StockAggregator::Sum() {
   int area, age, i, j, k;
 
+  //JMB the stocks wont change until the model moves on, so only calculate this once
+  if ((aggcache.getSection() != 0) && (section == aggcache.getSection()))
+    return;
+  section = aggcache.getSection();
+
   this->Reset();
   //Sum over the appropriate stocks, areas, ages and length groups.
   for (i = 0; i < stocks.Size(); i++) {
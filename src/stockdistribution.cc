@@ -9,6 +9,7 @@
 #include "mathfunc.h"
 #include "stockprey.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 StockDistribution::StockDistribution(CommentStream& infile,
@@ -183,6 +184,9 @@ StockDistribution::StockDistribution(CommentStream& infile,
       handle.logMessage(LOGWARN, "Warning in stockdistribution - unrecognised function", functionname);
       break;
   }
+
+  if (functionnumber == 1)
+    this->calcDataTerms(numarea, numage, numlen);
 }
 
 void StockDistribution::readStockData(CommentStream& infile,
@@ -263,12 +267,9 @@ void StockDistribution::readStockData(CommentStream& infile,
         timeid = (Years.Size() - 1);
 
         obsDistribution.resize();
-        modelDistribution.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsDistribution[timeid].resize(new DoubleMatrix(numstock, (numage * numlen), 0.0));
-          modelDistribution[timeid].resize(new DoubleMatrix(numstock, (numage * numlen), 0.0));
-        }
       }
 
     } else
@@ -284,6 +285,10 @@ void StockDistribution::readStockData(CommentStream& infile,
       reject++;  //count number of rejected data points read from file
   }
 
+  //JMB the model distribution is only needed for the current timestep
+  for (i = 0; i < numarea; i++)
+    modelDistribution.resize(new DoubleMatrix(numstock, (numage * numlen), 0.0));
+
   AAT.addActions(Years, Steps, TimeInfo);
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in stockdistribution - found no data in the data file for", this->getName());
@@ -296,7 +301,7 @@ StockDistribution::~StockDistribution() {
   int i, j;
   for (i = 0; i < stocknames.Size(); i++) {
     delete[] stocknames[i];
-    delete aggregator[i];
+    aggcache.deleteAggregator(aggregator[i]);
   }
   delete[] aggregator;
   delete[] functionname;
@@ -314,22 +319,22 @@ StockDistribution::~StockDistribution() {
     delete modelYearData[i];
     delete obsYearData[i];
   }
-  for (i = 0; i < obsDistribution.Nrow(); i++) {
-    for (j = 0; j < obsDistribution.Ncol(i); j++) {
+  for (i = 0; i < obsDistribution.Nrow(); i++)
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
       delete obsDistribution[i][j];
-      delete modelDistribution[i][j];
-    }
-  }
+  for (i = 0; i < modelDistribution.Size(); i++)
+    delete modelDistribution[i];
+  for (i = 0; i < obsDataTerm.Size(); i++)
+    delete obsDataTerm[i];
 }
 
 void StockDistribution::Reset(const Keeper* const keeper) {
   Likelihood::Reset(keeper);
   if (isZero(weight))
     handle.logMessage(LOGWARN, "Warning in stockdistribution - zero weight for", this->getName());
-  int i, j;
-  for (i = 0; i < modelDistribution.Nrow(); i++)
-    for (j = 0; j < modelDistribution.Ncol(i); j++)
-      (*modelDistribution[i][j]).setToZero();
+  int i;
+  for (i = 0; i < modelDistribution.Size(); i++)
+    (*modelDistribution[i]).setToZero();
   if (yearly)
     for (i = 0; i < modelYearData.Size(); i++) {
       (*modelYearData[i]).setToZero();
@@ -417,7 +422,7 @@ void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
     if (found == 0)
       handle.logMessage(LOGFAIL, "Error in stockdistribution - unrecognised stock", stocknames[i]);
 
-    aggregator[s] = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+    aggregator[s] = aggcache.getFleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
   }
 
   for (i = 0; i < checkstocks.Size(); i++)
@@ -485,10 +490,7 @@ void StockDistribution::addLikelihood(const TimeClass* const TimeInfo) {
     handle.logMessage(LOGMESSAGE, "Calculating likelihood score for stockdistribution component", this->getName());
 
   int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stockdistribution - invalid timestep");
 
@@ -537,20 +539,38 @@ double StockDistribution::calcLikMultinomial() {
       alptr = &aggregator[s]->getSum();
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-          (*modelDistribution[timeindex][area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
+          (*modelDistribution[area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
     }
 
     for (i = 0; i < (numage * numlen); i++) {
       for (s = 0; s < numstock; s++) {
         obsdata[s] = (*obsDistribution[timeindex][area])[s][i];
-        moddata[s] = (*modelDistribution[timeindex][area])[s][i];
+        moddata[s] = (*modelDistribution[area])[s][i];
       }
-      likelihoodValues[timeindex][area] += MN.calcLogLikelihood(obsdata, moddata);
+      likelihoodValues[timeindex][area] += MN.calcLogLikelihood(obsdata, moddata, (*obsDataTerm[timeindex])[area][i]);
     }
   }
   return MN.getLogLikelihood();
 }
 
+void StockDistribution::calcDataTerms(int numarea, int numage, int numlen) {
+  int t, area, s, i;
+  int numstock = stocknames.Size();
+  DoubleVector obsdata(numstock, 0.0);
+
+  //the observed data wont change, so the log factorials only need to be calculated once
+  for (t = 0; t < obsDistribution.Nrow(); t++) {
+    obsDataTerm.resize(new DoubleMatrix(numarea, (numage * numlen), 0.0));
+    for (area = 0; area < numarea; area++) {
+      for (i = 0; i < (numage * numlen); i++) {
+        for (s = 0; s < numstock; s++)
+          obsdata[s] = (*obsDistribution[t][area])[s][i];
+        (*obsDataTerm[t])[area][i] = MN.calcDataTerm(obsdata);
+      }
+    }
+  }
+}
+
 double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
   double temp, totalmodel, totaldata, totallikelihood;
   int age, len, area, s, i;
@@ -567,7 +587,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
       alptr = &aggregator[s]->getSum();
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
         for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-          (*modelDistribution[timeindex][area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
+          (*modelDistribution[area])[s][age + (numage * len)] = ((*alptr)[area][age][len]).N;
     }
 
     if (!yearly) { //calculate likelihood on all steps
@@ -575,7 +595,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
         totalmodel = 0.0;
         totaldata = 0.0;
         for (s = 0; s < numstock; s++) {
-          totalmodel += (*modelDistribution[timeindex][area])[s][i];
+          totalmodel += (*modelDistribution[area])[s][i];
           totaldata += (*obsDistribution[timeindex][area])[s][i];
         }
 
@@ -586,7 +606,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
         for (s = 0; s < numstock; s++) {
           temp = (((*obsDistribution[timeindex][area])[s][i] * totaldata)
-            - ((*modelDistribution[timeindex][area])[s][i] * totalmodel));
+            - ((*modelDistribution[area])[s][i] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -604,7 +624,7 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
         for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
           for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
             i = age + (numage * len);
-            (*modelYearData[area])[s][i] += (*modelDistribution[timeindex][area])[s][i];
+            (*modelYearData[area])[s][i] += (*modelDistribution[area])[s][i];
             (*obsYearData[area])[s][i] += (*obsDistribution[timeindex][area])[s][i];
           }
         }
@@ -648,10 +668,7 @@ void StockDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
   int numage = ages.Nrow();
   int numlen = LgrpDiv->numLengthGroups();
 
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stockdistribution - invalid timestep");
 
@@ -670,10 +687,10 @@ void StockDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
           << sep << setprecision(largeprecision) << setw(largewidth);
 
         //JMB crude filter to remove the 'silly' values from the output
-        if ((*modelDistribution[timeindex][area])[s][i] < rathersmall)
+        if ((*modelDistribution[area])[s][i] < rathersmall)
           outfile << 0 << endl;
         else
-          outfile << (*modelDistribution[timeindex][area])[s][i] << endl;
+          outfile << (*modelDistribution[area])[s][i] << endl;
       }
     }
   }
@@ -8,6 +8,7 @@
 #include "readaggregation.h"
 #include "gadget.h"
 #include "runid.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 StockFullPrinter::StockFullPrinter(CommentStream& infile, const TimeClass* const TimeInfo)
@@ -60,6 +61,15 @@ StockFullPrinter::StockFullPrinter(CommentStream& infile, const TimeClass* const
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in stockfullprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in stockfullprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -84,13 +94,26 @@ StockFullPrinter::StockFullPrinter(CommentStream& infile, const TimeClass* const
     outfile << "\n; Printing the following information at the start of each timestep";
 
   outfile << "\n; year-step-area-age-length-number-mean weight\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("age", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("length", DOUBLECOLUMN, lowwidth, precision);
+    binout->addColumn("number", DOUBLECOLUMN, width, precision);
+    binout->addColumn("mean weight", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
 StockFullPrinter::~StockFullPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
-  delete aggregator;
+  if (aggregator != 0)
+    aggcache.deleteAggregator(aggregator);
   delete LgrpDiv;
   delete[] stockname;
 }
@@ -128,7 +151,7 @@ void StockFullPrinter::setStock(StockPtrVector& stockvec, const AreaClass* const
   LgrpDiv = new LengthGroupDivision(*stocks[0]->getLengthGroupDiv());
   if (LgrpDiv->Error())
     handle.logMessage(LOGFAIL, "Error in stockfullprinter - failed to create length group");
-  aggregator = new StockAggregator(stocks, LgrpDiv, areamatrix, agematrix);
+  aggregator = aggcache.getStockAggregator(stocks, LgrpDiv, areamatrix, agematrix);
 }
 
 void StockFullPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
@@ -140,6 +163,11 @@ void StockFullPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   int a, age, len;
 
   alptr = &aggregator->getSum();
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < outerareas.Size(); a++) {
     for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
       for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
@@ -161,3 +189,27 @@ void StockFullPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   }
   outfile.flush();
 }
+
+void StockFullPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, age, len;
+  for (a = 0; a < outerareas.Size(); a++) {
+    for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
+      for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
+        binout->storeInt(TimeInfo->getYear());
+        binout->storeInt(TimeInfo->getStep());
+        binout->storeInt(outerareas[a]);
+        binout->storeInt(age + minage);
+        binout->storeDouble(LgrpDiv->meanLength(len));
+
+        //JMB crude filter to remove the 'silly' values from the output
+        if (((*alptr)[a][age][len].N < rathersmall) || ((*alptr)[a][age][len].W < 0.0)) {
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+        } else {
+          binout->storeDouble((*alptr)[a][age][len].N);
+          binout->storeDouble((*alptr)[a][age][len].W);
+        }
+      }
+    }
+  }
+}
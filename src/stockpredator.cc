@@ -6,6 +6,7 @@
 #include "areatime.h"
 #include "suits.h"
 #include "readword.h"
+#include "vectorfunc.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -158,8 +159,9 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
       double temperature = Area->getTemperature(area, TimeInfo->getTime());
       tmp = exp(temperature * (consParam[1] - temperature * temperature * consParam[2]))
            * consParam[0] * TimeInfo->getTimeStepLength() / TimeInfo->numSubSteps();
+      powVector(maxcons[inarea], LgrpDiv->meanLengths(), consParam[3]);
       for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++)
-        maxcons[inarea][predl] = tmp * pow(LgrpDiv->meanLength(predl), consParam[3]);
+        maxcons[inarea][predl] *= tmp;
 
     } else if (functionnumber == 2) {
       double max1, max2, max3, l;
@@ -190,17 +192,20 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
       check = 1;
 
     if ((this->getPrey(prey)->isPreyArea(area)) && (!(isZero(this->getPrey(prey)->getEnergy())))) {
+      //JMB get the prey information once, rather than for each length group
+      const DoubleMatrix& suit = this->getSuitability(prey);
+      const DoubleVector& preybiomass = this->getPrey(prey)->getBiomass(area);
+      double preyenergy = this->getPrey(prey)->getEnergy();
       for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++) {
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++) {
-          tmp = this->getSuitability(prey)[predl][preyl] * this->getPrey(prey)->getEnergy()
-                  * this->getPrey(prey)->getBiomass(area, preyl);
-
-          //JMB - dont take the power if we dont have to
-          if (!check)
-            tmp = pow(tmp, preference[prey]);
-          (*cons[inarea][prey])[predl][preyl] = tmp;
-          Phi[inarea][predl] += tmp;
-        }
+        DoubleVector& predcons = (*cons[inarea][prey])[predl];
+        for (preyl = 0; preyl < predcons.Size(); preyl++)
+          predcons[preyl] = suit[predl][preyl] * preyenergy * preybiomass[preyl];
+
+        //JMB - dont take the power if we dont have to
+        if (!check)
+          powVector(predcons, preference[prey]);
+        for (preyl = 0; preyl < predcons.Size(); preyl++)
+          Phi[inarea][predl] += predcons[preyl];
       }
 
     } else {
@@ -234,26 +239,26 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
   }
 
   //Distributing the total consumption on the preys and converting to biomass
+  //and then adding the calculated consumption to the preys in question
   for (prey = 0; prey < this->numPreys(); prey++) {
     if ((this->getPrey(prey)->isPreyArea(area)) && (!(isZero(this->getPrey(prey)->getEnergy())))) {
+      double preyenergy = this->getPrey(prey)->getEnergy();
       for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++) {
         if (!(isZero(Phi[inarea][predl]))) {
-          tmp = totalcons[inarea][predl] / (Phi[inarea][predl] * this->getPrey(prey)->getEnergy());
-          for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
-            (*cons[inarea][prey])[predl][preyl] *= tmp;
+          DoubleVector& predcons = (*cons[inarea][prey])[predl];
+          tmp = totalcons[inarea][predl] / (Phi[inarea][predl] * preyenergy);
+          for (preyl = 0; preyl < predcons.Size(); preyl++)
+            predcons[preyl] *= tmp;
 
           //set the multiplicative constant
           (*predratio[inarea])[prey][predl] += tmp;
         }
       }
+
+      //JMB no need to add the consumption from preys with zero energy since it is zero
+      this->getPrey(prey)->addBiomassConsumption(area, *cons[inarea][prey]);
     }
   }
-
-  //Add the calculated consumption to the preys in question
-  for (prey = 0; prey < this->numPreys(); prey++)
-    if (this->getPrey(prey)->isPreyArea(area))
-      for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++)
-        this->getPrey(prey)->addBiomassConsumption(area, (*cons[inarea][prey])[predl]);
 }
 
 //Check if any of the preys of the predator are eaten up.
@@ -261,27 +266,40 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
 void StockPredator::adjustConsumption(int area, const TimeClass* const TimeInfo) {
   int inarea = this->areaNum(area);
   int numlen = LgrpDiv->numLengthGroups();
-  int preyl, predl, prey;
+  int preyl, predl, prey, isover, inpreyarea;
   double maxRatio, tmp;
 
   maxRatio = TimeInfo->getMaxRatioConsumed();
   for (predl = 0; predl < numlen; predl++)
     overcons[inarea][predl] = 0.0;
 
+  //JMB adjust the consumption for any overconsumption and then add it to the
+  //consumption for the timestep in the same pass through the consumption data
   for (prey = 0; prey < this->numPreys(); prey++) {
-    if (this->getPrey(prey)->isOverConsumption(area)) {
+    isover = this->getPrey(prey)->isOverConsumption(area);
+    inpreyarea = this->getPrey(prey)->isPreyArea(area);
+    if (isover)
       hasoverconsumption[inarea] = 1;
-      DoubleVector ratio = this->getPrey(prey)->getRatio(area);
-      for (predl = 0; predl < numlen; predl++) {
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++) {
+    if ((!isover) && (!inpreyarea))
+      continue;
+
+    const DoubleVector& ratio = this->getPrey(prey)->getRatio(area);
+    for (predl = 0; predl < numlen; predl++) {
+      DoubleVector& predcons = (*cons[inarea][prey])[predl];
+      if (isover) {
+        for (preyl = 0; preyl < predcons.Size(); preyl++) {
           if (ratio[preyl] > maxRatio) {
             tmp = maxRatio / ratio[preyl];
-            overcons[inarea][predl] += (1.0 - tmp) * (*cons[inarea][prey])[predl][preyl];
-            (*cons[inarea][prey])[predl][preyl] *= tmp;
+            overcons[inarea][predl] += (1.0 - tmp) * predcons[preyl];
+            predcons[preyl] *= tmp;
             (*usesuit[inarea][prey])[predl][preyl] *= tmp;
           }
         }
       }
+
+      if (inpreyarea)
+        for (preyl = 0; preyl < predcons.Size(); preyl++)
+          (*consumption[inarea][prey])[predl][preyl] += predcons[preyl];
     }
   }
 
@@ -309,10 +327,4 @@ void StockPredator::adjustConsumption(int area, const TimeClass* const TimeInfo)
   } else
     for (predl = 0; predl < numlen; predl++)
       fphi[inarea][predl] = subfphi[inarea][predl];
-
-  for (prey = 0; prey < this->numPreys(); prey++)
-    if (this->getPrey(prey)->isPreyArea(area))
-      for (predl = 0; predl < numlen; predl++)
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
-          (*consumption[inarea][prey])[predl][preyl] += (*cons[inarea][prey])[predl][preyl];
 }
@@ -66,6 +66,15 @@ StockPreyFullPrinter::StockPreyFullPrinter(CommentStream& infile, const TimeClas
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in stockpreyfullprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in stockpreyfullprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -90,10 +99,22 @@ StockPreyFullPrinter::StockPreyFullPrinter(CommentStream& infile, const TimeClas
     outfile << "\n; Printing the following information at the start of each timestep";
 
   outfile << "\n; year-step-area-age-length-number consumed-biomass consumed\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("age", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("length", DOUBLECOLUMN, lowwidth, precision);
+    binout->addColumn("number consumed", DOUBLECOLUMN, width, precision);
+    binout->addColumn("biomass consumed", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
 StockPreyFullPrinter::~StockPreyFullPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   delete LgrpDiv;
@@ -151,6 +172,11 @@ void StockPreyFullPrinter::Print(const TimeClass* const TimeInfo, int printtime)
   int a, age, len;
 
   alptr = &aggregator->getSum();
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < outerareas.Size(); a++) {
     for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
       for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
@@ -171,3 +197,27 @@ void StockPreyFullPrinter::Print(const TimeClass* const TimeInfo, int printtime)
   }
   outfile.flush();
 }
+
+void StockPreyFullPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, age, len;
+  for (a = 0; a < outerareas.Size(); a++) {
+    for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
+      for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
+        binout->storeInt(TimeInfo->getYear());
+        binout->storeInt(TimeInfo->getStep());
+        binout->storeInt(outerareas[a]);
+        binout->storeInt(age + minage);
+        binout->storeDouble(LgrpDiv->meanLength(len));
+
+        //JMB crude filter to remove the 'silly' values from the output
+        if (((*alptr)[a][age][len].N < rathersmall) || ((*alptr)[a][age][len].W < 0.0)) {
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+        } else {
+          binout->storeDouble((*alptr)[a][age][len].N);
+          binout->storeDouble((*alptr)[a][age][len].W * (*alptr)[a][age][len].N);
+        }
+      }
+    }
+  }
+}
@@ -101,6 +101,15 @@ StockPreyPrinter::StockPreyPrinter(CommentStream& infile, const TimeClass* const
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in stockpreyprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in stockpreyprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -127,6 +136,16 @@ StockPreyPrinter::StockPreyPrinter(CommentStream& infile, const TimeClass* const
     outfile << "\n; Printing the following information at the start of each timestep";
 
   outfile << "\n; year-step-area-age-length-number consumed-biomass consumed\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", LABELCOLUMN, printwidth, 0, &areaindex);
+    binout->addColumn("age", LABELCOLUMN, printwidth, 0, &ageindex);
+    binout->addColumn("length", LABELCOLUMN, printwidth, 0, &lenindex);
+    binout->addColumn("number consumed", DOUBLECOLUMN, width, precision);
+    binout->addColumn("biomass consumed", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
@@ -226,6 +245,11 @@ void StockPreyPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   int a, age, len;
 
   alptr = &aggregator->getSum();
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < areas.Nrow(); a++) {
     for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
       for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
@@ -248,7 +272,33 @@ void StockPreyPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   outfile.flush();
 }
 
+void StockPreyPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, age, len;
+  for (a = 0; a < areas.Nrow(); a++) {
+    for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
+      for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
+        binout->storeInt(TimeInfo->getYear());
+        binout->storeInt(TimeInfo->getStep());
+        binout->storeInt(a);
+        binout->storeInt(age);
+        binout->storeInt(len);
+
+        //JMB crude filter to remove the 'silly' values from the output
+        if (((*alptr)[a][age][len].N < rathersmall) || ((*alptr)[a][age][len].W < 0.0)) {
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+        } else {
+          binout->storeDouble((*alptr)[a][age][len].N);
+          binout->storeDouble((*alptr)[a][age][len].W * (*alptr)[a][age][len].N);
+        }
+      }
+    }
+  }
+}
+
 StockPreyPrinter::~StockPreyPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   delete LgrpDiv;
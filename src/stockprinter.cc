@@ -11,6 +11,7 @@
 #include "readaggregation.h"
 #include "gadget.h"
 #include "runid.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 StockPrinter::StockPrinter(CommentStream& infile, const TimeClass* const TimeInfo)
@@ -102,6 +103,15 @@ StockPrinter::StockPrinter(CommentStream& infile, const TimeClass* const TimeInf
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in stockprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in stockprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -128,12 +138,23 @@ StockPrinter::StockPrinter(CommentStream& infile, const TimeClass* const TimeInf
     outfile << "\n; Printing the following information at the start of each timestep";
 
   outfile << "\n; year-step-area-age-length-number-mean weight\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", LABELCOLUMN, printwidth, 0, &areaindex);
+    binout->addColumn("age", LABELCOLUMN, printwidth, 0, &ageindex);
+    binout->addColumn("length", LABELCOLUMN, printwidth, 0, &lenindex);
+    binout->addColumn("number", DOUBLECOLUMN, width, precision);
+    binout->addColumn("mean weight", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
 void StockPrinter::setStock(StockPtrVector& stockvec, const AreaClass* const Area) {
   StockPtrVector stocks;
-  delete aggregator;
+  if (aggregator != 0)
+    aggcache.deleteAggregator(aggregator);
   int i, j, k, found, minage, maxage;
 
   for (i = 0; i < stockvec.Size(); i++)
@@ -210,7 +231,7 @@ void StockPrinter::setStock(StockPtrVector& stockvec, const AreaClass* const Are
       handle.logMessage(LOGWARN, "Warning in stockprinter - maximum length group greater than stock length");
   }
 
-  aggregator = new StockAggregator(stocks, LgrpDiv, areas, ages);
+  aggregator = aggcache.getStockAggregator(stocks, LgrpDiv, areas, ages);
 }
 
 void StockPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
@@ -222,6 +243,11 @@ void StockPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   int a, age, len;
 
   alptr = &aggregator->getSum();
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < areas.Nrow(); a++) {
     for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
       for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
@@ -243,11 +269,38 @@ void StockPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   outfile.flush();
 }
 
+void StockPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, age, len;
+  for (a = 0; a < areas.Nrow(); a++) {
+    for (age = (*alptr)[a].minAge(); age <= (*alptr)[a].maxAge(); age++) {
+      for (len = (*alptr)[a].minLength(age); len < (*alptr)[a].maxLength(age); len++) {
+        binout->storeInt(TimeInfo->getYear());
+        binout->storeInt(TimeInfo->getStep());
+        binout->storeInt(a);
+        binout->storeInt(age);
+        binout->storeInt(len);
+
+        //JMB crude filter to remove the 'silly' values from the output
+        if (((*alptr)[a][age][len].N < rathersmall) || ((*alptr)[a][age][len].W < 0.0)) {
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+        } else {
+          binout->storeDouble((*alptr)[a][age][len].N);
+          binout->storeDouble((*alptr)[a][age][len].W);
+        }
+      }
+    }
+  }
+}
+
 StockPrinter::~StockPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   delete LgrpDiv;
-  delete aggregator;
+  if (aggregator != 0)
+    aggcache.deleteAggregator(aggregator);
   int i;
   for (i = 0; i < stocknames.Size(); i++)
     delete[] stocknames[i];
@@ -12,6 +12,7 @@
 #include "readword.h"
 #include "gadget.h"
 #include "runid.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 StockStdPrinter::StockStdPrinter(CommentStream& infile, const TimeClass* const TimeInfo)
@@ -75,6 +76,15 @@ StockStdPrinter::StockStdPrinter(CommentStream& infile, const TimeClass* const T
   if (printtimeid != 0 && printtimeid != 1)
     handle.logFileMessage(LOGFAIL, "\nError in stockstdprinter - invalid value of printatstart");
 
+  if (strcasecmp(text, "printformat") == 0) {
+    infile >> text >> ws;
+    if (strcasecmp(text, "binary") == 0)
+      binout = new BinaryOutput(outfile);
+    else if (strcasecmp(text, "text") != 0)
+      handle.logFileMessage(LOGFAIL, "\nError in stockstdprinter - invalid value of printformat");
+    infile >> text >> ws;
+  }
+
   if (strcasecmp(text, "yearsandsteps") != 0)
     handle.logFileUnexpected(LOGFAIL, "yearsandsteps", text);
   if (!AAT.readFromFile(infile, TimeInfo))
@@ -106,15 +116,31 @@ StockStdPrinter::StockStdPrinter(CommentStream& infile, const TimeClass* const T
 
   outfile << "\n; year-step-area-age-number-mean length-mean weight-"
     << "stddev length-number consumed-biomass consumed\n";
+
+  if (binout != 0) {
+    binout->addColumn("year", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("step", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("area", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("age", INTCOLUMN, lowwidth, 0);
+    binout->addColumn("number", DOUBLECOLUMN, width, precision);
+    binout->addColumn("mean length", DOUBLECOLUMN, printwidth, printprecision);
+    binout->addColumn("mean weight", DOUBLECOLUMN, printwidth, printprecision);
+    binout->addColumn("stddev length", DOUBLECOLUMN, printwidth, printprecision);
+    binout->addColumn("number consumed", DOUBLECOLUMN, width, precision);
+    binout->addColumn("biomass consumed", DOUBLECOLUMN, width, precision);
+  }
   outfile.flush();
 }
 
 StockStdPrinter::~StockStdPrinter() {
+  if (binout != 0)
+    delete binout;
   outfile.close();
   outfile.clear();
   if (isaprey)
     delete paggregator;
-  delete saggregator;
+  if (saggregator != 0)
+    aggcache.deleteAggregator(saggregator);
   delete LgrpDiv;
   delete[] stockname;
 }
@@ -152,7 +178,7 @@ void StockStdPrinter::setStock(StockPtrVector& stockvec, const AreaClass* const
   LgrpDiv = new LengthGroupDivision(*stocks[0]->getLengthGroupDiv());
   if (LgrpDiv->Error())
     handle.logMessage(LOGFAIL, "Error in stockstdprinter - failed to create length group");
-  saggregator = new StockAggregator(stocks, LgrpDiv, areamatrix, agematrix);
+  saggregator = aggcache.getStockAggregator(stocks, LgrpDiv, areamatrix, agematrix);
 
   if (stocks[0]->isEaten()) {
     isaprey = 1;
@@ -185,6 +211,11 @@ void StockStdPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   }
 
   int a, age;
+  if (binout != 0) {
+    this->printBinary(TimeInfo);
+    return;
+  }
+
   for (a = 0; a < outerareas.Size(); a++) {
     for (age = (*salptr)[a].minAge(); age <= (*salptr)[a].maxAge(); age++) {
       outfile << setw(lowwidth) << TimeInfo->getYear() << sep
@@ -222,3 +253,40 @@ void StockStdPrinter::Print(const TimeClass* const TimeInfo, int printtime) {
   }
   outfile.flush();
 }
+
+void StockStdPrinter::printBinary(const TimeClass* const TimeInfo) {
+  int a, age;
+  for (a = 0; a < outerareas.Size(); a++) {
+    for (age = (*salptr)[a].minAge(); age <= (*salptr)[a].maxAge(); age++) {
+      binout->storeInt(TimeInfo->getYear());
+      binout->storeInt(TimeInfo->getStep());
+      binout->storeInt(outerareas[a]);
+      binout->storeInt(age + minage);
+
+      ps.calcStatistics((*salptr)[a][age], LgrpDiv);
+      //JMB crude filters to remove the 'silly' values from the output
+      if (ps.totalNumber() < rathersmall) {
+        binout->storeDouble(0.0);
+        binout->storeDouble(0.0);
+        binout->storeDouble(0.0);
+        binout->storeDouble(0.0);
+        binout->storeDouble(0.0);
+        binout->storeDouble(0.0);
+
+      } else {
+        binout->storeDouble(ps.totalNumber() * scale);
+        binout->storeDouble(ps.meanLength());
+        binout->storeDouble(ps.meanWeight());
+        binout->storeDouble(ps.sdevLength());
+
+        if ((isaprey) && ((*palptr)[a][age][0].N >= rathersmall) && ((*palptr)[a][age][0].W >= 0.0)) {
+          binout->storeDouble((*palptr)[a][age][0].N);
+          binout->storeDouble((*palptr)[a][age][0].W * (*palptr)[a][age][0].N);
+        } else {
+          binout->storeDouble(0.0);
+          binout->storeDouble(0.0);
+        }
+      }
+    }
+  }
+}
@@ -69,6 +69,11 @@ void StomachContent::Reset(const Keeper* const keeper) {
   StomCont->Reset();
 }
 
+int StomachContent::isCumulative() const {
+  //JMB the multinomial function used by scnumbers can give a negative score
+  return (strcasecmp(functionname, "scnumbers") != 0);
+}
+
 void StomachContent::Print(ofstream& outfile) const {
   outfile << "\nStomach Content " << this->getName() << " - likelihood value " << likelihood
     << "\n\tFunction " << functionname << endl;
@@ -198,10 +203,7 @@ double SC::calcLikelihood(const TimeClass* const TimeInfo) {
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "Calculating likelihood score for stomachcontent component", this->getName());
 
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stomachcontent - invalid timestep");
 
@@ -213,7 +215,7 @@ double SC::calcLikelihood(const TimeClass* const TimeInfo) {
       dptr = aggregator[i]->getSum()[a];
       for (k = 0; k < dptr->Nrow(); k++)
         for (p = 0; p < dptr->Ncol(k); p++)
-          (*modelConsumption[timeindex][a])[k][numprey + p] = (*dptr)[k][p] * digestion[i][p];
+          (*modelConsumption[a])[k][numprey + p] = (*dptr)[k][p] * digestion[i][p];
 
     }
     numprey += preylengths[i].Size() - 1;
@@ -237,9 +239,8 @@ void SC::Reset() {
       digestion[i][j] = digestioncoeff[i][0] + digestioncoeff[i][1] *
                           pow(preyLgrpDiv[i]->meanLength(j), digestioncoeff[i][2]);
 
-  for (i = 0; i < modelConsumption.Nrow(); i++)
-    for (j = 0; j < modelConsumption.Ncol(i); j++)
-      (*modelConsumption[i][j]).setToZero();
+  for (i = 0; i < modelConsumption.Size(); i++)
+    (*modelConsumption[i]).setToZero();
 
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "Reset stomachcontent component", this->getName());
@@ -265,27 +266,24 @@ void SC::printLikelihood(ofstream& outfile, const TimeClass* const TimeInfo) {
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, pred, prey;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, pred, prey;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stomachcontent - invalid timestep");
 
-  for (area = 0; area < modelConsumption.Ncol(timeindex); area++) {
-    for (pred = 0; pred < modelConsumption[timeindex][area]->Nrow(); pred++) {
-      for (prey = 0; prey < modelConsumption[timeindex][area]->Ncol(pred); prey++) {
+  for (area = 0; area < modelConsumption.Size(); area++) {
+    for (pred = 0; pred < modelConsumption[area]->Nrow(); pred++) {
+      for (prey = 0; prey < modelConsumption[area]->Ncol(pred); prey++) {
         outfile << setw(lowwidth) << Years[timeindex] << sep << setw(lowwidth)
           << Steps[timeindex] << sep << setw(printwidth) << areaindex[area] << sep
           << setw(printwidth) << predindex[pred] << sep << setw(printwidth)
           << preyindex[prey] << sep << setprecision(largeprecision) << setw(largewidth);
 
         //JMB crude filter to remove the 'silly' values from the output
-        if ((*modelConsumption[timeindex][area])[pred][prey] < rathersmall)
+        if ((*modelConsumption[area])[pred][prey] < rathersmall)
           outfile << 0 << endl;
         else
-          outfile << (*modelConsumption[timeindex][area])[pred][prey] << endl;
+          outfile << (*modelConsumption[area])[pred][prey] << endl;
       }
     }
   }
@@ -293,12 +291,11 @@ void SC::printLikelihood(ofstream& outfile, const TimeClass* const TimeInfo) {
 
 SC::~SC() {
   int i, j;
-  for (i = 0; i < obsConsumption.Nrow(); i++) {
-    for (j = 0; j < obsConsumption[i].Size(); j++) {
+  for (i = 0; i < obsConsumption.Nrow(); i++)
+    for (j = 0; j < obsConsumption[i].Size(); j++)
       delete obsConsumption[i][j];
-      delete modelConsumption[i][j];
-    }
-  }
+  for (i = 0; i < modelConsumption.Size(); i++)
+    delete modelConsumption[i];
 
   for (i = 0; i < preyindex.Size(); i++) {
     delete aggregator[i];
@@ -513,8 +510,31 @@ SCNumbers::SCNumbers(CommentStream& infile, const AreaClass* const Area,
 
   MN = Multinomial();
   MN.setValue(epsilon);
-  mndist.resize(likelihoodValues.Nrow(), 0.0);
-  mndata.resize(likelihoodValues.Nrow(), 0.0);
+  mndist.resize(predatorlengths.Size() - 1, 0.0);
+  mndata.resize(predatorlengths.Size() - 1, 0.0);
+  this->calcDataTerms();
+}
+
+SCNumbers::~SCNumbers() {
+  int i;
+  for (i = 0; i < obsDataTerm.Size(); i++)
+    delete obsDataTerm[i];
+}
+
+void SCNumbers::calcDataTerms() {
+  int t, a, pred, prey;
+
+  //the observed data wont change, so the log factorials only need to be calculated once
+  for (t = 0; t < obsConsumption.Nrow(); t++) {
+    obsDataTerm.resize(new DoubleMatrix(obsConsumption.Ncol(t), obsConsumption[t][0]->Ncol(0), 0.0));
+    for (a = 0; a < obsConsumption.Ncol(t); a++) {
+      for (prey = 0; prey < obsConsumption[t][a]->Ncol(0); prey++) {
+        for (pred = 0; pred < mndata.Size(); pred++)
+          mndata[pred] = (*obsConsumption[t][a])[pred][prey];
+        (*obsDataTerm[t])[a][prey] = MN.calcDataTerm(mndata);
+      }
+    }
+  }
 }
 
 void SCNumbers::readStomachNumberContent(CommentStream& infile, const TimeClass* const TimeInfo) {
@@ -593,12 +613,9 @@ void SCNumbers::readStomachNumberContent(CommentStream& infile, const TimeClass*
         timeid = Years.Size() - 1;
 
         obsConsumption.resize();
-        modelConsumption.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-          modelConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-        }
       }
 
     } else
@@ -612,6 +629,10 @@ void SCNumbers::readStomachNumberContent(CommentStream& infile, const TimeClass*
       reject++;  //count number of rejected data points read from file
   }
 
+  //JMB the model consumption is only needed for the current timestep
+  for (i = 0; i < numarea; i++)
+    modelConsumption.resize(new DoubleMatrix(numpred, numprey, 0.0));
+
   AAT.addActions(Years, Steps, TimeInfo);
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in stomachcontent - found no data in the data file for", this->getName());
@@ -628,9 +649,9 @@ double SCNumbers::calcLikelihood() {
     for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(0); prey++) {
       for (pred = 0; pred < mndata.Size(); pred++) {
         mndata[pred] = (*obsConsumption[timeindex][a])[pred][prey];
-        mndist[pred] = (*modelConsumption[timeindex][a])[pred][prey];
+        mndist[pred] = (*modelConsumption[a])[pred][prey];
       }
-      likelihoodValues[timeindex][a] += MN.calcLogLikelihood(mndata, mndist);
+      likelihoodValues[timeindex][a] += MN.calcLogLikelihood(mndata, mndist, (*obsDataTerm[timeindex])[a][prey]);
     }
   }
   return MN.getLogLikelihood();
@@ -747,12 +768,10 @@ void SCAmounts::readStomachAmountContent(CommentStream& infile, const TimeClass*
         timeid = Years.Size() - 1;
 
         obsConsumption.resize();
-        modelConsumption.resize();
         stddev.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
         for (i = 0; i < numarea; i++) {
           obsConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-          modelConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
           stddev[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
         }
       }
@@ -769,6 +788,10 @@ void SCAmounts::readStomachAmountContent(CommentStream& infile, const TimeClass*
       reject++;  //count number of rejected data points read from file
   }
 
+  //JMB the model consumption is only needed for the current timestep
+  for (i = 0; i < numarea; i++)
+    modelConsumption.resize(new DoubleMatrix(numpred, numprey, 0.0));
+
   AAT.addActions(Years, Steps, TimeInfo);
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in stomachcontent - found no data in the data file for", this->getName());
@@ -870,27 +893,24 @@ void SCAmounts::printLikelihood(ofstream& outfile, const TimeClass* const TimeIn
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, pred, prey;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, pred, prey;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stomachcontent - invalid timestep");
 
-  for (area = 0; area < modelConsumption.Ncol(timeindex); area++) {
-    for (pred = 0; pred < modelConsumption[timeindex][area]->Nrow(); pred++) {
-      for (prey = 0; prey < modelConsumption[timeindex][area]->Ncol(pred); prey++) {
+  for (area = 0; area < modelConsumption.Size(); area++) {
+    for (pred = 0; pred < modelConsumption[area]->Nrow(); pred++) {
+      for (prey = 0; prey < modelConsumption[area]->Ncol(pred); prey++) {
         outfile << setw(lowwidth) << Years[timeindex] << sep << setw(lowwidth)
           << Steps[timeindex] << sep << setw(printwidth) << areaindex[area] << sep
           << setw(printwidth) << predindex[pred] << sep << setw(printwidth)
           << preyindex[prey] << sep << setprecision(largeprecision) << setw(largewidth);
 
         //JMB crude filter to remove the 'silly' values from the output
-        if ((*modelConsumption[timeindex][area])[pred][prey] < rathersmall)
+        if ((*modelConsumption[area])[pred][prey] < rathersmall)
           outfile << 0;
         else
-          outfile << (*modelConsumption[timeindex][area])[pred][prey];
+          outfile << (*modelConsumption[area])[pred][prey];
 
         outfile << sep << setprecision(largeprecision) << setw(largewidth)
           << (*stddev[timeindex][area])[pred][prey] << endl;
@@ -910,9 +930,9 @@ double SCAmounts::calcLikelihood() {
         tmplik = 0.0;
         for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++) {
           if (!(isZero((*stddev[timeindex][a])[pred][prey])))
-            tmplik += ((*modelConsumption[timeindex][a])[pred][prey] -
+            tmplik += ((*modelConsumption[a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]) *
-              ((*modelConsumption[timeindex][a])[pred][prey] -
+              ((*modelConsumption[a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]) /
               ((*stddev[timeindex][a])[pred][prey] * (*stddev[timeindex][a])[pred][prey]);
         }
@@ -959,21 +979,21 @@ double SCRatios::calcLikelihood() {
     likelihoodValues[timeindex][a] = 0.0;
     for (pred = 0; pred < obsConsumption[timeindex][a]->Nrow(); pred++) {
       scale = 0.0;
-      for (prey = 0; prey < modelConsumption[timeindex][a]->Ncol(pred); prey++)
-        scale += (*modelConsumption[timeindex][a])[pred][prey];
+      for (prey = 0; prey < modelConsumption[a]->Ncol(pred); prey++)
+        scale += (*modelConsumption[a])[pred][prey];
 
       if (!(isZero(scale))) {
         tmpdivide = 1.0 / scale;
         for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++)
-          (*modelConsumption[timeindex][a])[pred][prey] *= tmpdivide;
+          (*modelConsumption[a])[pred][prey] *= tmpdivide;
 
         if (!(isZero((*number[timeindex])[a][pred]))) {
           tmplik = 0.0;
           for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++) {
             if (!(isZero((*stddev[timeindex][a])[pred][prey])))
-              tmplik += ((*modelConsumption[timeindex][a])[pred][prey]  -
+              tmplik += ((*modelConsumption[a])[pred][prey]  -
                 (*obsConsumption[timeindex][a])[pred][prey]) *
-                ((*modelConsumption[timeindex][a])[pred][prey]  -
+                ((*modelConsumption[a])[pred][prey]  -
                 (*obsConsumption[timeindex][a])[pred][prey]) /
                 ((*stddev[timeindex][a])[pred][prey] * (*stddev[timeindex][a])[pred][prey]);
           }
@@ -1085,12 +1105,9 @@ void SCSimple::readStomachSimpleContent(CommentStream& infile, const TimeClass*
         timeid = Years.Size() - 1;
 
         obsConsumption.resize();
-        modelConsumption.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-          modelConsumption[timeid].resize(new DoubleMatrix(numpred, numprey, 0.0));
-        }
       }
 
     } else
@@ -1104,6 +1121,10 @@ void SCSimple::readStomachSimpleContent(CommentStream& infile, const TimeClass*
       reject++;  //count number of rejected data points read from file
   }
 
+  //JMB the model consumption is only needed for the current timestep
+  for (i = 0; i < numarea; i++)
+    modelConsumption.resize(new DoubleMatrix(numpred, numprey, 0.0));
+
   AAT.addActions(Years, Steps, TimeInfo);
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in stomachcontent - found no data in the data file for", this->getName());
@@ -1143,17 +1164,17 @@ double SCSimple::calcLikelihood() {
     likelihoodValues[timeindex][a] = 0.0;
     for (pred = 0; pred < obsConsumption[timeindex][a]->Nrow(); pred++) {
       scale = 0.0;
-      for (prey = 0; prey < modelConsumption[timeindex][a]->Ncol(pred); prey++)
-        scale += (*modelConsumption[timeindex][a])[pred][prey];
+      for (prey = 0; prey < modelConsumption[a]->Ncol(pred); prey++)
+        scale += (*modelConsumption[a])[pred][prey];
 
       if (!(isZero(scale))) {
         tmpdivide = 1.0 / scale;
         tmplik = 0.0;
         for (prey = 0; prey < obsConsumption[timeindex][a]->Ncol(pred); prey++) {
-          (*modelConsumption[timeindex][a])[pred][prey] *= tmpdivide;
-          tmplik += ((*modelConsumption[timeindex][a])[pred][prey] -
+          (*modelConsumption[a])[pred][prey] *= tmpdivide;
+          tmplik += ((*modelConsumption[a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]) *
-              ((*modelConsumption[timeindex][a])[pred][prey] -
+              ((*modelConsumption[a])[pred][prey] -
               (*obsConsumption[timeindex][a])[pred][prey]);
         }
         likelihoodValues[timeindex][a] += tmplik;
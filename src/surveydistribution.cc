@@ -8,11 +8,12 @@
 #include "stock.h"
 #include "suitfuncptrvector.h"
 #include "gadget.h"
+#include "aggregatorcache.h"
 #include "global.h"
 
 SurveyDistribution::SurveyDistribution(CommentStream& infile, const AreaClass* const Area,
   const TimeClass* const TimeInfo, Keeper* const keeper, double weight, const char* name)
-  : Likelihood(SURVEYDISTRIBUTIONLIKELIHOOD, weight, name), alptr(0) {
+  : Likelihood(SURVEYDISTRIBUTIONLIKELIHOOD, weight, name), aggregator(0), alptr(0) {
 
   int i, j;
   char text[MaxStrLength];
@@ -238,12 +239,9 @@ void SurveyDistribution::readDistributionData(CommentStream& infile,
         timeid = (Years.Size() - 1);
 
         obsDistribution.resize();
-        modelDistribution.resize();
         likelihoodValues.AddRows(1, numarea, 0.0);
-        for (i = 0; i < numarea; i++) {
+        for (i = 0; i < numarea; i++)
           obsDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-          modelDistribution[timeid].resize(new DoubleMatrix(numage, numlen, 0.0));
-        }
       }
 
     } else
@@ -258,6 +256,10 @@ void SurveyDistribution::readDistributionData(CommentStream& infile,
       reject++;  //count number of rejected data points read from file
   }
 
+  //JMB the model distribution is only needed for the current timestep
+  for (i = 0; i < numarea; i++)
+    modelDistribution.resize(new DoubleMatrix(numage, numlen, 0.0));
+
   AAT.addActions(Years, Steps, TimeInfo);
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in surveydistribution - found no data in the data file for", this->getName());
@@ -294,15 +296,14 @@ SurveyDistribution::~SurveyDistribution() {
     delete suitfunction;
     suitfunction = NULL;
   }
-  for (i = 0; i < obsDistribution.Nrow(); i++) {
-    for (j = 0; j < obsDistribution.Ncol(i); j++) {
+  for (i = 0; i < obsDistribution.Nrow(); i++)
+    for (j = 0; j < obsDistribution.Ncol(i); j++)
       delete obsDistribution[i][j];
-      delete modelDistribution[i][j];
-    }
-  }
+  for (i = 0; i < modelDistribution.Size(); i++)
+    delete modelDistribution[i];
 
   if (aggregator != 0)
-    delete aggregator;
+    aggcache.deleteAggregator(aggregator);
   delete LgrpDiv;
   delete[] fittype;
   delete[] liketype;
@@ -312,10 +313,9 @@ void SurveyDistribution::Reset(const Keeper* const keeper) {
   Likelihood::Reset(keeper);
   if (isZero(weight))
     handle.logMessage(LOGWARN, "Warning in surveydistribution - zero weight for", this->getName());
-  int i, j;
-  for (i = 0; i < modelDistribution.Nrow(); i++)
-    for (j = 0; j < modelDistribution.Ncol(i); j++)
-      (*modelDistribution[i][j]).setToZero();
+  int i;
+  for (i = 0; i < modelDistribution.Size(); i++)
+    (*modelDistribution[i]).setToZero();
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "Reset surveydistribution component", this->getName());
 }
@@ -336,27 +336,24 @@ void SurveyDistribution::printLikelihood(ofstream& outfile, const TimeClass* con
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, age, len;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, age, len;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveydistribution - invalid timestep");
 
-  for (area = 0; area < modelDistribution.Ncol(timeindex); area++) {
-    for (age = 0; age < modelDistribution[timeindex][area]->Nrow(); age++) {
-      for (len = 0; len < modelDistribution[timeindex][area]->Ncol(age); len++) {
+  for (area = 0; area < modelDistribution.Size(); area++) {
+    for (age = 0; age < modelDistribution[area]->Nrow(); age++) {
+      for (len = 0; len < modelDistribution[area]->Ncol(age); len++) {
         outfile << setw(lowwidth) << Years[timeindex] << sep << setw(lowwidth)
           << Steps[timeindex] << sep << setw(printwidth) << areaindex[area] << sep
           << setw(printwidth) << ageindex[age] << sep << setw(printwidth)
           << lenindex[len] << sep << setprecision(largeprecision) << setw(largewidth);
 
         //JMB crude filter to remove the 'silly' values from the output
-        if ((*modelDistribution[timeindex][area])[age][len] < rathersmall)
+        if ((*modelDistribution[area])[age][len] < rathersmall)
           outfile << 0 << endl;
         else
-          outfile << (*modelDistribution[timeindex][area])[age][len] << endl;
+          outfile << (*modelDistribution[area])[age][len] << endl;
       }
     }
   }
@@ -434,7 +431,7 @@ void SurveyDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVect
       handle.logMessage(LOGWARN, "Warning in surveydistribution - maximum length group greater than stock length");
   }
 
-  aggregator = new StockAggregator(stocks, LgrpDiv, areas, ages);
+  aggregator = aggcache.getStockAggregator(stocks, LgrpDiv, areas, ages);
 }
 
 void SurveyDistribution::calcIndex(const TimeClass* const TimeInfo) {
@@ -462,13 +459,13 @@ void SurveyDistribution::calcIndex(const TimeClass* const TimeInfo) {
       for (area = 0; area < areas.Nrow(); area++)
         for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
           for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-            (*modelDistribution[timeindex][area])[age][len] = parameters[0] * suit[len] * (((*alptr)[area][age][len]).N + parameters[1]);
+            (*modelDistribution[area])[age][len] = parameters[0] * suit[len] * (((*alptr)[area][age][len]).N + parameters[1]);
       break;
     case 2:
       for (area = 0; area < areas.Nrow(); area++)
         for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
           for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-            (*modelDistribution[timeindex][area])[age][len] = parameters[0] * suit[len] * pow(((*alptr)[area][age][len]).N, parameters[1]);
+            (*modelDistribution[area])[age][len] = parameters[0] * suit[len] * pow(((*alptr)[area][age][len]).N, parameters[1]);
       break;
     default:
       handle.logMessage(LOGWARN, "Warning in surveydistribution - unrecognised fittype", fittype);
@@ -481,11 +478,7 @@ void SurveyDistribution::addLikelihood(const TimeClass* const TimeInfo) {
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
     return;
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = AAT.getTimeIndex(TimeInfo);
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveydistribution - invalid timestep");
 
@@ -534,9 +527,9 @@ double SurveyDistribution::calcLikMultinomial() {
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++) {
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++) {
         temp -= (*obsDistribution[timeindex][area])[age][len] *
-                 log(((*modelDistribution[timeindex][area])[age][len]) + epsilon);
+                 log(((*modelDistribution[area])[age][len]) + epsilon);
         obstotal += (*obsDistribution[timeindex][area])[age][len];
-        modtotal += ((*modelDistribution[timeindex][area])[age][len] + epsilon);
+        modtotal += ((*modelDistribution[area])[age][len] + epsilon);
       }
     }
 
@@ -563,9 +556,9 @@ double SurveyDistribution::calcLikPearson() {
     temp = 0.0;
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++) {
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++) {
-        diff = ((*modelDistribution[timeindex][area])[age][len] - (*obsDistribution[timeindex][area])[age][len]);
+        diff = ((*modelDistribution[area])[age][len] - (*obsDistribution[timeindex][area])[age][len]);
         diff *= diff;
-        diff /= ((*modelDistribution[timeindex][area])[age][len] + epsilon);
+        diff /= ((*modelDistribution[area])[age][len] + epsilon);
         temp += diff;
       }
     }
@@ -589,8 +582,8 @@ double SurveyDistribution::calcLikGamma() {
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++)
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++)
         temp += (((*obsDistribution[timeindex][area])[age][len] /
-                 ((*modelDistribution[timeindex][area])[age][len] + epsilon)) +
-                 log((*modelDistribution[timeindex][area])[age][len] + epsilon));
+                 ((*modelDistribution[area])[age][len] + epsilon)) +
+                 log((*modelDistribution[area])[age][len] + epsilon));
 
     likelihoodValues[timeindex][area] = temp;
     total += likelihoodValues[timeindex][area];
@@ -609,7 +602,7 @@ double SurveyDistribution::calcLikLog() {
     modtotal = 0.0;
     for (age = 0; age < (*obsDistribution[timeindex][area]).Nrow(); age++) {
       for (len = 0; len < (*obsDistribution[timeindex][area]).Ncol(age); len++) {
-        modtotal += (*modelDistribution[timeindex][area])[age][len];
+        modtotal += (*modelDistribution[area])[age][len];
         obstotal += (*obsDistribution[timeindex][area])[age][len];
       }
     }